@@ -0,0 +1,509 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <getopt.h>
+#include "types.h"
+#include "compressedGraph.h"
+#include "decipherFile.h"
+#include "logic.h"
+#include "options.h"
+#include "parallelBfs.h"
+#include "reorder.h"
+#include "traversalContext.h"
+#include "traversalProfile.h"
+
+/*
+ * @brief Benchmark options data structure
+ *
+ * @member char pointer [array] (file name) => graph file or snapshot
+ * @member char pointer [array] (graph name) => label of the graph in the report
+ * @member char pointer [array] (commit) => label of the build in the report
+ * @member unsigned int (runs) => timed traversals
+ * @member unsigned int (load runs) => timed loads
+ * @member ReorderMethod (reorder) => relabelling compared against the node list order
+ * @member bool (compress) => also time the compressed adjacency
+ * @member TraversalOptions (traversal) => kernel being measured
+ *
+ */
+typedef struct BenchmarkOptions {
+    const char *fileName;
+    const char *graphName;
+    const char *commit;
+    unsigned int runs;
+    unsigned int loadRuns;
+    ReorderMethod reorder;
+    bool compress;
+    TraversalOptions traversal;
+} BenchmarkOptions;
+
+/*
+ * @brief Sample summary data structure
+ *
+ * @member double (median)
+ * @member double (mean)
+ * @member double (variance) => sample variance, 0 for a single sample
+ *
+ */
+typedef struct SampleSummary {
+    double median;
+    double mean;
+    double variance;
+} SampleSummary;
+
+/*
+ * @brief declarations for internal functions
+ *
+ * List of static functions local to this file
+ * Meant to be used in this file only
+ *
+ * @note all internal functions are static
+ */
+static void printUsage(const char *programName);
+static void parseBenchmarkOptions(int argc, char *argv[], BenchmarkOptions *options);
+static int compareDoubles(const void *first, const void *second);
+static SampleSummary summarize(double *samples, unsigned int noOfSamples);
+static size_t countTraversedEdges(const Graph *graph, const TraversalStats *traversalStats);
+static void printSummary(const char *name, SampleSummary summary, bool last);
+static void timeTraversals(Graph *graph, const TraversalOptions *traversal, double *samples, unsigned int runs);
+static bool countCacheMisses(Graph *graph, const TraversalOptions *traversal, uint64_t *cacheMisses);
+static void printMissRate(const char *name, bool counted, uint64_t cacheMisses, size_t traversedEdges);
+
+/*
+ * @brief Display usage
+ *
+ * @param char pointer [array] (program name)
+ * @return void
+ *
+ */
+static void printUsage(const char *programName)
+{
+    printf("Usage: %s -f PATH [options]\n", programName);
+    printf("  -f, --file PATH      graph data file or snapshot\n");
+    printf("  -m, --mode MODE      top-down (default), direction-optimizing, parallel, numa\n");
+    printf("  -t, --threads N      threads for loading and the parallel and numa kernels\n");
+    printf("  -d, --deterministic  parallel kernel keeps the top-down path order\n");
+    printf("  -o, --order ORDER    also time the graph relabelled by rcm, degree or bfs\n");
+    printf("                       and report the speedup and cache misses of both\n");
+    printf("  -z, --compress       also time the graph compressed to varint gaps and\n");
+    printf("                       report the bytes per edge of both, top-down only\n");
+    printf("  -r, --runs N         timed traversals (default 16)\n");
+    printf("  -l, --load-runs N    timed loads (default 3)\n");
+    printf("  -n, --name NAME      graph label in the report (default file name)\n");
+    printf("  -c, --commit ID      build label in the report (default unknown)\n");
+    printf("  -h, --help           show this message\n");
+}
+
+/*
+ * @brief Parse command line options
+ *
+ * @param int (argument count)
+ * @param char pointer [2d array] (argument values)
+ * @param BenchmarkOptions (pointer*)
+ * @return void
+ *
+ */
+static void parseBenchmarkOptions(int argc, char *argv[], BenchmarkOptions *options)
+{
+    static const struct option longOptions[] = {
+        { "file", required_argument, NULL, 'f' },
+        { "mode", required_argument, NULL, 'm' },
+        { "threads", required_argument, NULL, 't' },
+        { "deterministic", no_argument, NULL, 'd' },
+        { "order", required_argument, NULL, 'o' },
+        { "compress", no_argument, NULL, 'z' },
+        { "runs", required_argument, NULL, 'r' },
+        { "load-runs", required_argument, NULL, 'l' },
+        { "name", required_argument, NULL, 'n' },
+        { "commit", required_argument, NULL, 'c' },
+        { "help", no_argument, NULL, 'h' },
+        { NULL, 0, NULL, 0 }
+    };
+
+    options->fileName = NULL;
+    options->graphName = NULL;
+    options->commit = "unknown";
+    options->runs = 16;
+    options->loadRuns = 3;
+    options->reorder = NO_REORDER;
+    options->compress = false;
+    initTraversalOptions(&options->traversal);
+
+    int option;
+    while ((option = getopt_long(argc, argv, "f:m:t:do:zr:l:n:c:h", longOptions, NULL)) != -1)
+    {
+        switch (option)
+        {
+            case 'f':
+                options->fileName = optarg;
+                break;
+            case 'm':
+                options->traversal.mode = parseTraversalMode(optarg);
+                break;
+            case 't':
+                options->traversal.noOfThreads = parsePositive(optarg, "--threads");
+                break;
+            case 'd':
+                options->traversal.deterministic = true;
+                break;
+            case 'o':
+                options->reorder = parseReorderMethod(optarg);
+                break;
+            case 'z':
+                options->compress = true;
+                break;
+            case 'r':
+                options->runs = parsePositive(optarg, "--runs");
+                break;
+            case 'l':
+                options->loadRuns = parsePositive(optarg, "--load-runs");
+                break;
+            case 'n':
+                options->graphName = optarg;
+                break;
+            case 'c':
+                options->commit = optarg;
+                break;
+            case 'h':
+                printUsage(argv[0]);
+                exit(EXIT_SUCCESS);
+            default:
+                printUsage(argv[0]);
+                exit(EXIT_FAILURE);
+        }
+    }
+
+    if (options->fileName == NULL || optind < argc)
+    {
+        printUsage(argv[0]);
+        exit(EXIT_FAILURE);
+    }
+
+    if (options->graphName == NULL)
+    {
+        options->graphName = options->fileName;
+    }
+
+    if (options->compress && options->traversal.mode != TOP_DOWN_TRAVERSAL)
+    {
+        fprintf(stderr, "--compress only works with the top-down traversal\n");
+        exit(EXIT_FAILURE);
+    }
+}
+
+/*
+ * @brief Compare doubles in ascending order
+ *
+ * @param void pointer (first double)
+ * @param void pointer (second double)
+ * @return int
+ *
+ */
+static int compareDoubles(const void *first, const void *second)
+{
+    double firstValue = *(const double *)first;
+    double secondValue = *(const double *)second;
+
+    return (firstValue > secondValue) - (firstValue < secondValue);
+}
+
+/*
+ * @brief Summarize samples
+ *
+ * @param double pointer [array] (samples, sorted in place)
+ * @param unsigned int (number of samples)
+ * @return SampleSummary
+ *
+ */
+static SampleSummary summarize(double *samples, unsigned int noOfSamples)
+{
+    SampleSummary summary = { 0, 0, 0 };
+
+    qsort(samples, noOfSamples, sizeof(double), compareDoubles);
+
+    summary.median = noOfSamples % 2 == 1
+        ? samples[noOfSamples / 2]
+        : (samples[noOfSamples / 2 - 1] + samples[noOfSamples / 2]) / 2;
+
+    for (unsigned int index = 0; index < noOfSamples; index++)
+    {
+        summary.mean += samples[index];
+    }
+
+    summary.mean /= noOfSamples;
+
+    for (unsigned int index = 0; index < noOfSamples && noOfSamples > 1; index++)
+    {
+        double deviation = samples[index] - summary.mean;
+        summary.variance += deviation * deviation / (noOfSamples - 1);
+    }
+
+    return summary;
+}
+
+/*
+ * @brief Count edges traversed by a bfs
+ *
+ * Sums the out degrees of every reached vertex.
+ * Undirected edges are stored both ways, so they
+ * are counted once, as Graph500 does
+ *
+ * @param Graph (pointer*)
+ * @param TraversalStats (pointer*)
+ * @return size_t
+ *
+ */
+static size_t countTraversedEdges(const Graph *graph, const TraversalStats *traversalStats)
+{
+    size_t traversedEdges = 0;
+
+    for (unsigned int index = 0; index < traversalStats->traversalLength; index++)
+    {
+        VertexId vertex = traversalStats->traversalPath[index];
+        traversedEdges += graph->edgeOffsets[vertex + 1] - graph->edgeOffsets[vertex];
+    }
+
+    return graph->directed ? traversedEdges : traversedEdges / 2;
+}
+
+/*
+ * @brief Print a summary as a JSON member
+ *
+ * @param char pointer [array] (member name)
+ * @param SampleSummary (summary)
+ * @param bool (last member of the object)
+ * @return void
+ *
+ */
+static void printSummary(const char *name, SampleSummary summary, bool last)
+{
+    printf
+    (
+        "\"%s\":{\"median\":%.9g,\"mean\":%.9g,\"variance\":%.9g}%s",
+        name, summary.median, summary.mean, summary.variance, last ? "" : ","
+    );
+}
+
+/*
+ * @brief Time traversals of a graph
+ *
+ * Runs one untimed warm up traversal first,
+ * which also builds the incoming arrays
+ * direction optimizing needs. Every run reuses
+ * one context, so allocation stays out of the
+ * timings
+ *
+ * @param Graph (pointer*)
+ * @param TraversalOptions (pointer*)
+ * @param double pointer [array] (samples, one per run)
+ * @param unsigned int (runs)
+ * @return void
+ *
+ */
+static void timeTraversals(Graph *graph, const TraversalOptions *traversal, double *samples, unsigned int runs)
+{
+    TraversalContext context;
+    TraversalStats traversalStats;
+
+    initTraversalContext(&context, graph->noOfNodes);
+
+    runTraversal(&context, graph, traversal, &traversalStats);
+
+    for (unsigned int run = 0; run < runs; run++)
+    {
+        double start = readClock();
+        runTraversal(&context, graph, traversal, &traversalStats);
+        samples[run] = readClock() - start;
+    }
+
+    freeTraversalContext(&context);
+}
+
+/*
+ * @brief Count cache misses of one traversal
+ *
+ * The whole traversal is recorded as a single
+ * level of a profile with hardware counters
+ *
+ * @param Graph (pointer*)
+ * @param TraversalOptions (pointer*)
+ * @param uint64_t (pointer*) => receives the cache misses
+ * @return bool (false if the counters are unavailable)
+ *
+ */
+static bool countCacheMisses(Graph *graph, const TraversalOptions *traversal, uint64_t *cacheMisses)
+{
+    TraversalProfile profile;
+    startProfile(&profile, true);
+
+    if (!profile.countersEnabled)
+    {
+        return false;
+    }
+
+    markProfileLevel(&profile, 0, 0, 0, false);
+    TraversalStats traversalStats = bfsAlgorithm(graph, traversal);
+    finishProfile(&profile, 0, 0);
+
+    *cacheMisses = profile.levels[0].cacheMisses;
+
+    freeTraversalStats(&traversalStats);
+    freeProfile(&profile);
+
+    return true;
+}
+
+/*
+ * @brief Print cache misses per traversed edge as a JSON member
+ *
+ * @param char pointer [array] (member name)
+ * @param bool (counters were available)
+ * @param uint64_t (cache misses)
+ * @param size_t (traversed edges)
+ * @return void
+ *
+ */
+static void printMissRate(const char *name, bool counted, uint64_t cacheMisses, size_t traversedEdges)
+{
+    if (counted && traversedEdges > 0)
+    {
+        printf("\"%s\":%.9g,", name, (double)cacheMisses / (double)traversedEdges);
+    }
+    else
+    {
+        printf("\"%s\":null,", name);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    BenchmarkOptions options;
+    parseBenchmarkOptions(argc, argv, &options);
+
+    double *loadSamples = (double *)malloc(options.loadRuns * sizeof(double));
+    double *buildSamples = (double *)malloc(options.loadRuns * sizeof(double));
+    double *traversalSamples = (double *)malloc(options.runs * sizeof(double));
+    double *tepsSamples = (double *)malloc(options.runs * sizeof(double));
+    double *originalSamples = (double *)malloc(options.runs * sizeof(double));
+    double *compressedSamples = (double *)malloc(options.runs * sizeof(double));
+
+    if
+    (
+        loadSamples == NULL || buildSamples == NULL || traversalSamples == NULL ||
+        tepsSamples == NULL || originalSamples == NULL || compressedSamples == NULL
+    )
+    {
+        perror("Failed to allocate memory\n");
+        exit(EXIT_FAILURE);
+    }
+
+    Graph *graph = NULL;
+
+    for (unsigned int run = 0; run < options.loadRuns; run++)
+    {
+        LoadTimings timings;
+
+        if (graph != NULL)
+        {
+            freeGraph(graph);
+        }
+
+        graph = createGraphFromFile(options.fileName, options.traversal.noOfThreads, &timings);
+        loadSamples[run] = timings.loadSeconds;
+        buildSamples[run] = timings.buildSeconds;
+    }
+
+    TraversalStats traversalStats = bfsAlgorithm(graph, &options.traversal);
+    size_t traversedEdges = countTraversedEdges(graph, &traversalStats);
+    freeTraversalStats(&traversalStats);
+
+    double reorderSeconds = 0;
+    uint64_t originalCacheMisses = 0, cacheMisses = 0;
+    bool originalCounted = false, counted = false;
+
+    // the node list order is measured first, then the graph is relabelled in place
+    if (options.reorder != NO_REORDER)
+    {
+        timeTraversals(graph, &options.traversal, originalSamples, options.runs);
+        originalCounted = countCacheMisses(graph, &options.traversal, &originalCacheMisses);
+
+        double start = readClock();
+        reorderGraph(graph, options.reorder);
+        reorderSeconds = readClock() - start;
+
+        counted = countCacheMisses(graph, &options.traversal, &cacheMisses);
+    }
+
+    timeTraversals(graph, &options.traversal, traversalSamples, options.runs);
+
+    for (unsigned int run = 0; run < options.runs; run++)
+    {
+        tepsSamples[run] = (double)traversedEdges / traversalSamples[run];
+    }
+
+    // compressing drops the plain edge arrays, so it comes last
+    size_t plainBytes = getAdjacencyBytes(graph);
+    double compressSeconds = 0;
+
+    if (options.compress)
+    {
+        double start = readClock();
+        compressGraph(graph);
+        compressSeconds = readClock() - start;
+
+        timeTraversals(graph, &options.traversal, compressedSamples, options.runs);
+    }
+
+    printf
+    (
+        "{\"commit\":\"%s\",\"graph\":\"%s\",\"vertices\":%u,\"edges\":%zu,\"directed\":%s,",
+        options.commit, options.graphName, graph->noOfNodes, graph->noOfEdges,
+        graph->directed ? "true" : "false"
+    );
+    printf
+    (
+        "\"mode\":\"%s\",\"deterministic\":%s,\"threads\":%u,\"loadRuns\":%u,\"runs\":%u,",
+        getTraversalModeName(options.traversal.mode), options.traversal.deterministic ? "true" : "false",
+        resolveThreadCount(options.traversal.noOfThreads), options.loadRuns, options.runs
+    );
+    printf("\"traversedEdges\":%zu,\"order\":\"%s\",", traversedEdges, getReorderMethodName(options.reorder));
+
+    if (options.reorder != NO_REORDER)
+    {
+        SampleSummary original = summarize(originalSamples, options.runs);
+        SampleSummary reordered = summarize(traversalSamples, options.runs);
+
+        printf("\"reorderSeconds\":%.9g,\"speedup\":%.9g,", reorderSeconds, original.median / reordered.median);
+        printMissRate("originalCacheMissesPerEdge", originalCounted, originalCacheMisses, traversedEdges);
+        printMissRate("cacheMissesPerEdge", counted, cacheMisses, traversedEdges);
+        printSummary("originalTraversalSeconds", original, false);
+    }
+
+    if (options.compress && graph->noOfEdges > 0)
+    {
+        printf
+        (
+            "\"bytesPerEdge\":%.9g,\"compressedBytesPerEdge\":%.9g,\"compressSeconds\":%.9g,",
+            (double)plainBytes / graph->noOfEdges, (double)getAdjacencyBytes(graph) / graph->noOfEdges,
+            compressSeconds
+        );
+        printSummary("compressedTraversalSeconds", summarize(compressedSamples, options.runs), false);
+    }
+
+    printSummary("loadSeconds", summarize(loadSamples, options.loadRuns), false);
+    printSummary("buildSeconds", summarize(buildSamples, options.loadRuns), false);
+    printSummary("traversalSeconds", summarize(traversalSamples, options.runs), false);
+    printSummary("teps", summarize(tepsSamples, options.runs), true);
+    printf("}\n");
+
+    freeGraph(graph);
+
+    free(loadSamples);
+    free(buildSamples);
+    free(traversalSamples);
+    free(tepsSamples);
+    free(originalSamples);
+    free(compressedSamples);
+
+    return 0;
+}
@@ -0,0 +1,485 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <getopt.h>
+
+/*
+ * @brief Graph kind
+ *
+ * Selects the synthetic graph generator
+ *
+ * @value RMAT_GRAPH => recursive matrix (Kronecker) graph with skewed degrees
+ * @value ERDOS_RENYI_GRAPH => uniformly random edges
+ * @value GRID_GRAPH => 2D grid, many levels with mid sized frontiers
+ * @value CHAIN_GRAPH => single long path, one vertex per level
+ *
+ */
+typedef enum GraphKind {
+    RMAT_GRAPH,
+    ERDOS_RENYI_GRAPH,
+    GRID_GRAPH,
+    CHAIN_GRAPH
+} GraphKind;
+
+/*
+ * @brief Generator options data structure
+ *
+ * @member GraphKind (kind) => generator to run
+ * @member unsigned int (scale) => the graph has 2^scale vertices
+ * @member unsigned int (edge factor) => edges per vertex for rmat and erdos-renyi
+ * @member bool (directed) => write a directed graph
+ * @member uint64_t (seed) => seed of the random number generator
+ * @member char pointer [array] (output file name) => NULL for stdout
+ *
+ */
+typedef struct GeneratorOptions {
+    GraphKind kind;
+    unsigned int scale;
+    unsigned int edgeFactor;
+    bool directed;
+    uint64_t seed;
+    const char *outputFileName;
+} GeneratorOptions;
+
+/*
+ * @brief declarations for internal functions
+ *
+ * List of static functions local to this file
+ * Meant to be used in this file only
+ *
+ * @note all internal functions are static
+ */
+static void printUsage(const char *programName);
+static unsigned long parseNumber(const char *text, const char *optionName);
+static GraphKind parseKind(const char *text);
+static void parseGeneratorOptions(int argc, char *argv[], GeneratorOptions *options);
+static uint64_t nextRandom(uint64_t *state);
+static double nextUnit(uint64_t *state);
+static uint32_t *createPermutation(uint32_t noOfNodes, uint64_t *state);
+static void writeHeader(FILE *output, uint32_t noOfNodes, bool directed);
+static void writeEdge(FILE *output, uint32_t source, uint32_t destination, uint64_t *state);
+static void writeRandomEdges(FILE *output, const GeneratorOptions *options, uint64_t *state);
+static void writeGridEdges(FILE *output, unsigned int scale, uint64_t *state);
+static void writeChainEdges(FILE *output, uint32_t noOfNodes, uint64_t *state);
+
+/*
+ * @brief Display usage
+ *
+ * @param char pointer [array] (program name)
+ * @return void
+ *
+ */
+static void printUsage(const char *programName)
+{
+    printf("Usage: %s [options]\n", programName);
+    printf("  -k, --kind KIND        rmat (default), erdos-renyi, grid, chain\n");
+    printf("  -s, --scale N          the graph has 2^N vertices (default 16)\n");
+    printf("  -e, --edge-factor N    edges per vertex for rmat and erdos-renyi (default 16)\n");
+    printf("  -D, --directed         write a directed graph (default undirected)\n");
+    printf("      --seed N           random seed (default 1)\n");
+    printf("  -o, --output PATH      output file (default stdout)\n");
+    printf("  -h, --help             show this message\n");
+}
+
+/*
+ * @brief Parse a positive integer option value
+ *
+ * @param char pointer [array] (text)
+ * @param char pointer [array] (option name used in errors)
+ * @return unsigned long
+ *
+ */
+static unsigned long parseNumber(const char *text, const char *optionName)
+{
+    char *end;
+    unsigned long value = strtoul(text, &end, 10);
+
+    if (*text == '\0' || *end != '\0' || value == 0)
+    {
+        fprintf(stderr, "Invalid value for %s: %s\n", optionName, text);
+        exit(EXIT_FAILURE);
+    }
+
+    return value;
+}
+
+/*
+ * @brief Parse a graph kind name
+ *
+ * @param char pointer [array] (text)
+ * @return GraphKind
+ *
+ */
+static GraphKind parseKind(const char *text)
+{
+    if (strcmp(text, "rmat") == 0)
+    {
+        return RMAT_GRAPH;
+    }
+    else if (strcmp(text, "erdos-renyi") == 0)
+    {
+        return ERDOS_RENYI_GRAPH;
+    }
+    else if (strcmp(text, "grid") == 0)
+    {
+        return GRID_GRAPH;
+    }
+    else if (strcmp(text, "chain") == 0)
+    {
+        return CHAIN_GRAPH;
+    }
+
+    fprintf(stderr, "Unknown graph kind: %s\n", text);
+    exit(EXIT_FAILURE);
+}
+
+/*
+ * @brief Parse command line options
+ *
+ * @param int (argument count)
+ * @param char pointer [2d array] (argument values)
+ * @param GeneratorOptions (pointer*)
+ * @return void
+ *
+ */
+static void parseGeneratorOptions(int argc, char *argv[], GeneratorOptions *options)
+{
+    enum { SEED_OPTION = 256 };
+
+    static const struct option longOptions[] = {
+        { "kind", required_argument, NULL, 'k' },
+        { "scale", required_argument, NULL, 's' },
+        { "edge-factor", required_argument, NULL, 'e' },
+        { "directed", no_argument, NULL, 'D' },
+        { "seed", required_argument, NULL, SEED_OPTION },
+        { "output", required_argument, NULL, 'o' },
+        { "help", no_argument, NULL, 'h' },
+        { NULL, 0, NULL, 0 }
+    };
+
+    options->kind = RMAT_GRAPH;
+    options->scale = 16;
+    options->edgeFactor = 16;
+    options->directed = false;
+    options->seed = 1;
+    options->outputFileName = NULL;
+
+    int option;
+    while ((option = getopt_long(argc, argv, "k:s:e:Do:h", longOptions, NULL)) != -1)
+    {
+        switch (option)
+        {
+            case 'k':
+                options->kind = parseKind(optarg);
+                break;
+            case 's':
+                options->scale = (unsigned int)parseNumber(optarg, "--scale");
+                break;
+            case 'e':
+                options->edgeFactor = (unsigned int)parseNumber(optarg, "--edge-factor");
+                break;
+            case 'D':
+                options->directed = true;
+                break;
+            case SEED_OPTION:
+                options->seed = parseNumber(optarg, "--seed");
+                break;
+            case 'o':
+                options->outputFileName = optarg;
+                break;
+            case 'h':
+                printUsage(argv[0]);
+                exit(EXIT_SUCCESS);
+            default:
+                printUsage(argv[0]);
+                exit(EXIT_FAILURE);
+        }
+    }
+
+    if (optind < argc || options->scale > 31)
+    {
+        fprintf(stderr, "Scale must be at most 31 and no other arguments are taken\n");
+        exit(EXIT_FAILURE);
+    }
+}
+
+/*
+ * @brief Next random number (splitmix64)
+ *
+ * Same sequence on every platform, so a seed
+ * always gives the same graph
+ *
+ * @param uint64_t (pointer*) => generator state
+ * @return uint64_t
+ *
+ */
+static uint64_t nextRandom(uint64_t *state)
+{
+    uint64_t value = (*state += 0x9E3779B97F4A7C15ULL);
+
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+
+    return value ^ (value >> 31);
+}
+
+/*
+ * @brief Next random number in [0, 1)
+ *
+ * @param uint64_t (pointer*) => generator state
+ * @return double
+ *
+ */
+static double nextUnit(uint64_t *state)
+{
+    return (double)(nextRandom(state) >> 11) / (double)(1ULL << 53);
+}
+
+/*
+ * @brief Create a random vertex permutation
+ *
+ * Relabels generated vertices so the hubs of a
+ * generator are not packed at the low identifiers
+ *
+ * @param uint32_t (number of nodes)
+ * @param uint64_t (pointer*) => generator state
+ * @return uint32_t pointer [array] (permutation)
+ *
+ */
+static uint32_t *createPermutation(uint32_t noOfNodes, uint64_t *state)
+{
+    uint32_t *permutation = (uint32_t *)malloc(noOfNodes * sizeof(uint32_t));
+
+    if (permutation == NULL)
+    {
+        perror("Failed to allocate memory\n");
+        exit(EXIT_FAILURE);
+    }
+
+    for (uint32_t index = 0; index < noOfNodes; index++)
+    {
+        permutation[index] = index;
+    }
+
+    // Fisher Yates shuffle
+    for (uint32_t index = noOfNodes - 1; index > 0; index--)
+    {
+        uint32_t other = (uint32_t)(nextRandom(state) % (index + 1));
+        uint32_t swap = permutation[index];
+
+        permutation[index] = permutation[other];
+        permutation[other] = swap;
+    }
+
+    return permutation;
+}
+
+/*
+ * @brief Write the three header lines
+ *
+ * Nodes are named after their identifiers, so the
+ * node list is 0 to number of nodes - 1
+ *
+ * @param FILE (pointer*) => output stream
+ * @param uint32_t (number of nodes)
+ * @param bool (directed)
+ * @return void
+ *
+ */
+static void writeHeader(FILE *output, uint32_t noOfNodes, bool directed)
+{
+    fprintf(output, "%u\n", noOfNodes);
+
+    for (uint32_t node = 0; node < noOfNodes; node++)
+    {
+        fprintf(output, node == 0 ? "%u" : " %u", node);
+    }
+
+    fprintf(output, "\n%s\n", directed ? "directed" : "undirected");
+}
+
+/*
+ * @brief Write one edge with a random weight
+ *
+ * @param FILE (pointer*) => output stream
+ * @param uint32_t (source)
+ * @param uint32_t (destination)
+ * @param uint64_t (pointer*) => generator state
+ * @return void
+ *
+ */
+static void writeEdge(FILE *output, uint32_t source, uint32_t destination, uint64_t *state)
+{
+    fprintf(output, "%u %u %u\n", source, destination, (unsigned int)(nextRandom(state) % 100) + 1);
+}
+
+/*
+ * @brief Write rmat or erdos-renyi edges
+ *
+ * Rmat picks one quadrant of the adjacency matrix per
+ * bit of the scale with the Graph500 probabilities
+ * (0.57, 0.19, 0.19, 0.05). Erdos-renyi picks both ends
+ * uniformly and skips self loops
+ *
+ * @param FILE (pointer*) => output stream
+ * @param GeneratorOptions (pointer*)
+ * @param uint64_t (pointer*) => generator state
+ * @return void
+ *
+ * @note The first node written has at least one edge,
+ *       since the bfs starts from it
+ *
+ */
+static void writeRandomEdges(FILE *output, const GeneratorOptions *options, uint64_t *state)
+{
+    uint32_t noOfNodes = (uint32_t)1 << options->scale;
+    uint64_t noOfEdges = (uint64_t)noOfNodes * options->edgeFactor;
+    uint32_t *permutation = createPermutation(noOfNodes, state);
+    uint64_t edgeState = *state;
+
+    for (uint64_t edge = 0; edge < noOfEdges; edge++)
+    {
+        uint32_t source = 0, destination = 0;
+
+        if (options->kind == RMAT_GRAPH)
+        {
+            for (unsigned int bit = 0; bit < options->scale; bit++)
+            {
+                double quadrant = nextUnit(&edgeState);
+
+                source = source << 1 | (quadrant >= 0.76);
+                destination = destination << 1 | ((quadrant >= 0.57 && quadrant < 0.76) || quadrant >= 0.95);
+            }
+        }
+        else
+        {
+            do
+            {
+                source = (uint32_t)(nextRandom(&edgeState) % noOfNodes);
+                destination = (uint32_t)(nextRandom(&edgeState) % noOfNodes);
+            } while (source == destination && noOfNodes > 1);
+        }
+
+        // relabel so the first edge starts at node 0
+        if (edge == 0)
+        {
+            for (uint32_t index = 0; index < noOfNodes; index++)
+            {
+                if (permutation[index] == 0)
+                {
+                    permutation[index] = permutation[source];
+                    permutation[source] = 0;
+                    break;
+                }
+            }
+        }
+
+        writeEdge(output, permutation[source], permutation[destination], &edgeState);
+    }
+
+    free(permutation);
+}
+
+/*
+ * @brief Write 2D grid edges
+ *
+ * Every cell links to its right and lower
+ * neighbour. The grid has 2^(scale / 2) rows
+ *
+ * @param FILE (pointer*) => output stream
+ * @param unsigned int (scale)
+ * @param uint64_t (pointer*) => generator state
+ * @return void
+ *
+ */
+static void writeGridEdges(FILE *output, unsigned int scale, uint64_t *state)
+{
+    uint32_t noOfRows = (uint32_t)1 << (scale / 2);
+    uint32_t noOfColumns = ((uint32_t)1 << scale) / noOfRows;
+
+    for (uint32_t row = 0; row < noOfRows; row++)
+    {
+        for (uint32_t column = 0; column < noOfColumns; column++)
+        {
+            uint32_t cell = row * noOfColumns + column;
+
+            if (column + 1 < noOfColumns)
+            {
+                writeEdge(output, cell, cell + 1, state);
+            }
+
+            if (row + 1 < noOfRows)
+            {
+                writeEdge(output, cell, cell + noOfColumns, state);
+            }
+        }
+    }
+}
+
+/*
+ * @brief Write chain edges
+ *
+ * @param FILE (pointer*) => output stream
+ * @param uint32_t (number of nodes)
+ * @param uint64_t (pointer*) => generator state
+ * @return void
+ *
+ */
+static void writeChainEdges(FILE *output, uint32_t noOfNodes, uint64_t *state)
+{
+    for (uint32_t node = 0; node + 1 < noOfNodes; node++)
+    {
+        writeEdge(output, node, node + 1, state);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    GeneratorOptions options;
+    parseGeneratorOptions(argc, argv, &options);
+
+    FILE *output = stdout;
+
+    if (options.outputFileName != NULL)
+    {
+        output = fopen(options.outputFileName, "w");
+
+        if (output == NULL)
+        {
+            perror("Error in file\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    static char outputBuffer[1 << 20];
+    setvbuf(output, outputBuffer, _IOFBF, sizeof(outputBuffer));
+
+    uint64_t state = options.seed;
+    uint32_t noOfNodes = (uint32_t)1 << options.scale;
+
+    writeHeader(output, noOfNodes, options.directed);
+
+    switch (options.kind)
+    {
+        case RMAT_GRAPH:
+        case ERDOS_RENYI_GRAPH:
+            writeRandomEdges(output, &options, &state);
+            break;
+        case GRID_GRAPH:
+            writeGridEdges(output, options.scale, &state);
+            break;
+        case CHAIN_GRAPH:
+            writeChainEdges(output, noOfNodes, &state);
+            break;
+    }
+
+    if (fclose(output) != 0)
+    {
+        perror("Error in file\n");
+        exit(EXIT_FAILURE);
+    }
+
+    return 0;
+}
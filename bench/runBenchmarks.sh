@@ -0,0 +1,37 @@
+#!/bin/sh
+# Generates the benchmark graphs (once per scale) and runs every
+# traversal mode on each of them, one JSON object per line. ORDER
+# other than none also times every graph relabelled that way.
+#
+# Usage: runBenchmarks.sh BUILD_DIR OUTPUT COMMIT SCALE EDGE_FACTOR RUNS [ORDER]
+set -e
+
+buildDir=$1
+output=$2
+commit=$3
+scale=$4
+edgeFactor=$5
+runs=$6
+order=${7:-none}
+
+graphDir=$(dirname "$output")/graphs
+mkdir -p "$graphDir"
+: > "$output"
+
+for kind in rmat erdos-renyi grid chain
+do
+    graph=$graphDir/$kind-$scale-$edgeFactor.txt
+
+    if [ ! -f "$graph" ]
+    then
+        "$buildDir/generateGraph" --kind "$kind" --scale "$scale" --edge-factor "$edgeFactor" --output "$graph"
+    fi
+
+    for mode in top-down direction-optimizing parallel numa
+    do
+        "$buildDir/benchmark" --file "$graph" --mode "$mode" --runs "$runs" --order "$order" \
+            --name "$kind-$scale-$edgeFactor" --commit "$commit" >> "$output"
+    done
+done
+
+echo "Benchmark results written to $output"
@@ -0,0 +1,60 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+
+/*
+ * @brief Arena block size
+ *
+ * Default size of a block. Requests that do not
+ * fit a block get a block of their own
+ *
+ */
+#define ARENA_BLOCK_SIZE ((size_t)1 << 20)
+
+/*
+ * @brief Arena allocation alignment
+ *
+ * Every allocation starts on a cache line
+ *
+ */
+#define ARENA_ALIGNMENT 64
+
+/*
+ * @brief Arena block data structure
+ *
+ * @member ArenaBlock (pointer*) => next block of the arena
+ * @member size_t (capacity) => usable bytes in data
+ * @member size_t (used) => bytes handed out so far
+ * @member unsigned char [array] (data) => storage of the block
+ *
+ */
+typedef struct ArenaBlock {
+    struct ArenaBlock *next;
+    size_t capacity;
+    size_t used;
+    unsigned char data[];
+} ArenaBlock;
+
+/*
+ * @brief Arena data structure
+ *
+ * Arena struct is a bump allocator. Memory is
+ * carved out of large blocks and only given back
+ * all at once, so freeing costs one call per block
+ * 
+ * @member ArenaBlock (pointer*) => block being filled, followed by the others
+ * @member size_t (bytes reserved) => total capacity of every block
+ *
+ */
+typedef struct Arena {
+    ArenaBlock *blocks;
+    size_t bytesReserved;
+} Arena;
+
+void initArena(Arena *arena);
+void *arenaAllocate(Arena *arena, size_t size);
+void *arenaAllocateZeroed(Arena *arena, size_t size);
+void freeArena(Arena *arena);
+
+#endif
@@ -0,0 +1,43 @@
+#ifndef BFS_VISITOR_H
+#define BFS_VISITOR_H
+
+#include <stddef.h>
+#include "types.h"
+
+/*
+ * @brief Bfs visitor data structure
+ *
+ * BfsVisitor struct receives the result of a
+ * traversal as it is produced, so callers can
+ * stream it instead of materializing it. Any
+ * callback may be NULL
+ * 
+ * Every kernel reports a level once all of its
+ * vertices are known, in traversal order, and the
+ * unreachable vertices in node list order once
+ * the traversal is over. That is ascending
+ * identifier order unless the graph was reordered
+ * 
+ * @member function pointer (on discover) => called per vertex with its level
+ * @member function pointer (on level end) => called after the last vertex of a level
+ * @member function pointer (on unreachable) => called per vertex that was not reached
+ * @member void pointer (context) => passed back to every callback
+ *
+ */
+typedef struct BfsVisitor {
+    void (*onDiscover)(VertexId vertex, unsigned int level, void *context);
+    void (*onLevelEnd)(unsigned int level, unsigned int levelSize, void *context);
+    void (*onUnreachable)(VertexId vertex, void *context);
+    void *context;
+} BfsVisitor;
+
+void visitLevel
+(
+    const BfsVisitor *visitor,
+    const VertexId *traversalPath,
+    unsigned int levelStart,
+    unsigned int levelEnd,
+    unsigned int level
+);
+
+#endif
@@ -0,0 +1,100 @@
+#ifndef BITMAP_H
+#define BITMAP_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * @brief Bits held by one bitmap word
+ */
+#define BITMAP_WORD_BITS 64
+
+/*
+ * @brief Bitmap data structure
+ *
+ * Bitmap struct stores one bit per vertex
+ * packed into 64 bit words
+ * 
+ * @member uint64_t pointer [array] (words) => packed bits, bit i lives in words[i / 64]
+ * @member size_t (number of words) => number of allocated words
+ * @member size_t (number of bits) => number of usable bits
+ *
+ */
+typedef struct Bitmap {
+    uint64_t *words;
+    size_t noOfWords;
+    size_t noOfBits;
+} Bitmap;
+
+void initBitmap(Bitmap *bitmap, size_t noOfBits);
+void clearBitmap(Bitmap *bitmap);
+size_t countSetBits(const Bitmap *bitmap);
+size_t collectClearBits(const Bitmap *bitmap, uint32_t *bits);
+void freeBitmap(Bitmap *bitmap);
+
+/*
+ * @brief Check if a bit is set
+ * 
+ * @param Bitmap (pointer*)
+ * @param size_t (bit index)
+ * @return bool
+ * 
+ */
+static inline bool testBit(const Bitmap *bitmap, size_t index)
+{
+    return (bitmap->words[index / BITMAP_WORD_BITS] >> (index % BITMAP_WORD_BITS)) & 1;
+}
+
+/*
+ * @brief Set a bit
+ * 
+ * @param Bitmap (pointer*)
+ * @param size_t (bit index)
+ * @return void
+ * 
+ */
+static inline void setBit(Bitmap *bitmap, size_t index)
+{
+    bitmap->words[index / BITMAP_WORD_BITS] |= (uint64_t)1 << (index % BITMAP_WORD_BITS);
+}
+
+/*
+ * @brief Clear a bit
+ * 
+ * @param Bitmap (pointer*)
+ * @param size_t (bit index)
+ * @return void
+ * 
+ */
+static inline void clearBit(Bitmap *bitmap, size_t index)
+{
+    bitmap->words[index / BITMAP_WORD_BITS] &= ~((uint64_t)1 << (index % BITMAP_WORD_BITS));
+}
+
+/*
+ * @brief Atomically set a bit
+ * 
+ * Safe to call from several threads on
+ * the same word at once
+ * 
+ * @param Bitmap (pointer*)
+ * @param size_t (bit index)
+ * @return bool (true if this call changed the bit)
+ * 
+ */
+static inline bool setBitAtomic(Bitmap *bitmap, size_t index)
+{
+    uint64_t mask = (uint64_t)1 << (index % BITMAP_WORD_BITS);
+    uint64_t *word = &bitmap->words[index / BITMAP_WORD_BITS];
+
+    // plain load first so set bits cost no atomic
+    if (__atomic_load_n(word, __ATOMIC_RELAXED) & mask)
+    {
+        return false;
+    }
+
+    return (__atomic_fetch_or(word, mask, __ATOMIC_RELAXED) & mask) == 0;
+}
+
+#endif
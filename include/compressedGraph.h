@@ -0,0 +1,69 @@
+#ifndef COMPRESSED_GRAPH_H
+#define COMPRESSED_GRAPH_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "types.h"
+
+/*
+ * @brief Read one varint
+ *
+ * Seven bits per byte, lowest first, with the
+ * top bit set on every byte but the last
+ *
+ * @param uint8_t pointer [array] (bytes) => start of the varint
+ * @param uint64_t (pointer*) => receives the value
+ * @return uint8_t pointer [array] (byte after the varint)
+ *
+ */
+static inline const uint8_t *readVarint(const uint8_t *bytes, uint64_t *value)
+{
+    uint64_t result = *bytes & 0x7F;
+
+    // gaps of sorted rows mostly fit in one byte
+    if (*bytes++ < 0x80)
+    {
+        *value = result;
+        return bytes;
+    }
+
+    unsigned int shift = 7;
+    uint8_t byte;
+
+    do
+    {
+        byte = *bytes++;
+        result |= (uint64_t)(byte & 0x7F) << shift;
+        shift += 7;
+    } while (byte >= 0x80);
+
+    *value = result;
+    return bytes;
+}
+
+/*
+ * @brief Decode the first neighbour of a row
+ *
+ * @param VertexId (vertex) => owner of the row
+ * @param uint64_t (zigzag encoded difference)
+ * @return VertexId
+ *
+ */
+static inline VertexId decodeFirstNeighbour(VertexId vertex, uint64_t encoded)
+{
+    int64_t difference = (int64_t)(encoded >> 1) ^ -(int64_t)(encoded & 1);
+
+    return (VertexId)((int64_t)vertex + difference);
+}
+
+void compressGraph(Graph *graph);
+size_t getAdjacencyBytes(const Graph *graph);
+size_t decodeCompressedRow
+(
+    const Graph *graph,
+    VertexId vertex,
+    VertexId *neighbours,
+    unsigned int *weights
+);
+
+#endif
@@ -0,0 +1,29 @@
+#ifndef CONNECTED_COMPONENTS_H
+#define CONNECTED_COMPONENTS_H
+
+#include "types.h"
+
+/*
+ * @brief Connected components data structure
+ *
+ * Components struct labels every vertex with its
+ * component. Components are numbered from 0 in the
+ * order of their first vertex in the node list
+ *
+ * @member unsigned int pointer [array] (labels) => component of every vertex
+ * @member unsigned int pointer [array] (sizes) => vertices in every component
+ * @member unsigned int (number of components)
+ * @member size_t (edges examined) => edges linked by the search
+ *
+ */
+typedef struct Components {
+    unsigned int *labels;
+    unsigned int *sizes;
+    unsigned int noOfComponents;
+    size_t edgesExamined;
+} Components;
+
+void findConnectedComponents(Graph *graph, unsigned int noOfThreads, Components *components);
+void freeComponents(Components *components);
+
+#endif
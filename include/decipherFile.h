@@ -3,7 +3,23 @@
 
 #include "types.h"
 
-Graph *createGraphFromFile();
+/*
+ * @brief Load timings data structure
+ *
+ * LoadTimings struct splits the time taken
+ * by createGraphFromFile into its two stages
+ * 
+ * @member double (load seconds) => mapping and parsing the file
+ * @member double (build seconds) => building the adjacency arrays
+ *
+ */
+typedef struct LoadTimings {
+    double loadSeconds;
+    double buildSeconds;
+} LoadTimings;
+
+Graph *createGraphFromFile(const char *fileName, unsigned int noOfThreads, LoadTimings *timings);
+VertexId *readSourceList(const Graph *graph, const char *fileName, unsigned int *noOfSources);
 void freeGraph(Graph *graph);
 
 #endif
\ No newline at end of file
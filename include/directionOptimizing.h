@@ -0,0 +1,19 @@
+#ifndef DIRECTION_OPTIMIZING_H
+#define DIRECTION_OPTIMIZING_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "bitmap.h"
+#include "types.h"
+#include "logic.h"
+
+unsigned int directionOptimizingTraversal
+(
+    Graph *graph,
+    const TraversalOptions *options,
+    Bitmap *visited,
+    VertexId *traversalPath,
+    size_t *edgesExamined
+);
+
+#endif
@@ -0,0 +1,68 @@
+#ifndef DISTRIBUTED_BFS_H
+#define DISTRIBUTED_BFS_H
+
+#include <stddef.h>
+#include "types.h"
+#include "bfsVisitor.h"
+
+/*
+ * @brief Most worker processes a distributed traversal runs
+ *
+ * Every pair of workers holds a socket pair
+ */
+#define MAX_BFS_PROCESSES 16
+
+/*
+ * @brief Level traffic data structure
+ *
+ * LevelTraffic struct is what the workers
+ * exchanged while expanding one level
+ *
+ * @member unsigned int (level size) => vertices in the level
+ * @member size_t (batches) => non-empty batches sent between workers
+ * @member size_t (vertices sent) => vertices in those batches
+ * @member size_t (bytes sent) => bytes written between workers, batch headers included
+ * @member size_t (duplicates dropped) => neighbours not sent since their owner already had them
+ *
+ */
+typedef struct LevelTraffic {
+    unsigned int levelSize;
+    size_t batches;
+    size_t verticesSent;
+    size_t bytesSent;
+    size_t duplicatesDropped;
+} LevelTraffic;
+
+/*
+ * @brief Distributed traversal stats data structure
+ *
+ * DistributedTraversalStats struct reports how
+ * much the worker processes had to communicate
+ *
+ * @member unsigned int (traversal length) => number of vertices reached
+ * @member size_t (edges examined)
+ * @member unsigned int (number of processes) => worker processes used
+ * @member unsigned int (number of levels)
+ * @member LevelTraffic pointer [array] (levels) => traffic of each level
+ * @member size_t (report bytes) => bytes the workers sent the coordinator
+ *
+ */
+typedef struct DistributedTraversalStats {
+    unsigned int traversalLength;
+    size_t edgesExamined;
+    unsigned int noOfProcesses;
+    unsigned int noOfLevels;
+    LevelTraffic *levels;
+    size_t reportBytes;
+} DistributedTraversalStats;
+
+void runDistributedTraversal
+(
+    const Graph *graph,
+    unsigned int noOfProcesses,
+    const BfsVisitor *visitor,
+    DistributedTraversalStats *stats
+);
+void freeDistributedTraversalStats(DistributedTraversalStats *stats);
+
+#endif
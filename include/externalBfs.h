@@ -0,0 +1,33 @@
+#ifndef EXTERNAL_BFS_H
+#define EXTERNAL_BFS_H
+
+#include <stddef.h>
+#include "types.h"
+#include "bfsVisitor.h"
+#include "graphSnapshot.h"
+
+/*
+ * @brief External traversal stats data structure
+ *
+ * ExternalTraversalStats struct reports how
+ * much of the snapshot a semi-external bfs read
+ *
+ * @member unsigned int (traversal length) => number of vertices reached
+ * @member size_t (edges examined)
+ * @member unsigned int (number of levels)
+ * @member unsigned int pointer [array] (level sizes) => vertices per level
+ * @member size_t pointer [array] (level bytes read) => adjacency bytes read expanding each level
+ *
+ */
+typedef struct ExternalTraversalStats {
+    unsigned int traversalLength;
+    size_t edgesExamined;
+    unsigned int noOfLevels;
+    unsigned int *levelSizes;
+    size_t *levelBytesRead;
+} ExternalTraversalStats;
+
+void runExternalTraversal(ExternalGraph *graph, const BfsVisitor *visitor, ExternalTraversalStats *stats);
+void freeExternalTraversalStats(ExternalTraversalStats *stats);
+
+#endif
@@ -0,0 +1,104 @@
+#ifndef GRAPH_BUILDER_H
+#define GRAPH_BUILDER_H
+
+#include <stddef.h>
+#include "arena.h"
+#include "types.h"
+
+/*
+ * @brief Edge data structure
+ *
+ * Edge struct is used to hold a single
+ * parsed edge until the adjacency arrays
+ * of the graph are built
+ * 
+ * @member VertexId (source) => identifier of the starting vertex
+ * @member VertexId (destination) => identifier of the ending vertex
+ * @member unsigned int (weight) => stores the weight of the edge
+ *
+ */
+typedef struct Edge {
+    VertexId source;
+    VertexId destination;
+    unsigned int weight;
+} Edge;
+
+/*
+ * @brief Edges held by one edge block
+ */
+#define EDGE_BLOCK_LENGTH 4096
+
+/*
+ * @brief Edge block data structure
+ *
+ * @member EdgeBlock (pointer*) => next block in parse order
+ * @member size_t (length) => number of edges stored
+ * @member Edge [array] (edges) => stores the parsed edges
+ *
+ */
+typedef struct EdgeBlock {
+    struct EdgeBlock *next;
+    size_t length;
+    Edge edges[EDGE_BLOCK_LENGTH];
+} EdgeBlock;
+
+/*
+ * @brief Edge list data structure
+ *
+ * EdgeList struct is a chain of fixed size
+ * blocks of edges kept in the order they were
+ * parsed. Blocks come from the list's own arena,
+ * so growing never copies and freeing releases
+ * a few large blocks
+ * 
+ * @member Arena (arena) => owns every block of the list
+ * @member EdgeBlock (pointer*) (first) => first block, NULL when empty
+ * @member EdgeBlock (pointer*) (last) => block being filled
+ * @member size_t (length) => number of edges stored
+ *
+ */
+typedef struct EdgeList {
+    Arena arena;
+    EdgeBlock *first;
+    EdgeBlock *last;
+    size_t length;
+} EdgeList;
+
+/*
+ * @brief Row key payload
+ *
+ * Selects what sortRowKeys packs below the
+ * neighbour of every edge
+ *
+ * @value ROW_KEY_POSITION => position of the edge in its row, keeps file order among copies
+ * @value ROW_KEY_WEIGHT => weight of the edge
+ *
+ */
+typedef enum RowKeyPayload {
+    ROW_KEY_POSITION,
+    ROW_KEY_WEIGHT
+} RowKeyPayload;
+
+void initEdgeList(EdgeList *edgeList);
+void appendEdge
+(
+    EdgeList *edgeList,
+    VertexId source,
+    VertexId destination,
+    unsigned int weight
+);
+void freeEdgeList(EdgeList *edgeList);
+void buildAdjacencyArrays(Graph *graph, const EdgeList *edgeList);
+void buildAdjacencyArraysFromLists
+(
+    Graph *graph,
+    const EdgeList *edgeLists,
+    unsigned int noOfLists
+);
+void buildIncomingArrays(Graph *graph);
+void replaceGraphArena(Graph *graph, Arena *arena);
+VertexId findEdgeBoundary(const Graph *graph, size_t edges);
+int compareSortKeys(const void *first, const void *second);
+size_t sortRowKeys(const Graph *graph, VertexId vertex, RowKeyPayload payload, uint64_t *keys);
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef GRAPH_SNAPSHOT_H
+#define GRAPH_SNAPSHOT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "types.h"
+
+/*
+ * @brief External graph data structure
+ *
+ * ExternalGraph struct is a snapshot opened
+ * without loading its adjacency. Only the edge
+ * offsets are read into memory; neighbours are
+ * read from the file on demand and names are
+ * looked up in a read only mapping
+ *
+ * @member int (file descriptor) => open snapshot
+ * @member char pointer [array] (file name) => used in errors
+ * @member unsigned int (number of nodes)
+ * @member size_t (number of edges)
+ * @member unsigned int (total weight)
+ * @member bool (directed)
+ * @member size_t pointer [array] (edge offsets) => row starts, as in Graph
+ * @member size_t (adjacency start) => file offset of the adjacent nodes section
+ * @member VertexDictionary (dictionary) => points into the name mapping
+ * @member void pointer (name mapping) => name sections of the file
+ * @member size_t (name mapping length)
+ * @member size_t (offset bytes read) => bytes read to load the edge offsets
+ *
+ */
+typedef struct ExternalGraph {
+    int fileDescriptor;
+    const char *fileName;
+    unsigned int noOfNodes;
+    size_t noOfEdges;
+    unsigned int totalWeight;
+    bool directed;
+    size_t *edgeOffsets;
+    size_t adjacencyStart;
+    VertexDictionary dictionary;
+    void *nameMapping;
+    size_t nameMappingLength;
+    size_t offsetBytesRead;
+} ExternalGraph;
+
+bool isGraphSnapshot(const char *contents, size_t length);
+void openGraphSnapshot(Graph *graph, void *mapping, size_t length, const char *fileName);
+void saveGraphSnapshot(const Graph *graph, const char *fileName);
+void openExternalGraph(ExternalGraph *graph, const char *fileName);
+void readExternalEdges(const ExternalGraph *graph, size_t firstEdge, size_t noOfEdges, VertexId *edges);
+void closeExternalGraph(ExternalGraph *graph);
+
+#endif
@@ -0,0 +1,78 @@
+#ifndef GRAPH_UPDATES_H
+#define GRAPH_UPDATES_H
+
+#include <stddef.h>
+#include "types.h"
+
+/*
+ * @brief Edge update data structure
+ *
+ * EdgeUpdate struct is one queued change of
+ * the adjacency. Updates of an undirected graph
+ * change both directions of the edge
+ *
+ * @member VertexId (from) => source of the edge
+ * @member VertexId (to) => target of the edge
+ * @member unsigned int (weight) => weight of an inserted edge
+ * @member bool (removal) => removes every from -> to edge instead of inserting one
+ *
+ */
+typedef struct EdgeUpdate {
+    VertexId from;
+    VertexId to;
+    unsigned int weight;
+    bool removal;
+} EdgeUpdate;
+
+/*
+ * @brief Update batch data structure
+ *
+ * UpdateBatch struct buffers edge updates until
+ * they are merged into the adjacency together, so
+ * a trickle of updates pays for one pass over the
+ * adjacency per batch instead of one per update
+ *
+ * @member EdgeUpdate pointer [array] (updates) => updates in the order they were queued
+ * @member size_t (length) => number of queued updates
+ * @member size_t (capacity) => updates that fit before growing
+ *
+ */
+typedef struct UpdateBatch {
+    EdgeUpdate *updates;
+    size_t length;
+    size_t capacity;
+} UpdateBatch;
+
+/*
+ * @brief Incremental bfs data structure
+ *
+ * IncrementalBfs struct keeps the hop distance of
+ * every vertex from one source up to date while
+ * batches are applied. A batch only revisits the
+ * vertices whose distance it can change
+ *
+ * @member VertexId (source) => vertex the distances are measured from
+ * @member unsigned int pointer [array] (distances) => hops from the source, UNREACHED_DISTANCE
+ *                                                     when not reached
+ * @member unsigned int (traversal length) => number of vertices reached
+ * @member size_t (distances changed) => vertices whose distance the last batch changed
+ * @member size_t (vertices examined) => vertices the last batch revisited
+ *
+ */
+typedef struct IncrementalBfs {
+    VertexId source;
+    unsigned int *distances;
+    unsigned int traversalLength;
+    size_t distancesChanged;
+    size_t verticesExamined;
+} IncrementalBfs;
+
+void initUpdateBatch(UpdateBatch *batch);
+void queueEdgeInsertion(UpdateBatch *batch, VertexId from, VertexId to, unsigned int weight);
+void queueEdgeRemoval(UpdateBatch *batch, VertexId from, VertexId to);
+void freeUpdateBatch(UpdateBatch *batch);
+void applyUpdateBatch(Graph *graph, UpdateBatch *batch, IncrementalBfs *bfs);
+void initIncrementalBfs(IncrementalBfs *bfs, Graph *graph, VertexId source);
+void freeIncrementalBfs(IncrementalBfs *bfs);
+
+#endif
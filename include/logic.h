@@ -1,6 +1,68 @@
 #ifndef LOGIC_H
 #define LOGIC_H
 
+#include <stdbool.h>
+#include <stddef.h>
+#include "types.h"
+#include "traversalContext.h"
+#include "traversalProfile.h"
+#include "bfsVisitor.h"
+
+/*
+ * @brief Traversal mode
+ *
+ * Selects the kernel used to traverse the graph
+ * 
+ * @value TOP_DOWN_TRAVERSAL => classic queue based bfs
+ * @value DIRECTION_OPTIMIZING_TRAVERSAL => switches between top-down and bottom-up steps
+ * @value PARALLEL_TRAVERSAL => multithreaded level synchronous bfs
+ * @value NUMA_TRAVERSAL => level synchronous bfs with each numa node expanding the vertices it owns
+ * 
+ */
+typedef enum TraversalMode {
+    TOP_DOWN_TRAVERSAL,
+    DIRECTION_OPTIMIZING_TRAVERSAL,
+    PARALLEL_TRAVERSAL,
+    NUMA_TRAVERSAL
+} TraversalMode;
+
+typedef struct NumaBalance NumaBalance;
+
+/*
+ * @brief Traversal options data structure
+ *
+ * TraversalOptions struct is used to pick
+ * and tune the traversal kernel
+ * 
+ * @member TraversalMode (mode) => kernel used to traverse the graph
+ * @member unsigned int (alpha) => go bottom-up once frontier edges exceed unvisited edges / alpha
+ * @member unsigned int (beta) => go top-down once a shrinking frontier has at most nodes / beta vertices
+ * @member unsigned int (number of threads) => threads for the parallel and numa kernels, 0 for every core
+ * @member bool (deterministic) => parallel kernel keeps the top-down path order
+ * @member unsigned int (delta) => bucket width of delta stepping, 0 for the average edge weight
+ * @member bool (verbose) => also print the number of edges examined
+ * @member char pointer [array] (stats file name) => write per level statistics as JSON here, "-" for stdout
+ * @member bool (hardware counters) => also record cache and branch misses
+ * @member TraversalProfile (pointer*) => set while a profiled traversal runs, NULL otherwise
+ * @member BfsVisitor (pointer*) => set while a visited traversal runs, NULL otherwise
+ * @member NumaBalance (pointer*) => receives the per node work of a numa traversal, may be NULL
+ * 
+ */
+typedef struct TraversalOptions {
+    TraversalMode mode;
+    unsigned int alpha;
+    unsigned int beta;
+    unsigned int noOfThreads;
+    bool deterministic;
+    unsigned int delta;
+    bool verbose;
+    const char *statsFileName;
+    bool hardwareCounters;
+    TraversalProfile *profile;
+    const BfsVisitor *visitor;
+    NumaBalance *numaBalance;
+} TraversalOptions;
+
 /*
  * @brief Traversal statistics data structure
  *
@@ -8,19 +70,62 @@
  * the data recieved from traversing the
  * graph
  * 
- * @member char pointer [array] (traversal path) => stores name of nodes in traversal order
+ * @member VertexId pointer [array] (traversal path) => stores nodes in traversal order
  * @member unsigned int (traversal length) => stores the number of nodes traversed
- * @member char pointer [array] (unreachable nodes) => stores the name of nodes that cannot be reached
+ * @member VertexId pointer [array] (unreachable nodes) => stores the nodes that cannot be reached
  * @member unsigned int (unreachable nodes length) => stores number of nodes that cannot be reached
+ * @member size_t (edges examined) => stores number of edges scanned by the traversal
  * 
  */
 typedef struct TraversalStats {
-    char *traversalPath;
+    VertexId *traversalPath;
     unsigned int traversalLength;
-    char *unReachableNodes;
+    VertexId *unReachableNodes;
     unsigned int unReachableLength;
+    size_t edgesExamined;
 } TraversalStats;
 
-void displayDataFromTraversingGraph(Graph *graph);
+void initTraversalOptions(TraversalOptions *options);
+void runTraversal
+(
+    TraversalContext *context,
+    Graph *graph,
+    const TraversalOptions *options,
+    TraversalStats *traversalStats
+);
+TraversalStats bfsAlgorithm(Graph *graph, const TraversalOptions *options);
+size_t visitTraversal(Graph *graph, const TraversalOptions *options, const BfsVisitor *visitor);
+const char *getTraversalModeName(TraversalMode mode);
+void freeTraversalStats(TraversalStats *traversalStats);
+void displayDataFromTraversingGraph(Graph *graph, const TraversalOptions *options);
+void displayBfsTree(const Graph *graph);
+void displayConnectedComponents
+(
+    Graph *graph,
+    const char *labelsFileName,
+    const TraversalOptions *options
+);
+void displayWeightedShortestPaths(const Graph *graph, const TraversalOptions *options);
+void displayShortestPath
+(
+    Graph *graph,
+    const char *startName,
+    const char *goalName,
+    const TraversalOptions *options
+);
+void displayDataFromMultiSourceTraversal
+(
+    Graph *graph,
+    const VertexId *sources,
+    unsigned int noOfSources,
+    const TraversalOptions *options
+);
+void displayDataFromExternalTraversal(const char *fileName, const TraversalOptions *options);
+void displayDataFromDistributedTraversal
+(
+    const Graph *graph,
+    unsigned int noOfProcesses,
+    const TraversalOptions *options
+);
 
 #endif
\ No newline at end of file
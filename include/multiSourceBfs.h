@@ -0,0 +1,26 @@
+#ifndef MULTI_SOURCE_BFS_H
+#define MULTI_SOURCE_BFS_H
+
+#include <stddef.h>
+#include "types.h"
+#include "logic.h"
+
+/*
+ * @brief Sources sharing one traversal
+ *
+ * Every vertex carries one bit per source
+ * of a batch in a single 64-bit word
+ *
+ */
+#define MULTI_SOURCE_BATCH 64
+
+size_t multiSourceTraversal
+(
+    Graph *graph,
+    const VertexId *sources,
+    unsigned int noOfSources,
+    unsigned int noOfThreads,
+    TraversalStats *results
+);
+
+#endif
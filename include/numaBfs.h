@@ -0,0 +1,64 @@
+#ifndef NUMA_BFS_H
+#define NUMA_BFS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "bitmap.h"
+#include "types.h"
+#include "logic.h"
+
+/*
+ * @brief Numa node work data structure
+ *
+ * NumaNodeWork struct is what one node did
+ * during a numa traversal
+ *
+ * @member unsigned int (node) => operating system id of the node
+ * @member unsigned int (number of threads) => workers pinned to the node
+ * @member VertexId (first vertex) => first vertex the node owns
+ * @member VertexId (last vertex) => one past the last vertex the node owns
+ * @member size_t (vertices expanded) => frontier vertices whose rows the node scanned
+ * @member size_t (edges examined)
+ * @member size_t (vertices sent) => neighbours handed off to other nodes
+ * @member size_t (vertices received) => neighbours other nodes handed off to this one
+ *
+ */
+typedef struct NumaNodeWork {
+    unsigned int node;
+    unsigned int noOfThreads;
+    VertexId firstVertex;
+    VertexId lastVertex;
+    size_t verticesExpanded;
+    size_t edgesExamined;
+    size_t verticesSent;
+    size_t verticesReceived;
+} NumaNodeWork;
+
+/*
+ * @brief Numa balance data structure
+ *
+ * NumaBalance struct reports how the work of
+ * a numa traversal was spread over the nodes
+ *
+ * @member unsigned int (number of nodes) => nodes the traversal ran on
+ * @member bool (pages placed) => adjacency and visited pages were moved to their nodes
+ * @member NumaNodeWork pointer [array] (nodes) => one entry per node
+ *
+ */
+typedef struct NumaBalance {
+    unsigned int noOfNodes;
+    bool pagesPlaced;
+    NumaNodeWork *nodes;
+} NumaBalance;
+
+unsigned int numaTraversal
+(
+    const Graph *graph,
+    const TraversalOptions *options,
+    Bitmap *visited,
+    VertexId *traversalPath,
+    size_t *edgesExamined
+);
+void freeNumaBalance(NumaBalance *balance);
+
+#endif
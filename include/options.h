@@ -0,0 +1,62 @@
+#ifndef OPTIONS_H
+#define OPTIONS_H
+
+#include <stdbool.h>
+#include "logic.h"
+#include "reorder.h"
+#include "simplifyGraph.h"
+
+/*
+ * @brief Program options data structure
+ *
+ * Options struct holds everything that can
+ * be set from the command line
+ * 
+ * @member char pointer [array] (file name) => path of the graph data file
+ * @member char pointer [array] (snapshot file name) => save a binary snapshot here, NULL to traverse
+ * @member char pointer [array] (sources file name) => run a bfs from every node listed here, NULL for one bfs
+ * @member bool (serve) => answer bfs requests from stdin instead of traversing once
+ * @member char pointer [array] (socket path) => answer bfs requests on this unix socket, NULL for none
+ * @member bool (tree) => print the parent and distance of every node instead of the path
+ * @member char pointer [array] (path start) => print the shortest path from this node, NULL for none
+ * @member char pointer [array] (path goal) => print the shortest path to this node, NULL for none
+ * @member bool (components) => print the connected components instead of the path
+ * @member char pointer [array] (labels file name) => write the component of every node here, NULL for none
+ * @member bool (weighted) => print weighted shortest paths from the first node instead of the path
+ * @member ReorderMethod (reorder) => relabel the vertices for locality before anything runs
+ * @member MultiEdgePolicy (multi edge policy) => sort the rows and merge repeated edges this way
+ * @member bool (drop self loops) => remove edges from a vertex to itself
+ * @member bool (compress) => traverse a varint compressed adjacency
+ * @member bool (external) => traverse a snapshot from disk without loading it
+ * @member unsigned int (number of processes) => traverse with this many worker processes, 0 for none
+ * @member TraversalOptions (traversal) => options passed to the bfs kernels
+ * 
+ */
+typedef struct Options {
+    const char *fileName;
+    const char *snapshotFileName;
+    const char *sourcesFileName;
+    bool serve;
+    const char *socketPath;
+    bool tree;
+    const char *pathStart;
+    const char *pathGoal;
+    bool components;
+    const char *labelsFileName;
+    bool weighted;
+    ReorderMethod reorder;
+    MultiEdgePolicy multiEdgePolicy;
+    bool dropSelfLoops;
+    bool compress;
+    bool external;
+    unsigned int noOfProcesses;
+    TraversalOptions traversal;
+} Options;
+
+void parseOptions(int argc, char *argv[], Options *options);
+unsigned int parsePositive(const char *text, const char *optionName);
+TraversalMode parseTraversalMode(const char *text);
+ReorderMethod parseReorderMethod(const char *text);
+MultiEdgePolicy parseMultiEdgePolicy(const char *text);
+
+#endif
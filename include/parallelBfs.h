@@ -0,0 +1,20 @@
+#ifndef PARALLEL_BFS_H
+#define PARALLEL_BFS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "bitmap.h"
+#include "types.h"
+#include "logic.h"
+#include "workerThreads.h"
+
+unsigned int parallelTraversal
+(
+    const Graph *graph,
+    const TraversalOptions *options,
+    Bitmap *visited,
+    VertexId *traversalPath,
+    size_t *edgesExamined
+);
+
+#endif
@@ -0,0 +1,10 @@
+#ifndef QUERY_SERVER_H
+#define QUERY_SERVER_H
+
+#include <stdio.h>
+#include "types.h"
+
+void serveQueries(Graph *graph, FILE *input, FILE *output);
+void serveUnixSocket(Graph *graph, const char *socketPath);
+
+#endif
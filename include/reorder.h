@@ -0,0 +1,30 @@
+#ifndef REORDER_H
+#define REORDER_H
+
+#include "types.h"
+
+/*
+ * @brief Reorder method
+ *
+ * Selects how vertices are relabelled before
+ * traversal to improve memory locality
+ *
+ * @value NO_REORDER => keep the node list order
+ * @value RCM_REORDER => reverse Cuthill-McKee, keeps neighbours close together
+ * @value DEGREE_REORDER => highest degree first, packs the hubs together
+ * @value BFS_REORDER => order a bfs from the first node discovers the vertices in
+ *
+ */
+typedef enum ReorderMethod {
+    NO_REORDER,
+    RCM_REORDER,
+    DEGREE_REORDER,
+    BFS_REORDER
+} ReorderMethod;
+
+const char *getReorderMethodName(ReorderMethod method);
+VertexId *computeVertexOrder(const Graph *graph, ReorderMethod method);
+void reorderGraph(Graph *graph, ReorderMethod method);
+VertexId getListedVertex(const Graph *graph, VertexId position);
+
+#endif
@@ -0,0 +1,81 @@
+#ifndef SHORTEST_PATH_H
+#define SHORTEST_PATH_H
+
+#include <stddef.h>
+#include <limits.h>
+#include "types.h"
+
+/*
+ * @brief Distance of a vertex the bfs did not reach
+ */
+#define UNREACHED_DISTANCE UINT_MAX
+
+/*
+ * @brief Bfs tree data structure
+ *
+ * BfsTree struct keeps the tree a bfs from
+ * one source builds, so hop paths from the
+ * source can be read back from it
+ *
+ * @member VertexId (source) => root of the tree
+ * @member VertexId pointer [array] (parents) => parent of every vertex, the source is its own
+ *                                               parent, INVALID_VERTEX when not reached
+ * @member unsigned int pointer [array] (distances) => hops from the source, UNREACHED_DISTANCE
+ *                                                     when not reached
+ * @member unsigned int (traversal length) => number of vertices reached
+ *
+ */
+typedef struct BfsTree {
+    VertexId source;
+    VertexId *parents;
+    unsigned int *distances;
+    unsigned int traversalLength;
+} BfsTree;
+
+/*
+ * @brief Path search data structure
+ *
+ * PathSearch struct holds the scratch of a
+ * bidirectional bfs. It is allocated once and
+ * reused by every query, and a query only resets
+ * the entries it touched
+ *
+ * Parents are stored plus one so that zeroed
+ * memory reads as unvisited, which lets the arrays
+ * come straight from calloc without touching them
+ *
+ * @member Graph (pointer*) => graph being searched
+ * @member size_t pointer [array] (backward offsets) => rows followed from the goal
+ * @member VertexId pointer [array] (backward nodes) => incoming edges, or outgoing ones if undirected
+ * @member VertexId pointer [array] (forward parents) => parent + 1 on the side of the start
+ * @member VertexId pointer [array] (backward parents) => parent + 1 on the side of the goal
+ * @member VertexId pointer [array] (forward queue) => vertices reached from the start
+ * @member VertexId pointer [array] (backward queue) => vertices reached from the goal
+ * @member unsigned int (forward length) => used part of the forward queue
+ * @member unsigned int (backward length) => used part of the backward queue
+ * @member size_t (vertices visited) => vertices the last query reached
+ * @member size_t (edges examined) => edges the last query scanned
+ *
+ */
+typedef struct PathSearch {
+    const Graph *graph;
+    const size_t *backwardOffsets;
+    const VertexId *backwardNodes;
+    VertexId *forwardParents;
+    VertexId *backwardParents;
+    VertexId *forwardQueue;
+    VertexId *backwardQueue;
+    unsigned int forwardLength;
+    unsigned int backwardLength;
+    size_t verticesVisited;
+    size_t edgesExamined;
+} PathSearch;
+
+void computeBfsTree(const Graph *graph, VertexId source, BfsTree *tree);
+unsigned int getTreePath(const BfsTree *tree, VertexId target, VertexId *path);
+void freeBfsTree(BfsTree *tree);
+void initPathSearch(PathSearch *search, Graph *graph);
+unsigned int findShortestPath(PathSearch *search, VertexId start, VertexId goal, VertexId *path);
+void freePathSearch(PathSearch *search);
+
+#endif
@@ -0,0 +1,46 @@
+#ifndef SIMPLIFY_GRAPH_H
+#define SIMPLIFY_GRAPH_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "types.h"
+
+/*
+ * @brief Multi-edge policy
+ *
+ * Selects what becomes of the edges a row holds
+ * more than once when the graph is simplified
+ *
+ * @value KEEP_MULTI_EDGES => keep every copy, only sort the rows
+ * @value KEEP_FIRST_EDGE => keep the copy listed first in the graph file
+ * @value KEEP_MIN_WEIGHT => keep one copy with the smallest weight
+ * @value SUM_WEIGHTS => keep one copy weighing as much as all of them
+ *
+ */
+typedef enum MultiEdgePolicy {
+    KEEP_MULTI_EDGES,
+    KEEP_FIRST_EDGE,
+    KEEP_MIN_WEIGHT,
+    SUM_WEIGHTS
+} MultiEdgePolicy;
+
+/*
+ * @brief Simplify stats data structure
+ *
+ * SimplifyStats struct counts the edges of the
+ * graph file a simplification removed, an
+ * undirected edge counts once for both directions
+ *
+ * @member size_t (duplicates removed) => copies merged into another edge
+ * @member size_t (self loops removed) => edges from a vertex to itself
+ *
+ */
+typedef struct SimplifyStats {
+    size_t duplicatesRemoved;
+    size_t selfLoopsRemoved;
+} SimplifyStats;
+
+void simplifyGraph(Graph *graph, MultiEdgePolicy policy, bool dropSelfLoops, SimplifyStats *stats);
+bool hasEdge(const Graph *graph, VertexId from, VertexId to, unsigned int *weight);
+
+#endif
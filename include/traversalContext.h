@@ -0,0 +1,51 @@
+#ifndef TRAVERSAL_CONTEXT_H
+#define TRAVERSAL_CONTEXT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "types.h"
+#include "bitmap.h"
+
+/*
+ * @brief Traversal context data structure
+ *
+ * TraversalContext struct holds every piece of
+ * state a traversal writes to, so traversals on
+ * separate contexts can run at once against one
+ * shared graph. It is created once and reused,
+ * and resetting it does not touch every vertex
+ *
+ * The top-down kernel marks a vertex visited by
+ * stamping it with the current epoch, so a reset
+ * only moves to the next epoch. Stamps are a byte
+ * wide, which keeps them about as cache friendly as
+ * a bitmap and means they are wiped once every 255
+ * resets. The other kernels need a bitmap, which a
+ * reset clears bit by bit along the last traversal path
+ *
+ * @member unsigned int (number of nodes) => vertices the context has room for
+ * @member unsigned char pointer [array] (visit marks) => epoch a vertex was last visited in
+ * @member unsigned char (epoch) => stamp of the current traversal, never 0
+ * @member Bitmap (visited) => visited bits of the bitmap based kernels
+ * @member bool (bitmap in use) => visited holds the bits of the last traversal
+ * @member VertexId pointer [array] (traversal path) => path of the last traversal, doubling as the queue
+ * @member unsigned int (traversal length) => vertices on the path of the last traversal
+ * @member VertexId pointer [array] (unreachable nodes) => nodes the last traversal missed
+ *
+ */
+typedef struct TraversalContext {
+    unsigned int noOfNodes;
+    unsigned char *visitMarks;
+    unsigned char epoch;
+    Bitmap visited;
+    bool bitmapInUse;
+    VertexId *traversalPath;
+    unsigned int traversalLength;
+    VertexId *unReachableNodes;
+} TraversalContext;
+
+void initTraversalContext(TraversalContext *context, unsigned int noOfNodes);
+void resetTraversalContext(TraversalContext *context);
+void freeTraversalContext(TraversalContext *context);
+
+#endif
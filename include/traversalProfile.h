@@ -0,0 +1,140 @@
+#ifndef TRAVERSAL_PROFILE_H
+#define TRAVERSAL_PROFILE_H
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * @brief Level profile data structure
+ *
+ * LevelProfile struct holds what one bfs level cost
+ *
+ * @member size_t (frontier size) => vertices expanded by the level
+ * @member size_t (edges examined) => edges scanned by the level
+ * @member size_t (newly visited) => vertices the level added to the path
+ * @member double (seconds) => wall time of the level
+ * @member uint64_t (cache misses) => hardware counter, when enabled
+ * @member uint64_t (branch misses) => hardware counter, when enabled
+ * @member bool (bottom up) => level ran as a bottom-up step
+ *
+ */
+typedef struct LevelProfile {
+    size_t frontierSize;
+    size_t edgesExamined;
+    size_t newlyVisited;
+    double seconds;
+    uint64_t cacheMisses;
+    uint64_t branchMisses;
+    bool bottomUp;
+} LevelProfile;
+
+/*
+ * @brief Traversal profile data structure
+ *
+ * TraversalProfile struct collects one LevelProfile
+ * per level. Kernels only reach it through the
+ * PROFILE_ macros below
+ *
+ * @member LevelProfile pointer [array] (levels) => finished and current levels
+ * @member unsigned int (number of levels) => levels recorded so far
+ * @member unsigned int (capacity) => levels that fit before growing
+ * @member bool (counters enabled) => hardware counters could be opened
+ * @member int (cache misses fd) => perf event of the cache miss counter
+ * @member int (branch misses fd) => perf event of the branch miss counter
+ * @member double (level start) => clock when the current level started
+ * @member size_t (level edges) => edges examined before the current level
+ * @member size_t (level visited) => vertices visited before the current level
+ * @member uint64_t (level cache misses) => counter when the current level started
+ * @member uint64_t (level branch misses) => counter when the current level started
+ * @member size_t (next queue level) => queue index where the next level starts
+ *
+ */
+typedef struct TraversalProfile {
+    LevelProfile *levels;
+    unsigned int noOfLevels;
+    unsigned int capacity;
+    bool countersEnabled;
+    int cacheMissesFd;
+    int branchMissesFd;
+    double levelStart;
+    size_t levelEdges;
+    size_t levelVisited;
+    uint64_t levelCacheMisses;
+    uint64_t levelBranchMisses;
+    size_t nextQueueLevel;
+} TraversalProfile;
+
+/*
+ * @brief Level hooks for the bfs kernels
+ *
+ * Built with BFS_INSTRUMENTATION (make INSTRUMENT=1)
+ * the hooks record a level whenever a profile is set.
+ * Without it they expand to nothing, so the kernels
+ * compile exactly as if the hooks were not there
+ *
+ * PROFILE_LEVEL => a level starts with the given frontier
+ * PROFILE_QUEUE_LEVEL => same, for queue based kernels; starts a level
+ *                        when the queue front reaches the end of the last one
+ * PROFILE_FINISH => the traversal is over, closes the last level
+ *
+ */
+#ifdef BFS_INSTRUMENTATION
+#define PROFILE_LEVEL(profile, frontierSize, edgesExamined, visitedCount, bottomUp) \
+    do \
+    { \
+        if ((profile) != NULL) \
+        { \
+            markProfileLevel((profile), (frontierSize), (edgesExamined), (visitedCount), (bottomUp)); \
+        } \
+    } while (0)
+#define PROFILE_QUEUE_LEVEL(profile, queueFront, queueLength, edgesExamined) \
+    do \
+    { \
+        if ((profile) != NULL && (size_t)(queueFront) == (profile)->nextQueueLevel) \
+        { \
+            markProfileLevel \
+            ( \
+                (profile), (size_t)(queueLength) - (size_t)(queueFront), \
+                (edgesExamined), (queueLength), false \
+            ); \
+            (profile)->nextQueueLevel = (size_t)(queueLength); \
+        } \
+    } while (0)
+#define PROFILE_FINISH(profile, edgesExamined, visitedCount) \
+    do \
+    { \
+        if ((profile) != NULL) \
+        { \
+            finishProfile((profile), (edgesExamined), (visitedCount)); \
+        } \
+    } while (0)
+#else
+#define PROFILE_LEVEL(profile, frontierSize, edgesExamined, visitedCount, bottomUp) ((void)(profile))
+#define PROFILE_QUEUE_LEVEL(profile, queueFront, queueLength, edgesExamined) ((void)(profile))
+#define PROFILE_FINISH(profile, edgesExamined, visitedCount) ((void)(profile))
+#endif
+
+double readClock(void);
+void startProfile(TraversalProfile *profile, bool useCounters);
+void markProfileLevel
+(
+    TraversalProfile *profile,
+    size_t frontierSize,
+    size_t edgesExamined,
+    size_t visitedCount,
+    bool bottomUp
+);
+void finishProfile(TraversalProfile *profile, size_t edgesExamined, size_t visitedCount);
+void writeProfileJson
+(
+    const TraversalProfile *profile,
+    FILE *output,
+    const char *modeName,
+    unsigned int noOfNodes,
+    size_t noOfEdges
+);
+void freeProfile(TraversalProfile *profile);
+
+#endif
@@ -2,24 +2,84 @@
 #define TYPES_H
 
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "arena.h"
 
 /*
- * @brief Graph Node data structure
+ * @brief Vertex identifier
  *
- * GraphNode struct is used when building the
- * adjacency list. It keeps track of nearby vertex
- * from a particular node
+ * Dense internal index of a vertex. External
+ * names are mapped to these identifiers when the
+ * graph is loaded and mapped back only for output
+ *
+ */
+typedef uint32_t VertexId;
+
+/*
+ * @brief Invalid vertex identifier
+ *
+ * Marks an empty slot or a name that
+ * could not be found
+ *
+ */
+#define INVALID_VERTEX ((VertexId)UINT32_MAX)
+
+/*
+ * @brief Vertex dictionary data structure
+ *
+ * VertexDictionary struct interns the external
+ * names of vertices. Names are stored back to back
+ * in a single pool and looked up through an open
+ * addressing hash table
+ * 
+ * @member VertexId (number of names) => number of interned names
+ * @member VertexId (name capacity) => number of names that fit before growing
+ * @member size_t pointer [array] (name offsets) => start of each name in the pool
+ * @member char pointer [array] (name pool) => null terminated names back to back
+ * @member size_t (name pool length) => bytes used in the name pool
+ * @member size_t (name pool capacity) => bytes allocated for the name pool
+ * @member VertexId pointer [array] (slots) => hash table of vertex identifiers
+ * @member size_t (slot count) => size of the hash table (power of two)
+ *
+ */
+typedef struct VertexDictionary {
+    VertexId noOfNames;
+    VertexId nameCapacity;
+    size_t *nameOffsets;
+    char *namePool;
+    size_t namePoolLength;
+    size_t namePoolCapacity;
+    VertexId *slots;
+    size_t slotCount;
+} VertexDictionary;
+
+/*
+ * @brief Compressed adjacency data structure
+ *
+ * CompressedAdjacency struct stores the rows of a
+ * graph as byte aligned varints. A row lists its
+ * neighbours in ascending order, the first as the
+ * zigzag encoded difference to the vertex itself and
+ * every other one as the gap to the previous one
+ * 
+ * Weights are kept in a second stream in the same
+ * order, unless every edge has the same weight
  * 
- * @member char (name of node) => stores name of a node
- * @member unsigned int (weight) => stores the weight of a edge
- * @member GraphNode (next pointer*) =>  stores pointer to next vertex
+ * @member size_t pointer [array] (row offsets) => start byte of each vertex's row
+ * @member uint8_t pointer [array] (rows) => encoded neighbours of every vertex back to back
+ * @member size_t pointer [array] (weight offsets) => start byte of each vertex's weights, NULL if uniform
+ * @member uint8_t pointer [array] (weights) => encoded weights, NULL if uniform
+ * @member unsigned int (uniform weight) => weight of every edge when weights is NULL
  *
  */
-typedef struct GraphNode {
-    char nodeName;
-    unsigned int weight;
-    struct GraphNode *next;
-} GraphNode;
+typedef struct CompressedAdjacency {
+    size_t *rowOffsets;
+    uint8_t *rows;
+    size_t *weightOffsets;
+    uint8_t *weights;
+    unsigned int uniformWeight;
+} CompressedAdjacency;
 
 /*
  * @brief Graph data structure
@@ -28,18 +88,74 @@ typedef struct GraphNode {
  * overall structure and additional notes 
  * of the deciphered graph 
  * 
+ * The adjacency is stored in compressed sparse
+ * row form. Neighbours of vertex i are stored in
+ * adjacentNodes[edgeOffsets[i]] up to (but not including)
+ * adjacentNodes[edgeOffsets[i + 1]] with the matching
+ * weights in edgeWeights
+ * 
+ * The incoming arrays hold the transposed adjacency in
+ * the same layout, along with the position of each edge
+ * in its source's outgoing row. They are only built for
+ * traversals that need them
+ * 
+ * A graph opened from a binary snapshot points its
+ * adjacency and dictionary arrays straight into the
+ * read only mapping of the snapshot file
+ * 
+ * Every other array of the graph (the dictionary
+ * aside) is carved out of the graph's arena, so
+ * freeing the graph releases a few large blocks
+ * 
+ * A reordered graph has its vertices relabelled for
+ * locality. vertexOrder then maps each position of
+ * the node list to the vertex now holding that node,
+ * so output can still follow the node list
+ * 
+ * A compressed graph keeps its adjacency only in
+ * compressed form, the edge arrays are then NULL
+ * 
+ * A simplified graph has every row in ascending
+ * neighbour order, so edges can be looked up with
+ * a binary search
+ * 
  * @member unsigned int (number of nodes) => Total number of nodes in the graph
+ * @member size_t (number of edges) => Total number of stored (directed) edges
  * @member unsigned int (total weight) => total weight of graph
  * @member bool (directed) => Stores whether a graph is directed or undirected
- * @member GraphNode [2d array] (pointer to pointer*) =>  stores the adjacency list
+ * @member VertexDictionary (dictionary) => maps node names to vertex identifiers
+ * @member size_t pointer [array] (edge offsets) => stores start of each vertex's row
+ * @member VertexId pointer [array] (adjacent nodes) => stores neighbour identifiers
+ * @member unsigned int pointer [array] (edge weights) => stores weight of each edge
+ * @member size_t pointer [array] (incoming offsets) => start of each vertex's incoming row
+ * @member VertexId pointer [array] (incoming nodes) => stores predecessor identifiers
+ * @member unsigned int pointer [array] (incoming positions) => stores edge position in the predecessor's row
+ * @member void pointer (snapshot mapping) => mapping backing the arrays, NULL if heap allocated
+ * @member size_t (snapshot length) => length of the snapshot mapping
+ * @member VertexId pointer [array] (vertex order) => vertex of every node list position, NULL if not reordered
+ * @member CompressedAdjacency (pointer*) => compressed rows, NULL unless compressed
+ * @member bool (sorted rows) => every row lists its neighbours in ascending order
+ * @member Arena (arena) => owns the adjacency and incoming arrays
  *
  */
 typedef struct Graph {
     unsigned int noOfNodes;
+    size_t noOfEdges;
     unsigned int totalWeight;
     bool directed;
-    char *nodeList;
-    GraphNode **adjacentLists;
+    VertexDictionary dictionary;
+    size_t *edgeOffsets;
+    VertexId *adjacentNodes;
+    unsigned int *edgeWeights;
+    size_t *incomingOffsets;
+    VertexId *incomingNodes;
+    unsigned int *incomingPositions;
+    void *snapshotMapping;
+    size_t snapshotLength;
+    VertexId *vertexOrder;
+    CompressedAdjacency *compressed;
+    bool sortedRows;
+    Arena arena;
 } Graph;
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,13 @@
+#ifndef VERTEX_DICTIONARY_H
+#define VERTEX_DICTIONARY_H
+
+#include <stddef.h>
+#include "types.h"
+
+void initVertexDictionary(VertexDictionary *dictionary, VertexId expectedNames);
+VertexId internVertexName(VertexDictionary *dictionary, const char *name, size_t length);
+VertexId findVertexId(const VertexDictionary *dictionary, const char *name, size_t length);
+const char *getVertexName(const VertexDictionary *dictionary, VertexId vertex);
+void freeVertexDictionary(VertexDictionary *dictionary);
+
+#endif
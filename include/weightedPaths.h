@@ -0,0 +1,54 @@
+#ifndef WEIGHTED_PATHS_H
+#define WEIGHTED_PATHS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "types.h"
+
+/*
+ * @brief Distance of a vertex that cannot be reached
+ */
+#define INFINITE_DISTANCE UINT64_MAX
+
+/*
+ * @brief Weighted paths data structure
+ *
+ * WeightedPaths struct holds the result of a single
+ * source shortest path search over the edge weights
+ *
+ * Predecessors are chosen from the final distances,
+ * so every engine gives the same tree. Among equally
+ * short paths the predecessor is the smallest vertex
+ * identifier reaching it over a positive weight edge.
+ * A vertex only reached over zero weight edges takes
+ * the smallest identifier among those fewest zero
+ * weight edges away from such a vertex
+ *
+ * @member VertexId (source) => vertex the distances are measured from
+ * @member uint64_t pointer [array] (distances) => total weight of the shortest path,
+ *                                                INFINITE_DISTANCE when unreachable
+ * @member VertexId pointer [array] (predecessors) => previous vertex on the shortest path,
+ *                                                   the source is its own, INVALID_VERTEX when unreachable
+ * @member size_t (edges examined) => edges relaxed by the search
+ *
+ */
+typedef struct WeightedPaths {
+    VertexId source;
+    uint64_t *distances;
+    VertexId *predecessors;
+    size_t edgesExamined;
+} WeightedPaths;
+
+void dijkstraShortestPaths(const Graph *graph, VertexId source, WeightedPaths *paths);
+uint64_t getDefaultDelta(const Graph *graph);
+void deltaSteppingShortestPaths
+(
+    const Graph *graph,
+    VertexId source,
+    unsigned int noOfThreads,
+    uint64_t delta,
+    WeightedPaths *paths
+);
+void freeWeightedPaths(WeightedPaths *paths);
+
+#endif
@@ -0,0 +1,48 @@
+#ifndef WORKER_THREADS_H
+#define WORKER_THREADS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <pthread.h>
+
+/*
+ * @brief Threads allowed per online core
+ *
+ * Requests above it only add contention
+ * and can run out of thread resources
+ *
+ */
+#define THREADS_PER_CORE 4
+
+/*
+ * @brief Worker launch data structure
+ *
+ * WorkerLaunch struct holds workers back until
+ * every one of them was created, so a failed
+ * launch can stop the ones already running before
+ * they wait on a barrier sized for all of them
+ *
+ * @member pthread_mutex_t (lock) => held while the workers are created
+ * @member bool (aborted) => set when a worker could not be created
+ *
+ */
+typedef struct WorkerLaunch {
+    pthread_mutex_t lock;
+    bool aborted;
+} WorkerLaunch;
+
+unsigned int getMaxThreadCount(void);
+unsigned int resolveThreadCount(unsigned int requestedThreads);
+void startWorkers
+(
+    WorkerLaunch *launch,
+    pthread_t *threads,
+    unsigned int noOfWorkers,
+    void *(*worker)(void *),
+    void *arguments,
+    size_t argumentSize
+);
+bool enterWorker(WorkerLaunch *launch);
+void joinWorkers(WorkerLaunch *launch, pthread_t *threads, unsigned int noOfWorkers);
+
+#endif
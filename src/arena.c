@@ -0,0 +1,164 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "arena.h"
+
+/*
+ * @brief declarations for internal functions
+ *
+ * List of static functions local to this file
+ * Meant to be used in this file only
+ * 
+ * @note all internal functions are static
+ */
+static void *takeFromBlock(ArenaBlock *block, size_t size);
+static ArenaBlock *addBlock(Arena *arena, size_t size);
+
+/*
+ * @brief Initialize arena struct
+ * 
+ * No memory is reserved until the
+ * first allocation
+ * 
+ * @param Arena (pointer*)
+ * @return void
+ * 
+ */
+void initArena(Arena *arena)
+{
+    arena->blocks = NULL;
+    arena->bytesReserved = 0;
+}
+
+/*
+ * @brief Bump allocate from a block
+ * 
+ * @param ArenaBlock (pointer*)
+ * @param size_t (size in bytes)
+ * @return void pointer (NULL if the block is too full)
+ * 
+ */
+static void *takeFromBlock(ArenaBlock *block, size_t size)
+{
+    uintptr_t base = (uintptr_t)block->data;
+    uintptr_t start = (base + block->used + ARENA_ALIGNMENT - 1) & ~(uintptr_t)(ARENA_ALIGNMENT - 1);
+
+    if (start - base > block->capacity || size > block->capacity - (start - base))
+    {
+        return NULL;
+    }
+
+    block->used = start - base + size;
+
+    return (void *)start;
+}
+
+/*
+ * @brief Add a block to the arena
+ * 
+ * A block sized for a single large request is linked
+ * behind the current block, so the space left in the
+ * current block is still used by later small requests
+ * 
+ * @param Arena (pointer*)
+ * @param size_t (size of the request in bytes)
+ * @return ArenaBlock (pointer*)
+ * 
+ */
+static ArenaBlock *addBlock(Arena *arena, size_t size)
+{
+    bool oversized = size > ARENA_BLOCK_SIZE - ARENA_ALIGNMENT;
+    size_t capacity = oversized ? size + ARENA_ALIGNMENT : ARENA_BLOCK_SIZE;
+
+    ArenaBlock *block = (ArenaBlock *)malloc(sizeof(ArenaBlock) + capacity);
+
+    if (block == NULL)
+    {
+        perror("Failed to allocate memory\n");
+        exit(EXIT_FAILURE);
+    }
+
+    block->capacity = capacity;
+    block->used = 0;
+
+    if (oversized && arena->blocks != NULL)
+    {
+        block->next = arena->blocks->next;
+        arena->blocks->next = block;
+    }
+    else
+    {
+        block->next = arena->blocks;
+        arena->blocks = block;
+    }
+
+    arena->bytesReserved += capacity;
+
+    return block;
+}
+
+/*
+ * @brief Allocate memory from the arena
+ * 
+ * @param Arena (pointer*)
+ * @param size_t (size in bytes)
+ * @return void pointer (aligned to ARENA_ALIGNMENT)
+ * 
+ * @note The memory lives until freeArena
+ * 
+ */
+void *arenaAllocate(Arena *arena, size_t size)
+{
+    if (arena->blocks != NULL)
+    {
+        void *memory = takeFromBlock(arena->blocks, size);
+
+        if (memory != NULL)
+        {
+            return memory;
+        }
+    }
+
+    return takeFromBlock(addBlock(arena, size), size);
+}
+
+/*
+ * @brief Allocate zeroed memory from the arena
+ * 
+ * @param Arena (pointer*)
+ * @param size_t (size in bytes)
+ * @return void pointer (aligned to ARENA_ALIGNMENT)
+ * 
+ */
+void *arenaAllocateZeroed(Arena *arena, size_t size)
+{
+    void *memory = arenaAllocate(arena, size);
+    memset(memory, 0, size);
+
+    return memory;
+}
+
+/*
+ * @brief Free every block of the arena
+ * 
+ * @param Arena (pointer*)
+ * @return void
+ * 
+ * @note Leaves the arena empty and ready for reuse
+ * 
+ */
+void freeArena(Arena *arena)
+{
+    ArenaBlock *block = arena->blocks;
+
+    while (block != NULL)
+    {
+        ArenaBlock *next = block->next;
+        free(block);
+        block = next;
+    }
+
+    initArena(arena);
+}
@@ -0,0 +1,42 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "bfsVisitor.h"
+
+/*
+ * @brief Report a finished level to a visitor
+ * 
+ * @param BfsVisitor (pointer*) => may be NULL
+ * @param VertexId pointer [array] (traversal path)
+ * @param unsigned int (level start) => first path index of the level
+ * @param unsigned int (level end) => path index past the level
+ * @param unsigned int (level) => distance from the source
+ * @return void
+ * 
+ */
+void visitLevel
+(
+    const BfsVisitor *visitor,
+    const VertexId *traversalPath,
+    unsigned int levelStart,
+    unsigned int levelEnd,
+    unsigned int level
+)
+{
+    if (visitor == NULL)
+    {
+        return;
+    }
+
+    if (visitor->onDiscover != NULL)
+    {
+        for (unsigned int index = levelStart; index < levelEnd; index++)
+        {
+            visitor->onDiscover(traversalPath[index], level, visitor->context);
+        }
+    }
+
+    if (visitor->onLevelEnd != NULL)
+    {
+        visitor->onLevelEnd(level, levelEnd - levelStart, visitor->context);
+    }
+}
@@ -0,0 +1,115 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bitmap.h"
+
+/*
+ * @brief Initialize bitmap struct
+ * 
+ * Allocates enough words for the bits
+ * with every bit cleared
+ * 
+ * @param Bitmap (pointer*)
+ * @param size_t (number of bits)
+ * @return void
+ * 
+ */
+void initBitmap(Bitmap *bitmap, size_t noOfBits)
+{
+    bitmap->noOfBits = noOfBits;
+    bitmap->noOfWords = (noOfBits + BITMAP_WORD_BITS - 1) / BITMAP_WORD_BITS;
+    bitmap->words = (uint64_t *)calloc(bitmap->noOfWords + 1, sizeof(uint64_t));
+
+    if (bitmap->words == NULL)
+    {
+        perror("Failed to allocate memory\n");
+        exit(EXIT_FAILURE);
+    }
+}
+
+/*
+ * @brief Clear every bit of a bitmap
+ * 
+ * @param Bitmap (pointer*)
+ * @return void
+ * 
+ */
+void clearBitmap(Bitmap *bitmap)
+{
+    memset(bitmap->words, 0, bitmap->noOfWords * sizeof(uint64_t));
+}
+
+/*
+ * @brief Count set bits
+ * 
+ * Population count a word at a time
+ * 
+ * @param Bitmap (pointer*)
+ * @return size_t
+ * 
+ */
+size_t countSetBits(const Bitmap *bitmap)
+{
+    size_t count = 0;
+
+    for (size_t index = 0; index < bitmap->noOfWords; index++)
+    {
+        count += (size_t)__builtin_popcountll(bitmap->words[index]);
+    }
+
+    return count;
+}
+
+/*
+ * @brief Collect the clear bits
+ *
+ * Scans a word at a time and picks the clear
+ * bits out with count trailing zeros, in
+ * ascending order
+ *
+ * @param Bitmap (pointer*)
+ * @param uint32_t pointer [array] (bits) => receives the clear bit indexes
+ * @return size_t (number of clear bits)
+ *
+ */
+size_t collectClearBits(const Bitmap *bitmap, uint32_t *bits)
+{
+    size_t noOfClearBits = 0;
+
+    for (size_t wordIndex = 0; wordIndex < bitmap->noOfWords; wordIndex++)
+    {
+        uint64_t clearBits = ~bitmap->words[wordIndex];
+
+        // ignore padding bits past the last usable bit
+        if ((wordIndex + 1) * BITMAP_WORD_BITS > bitmap->noOfBits)
+        {
+            unsigned int usedBits = bitmap->noOfBits % BITMAP_WORD_BITS;
+            clearBits &= ((uint64_t)1 << usedBits) - 1;
+        }
+
+        while (clearBits != 0)
+        {
+            unsigned int bit = (unsigned int)__builtin_ctzll(clearBits);
+
+            bits[noOfClearBits++] = (uint32_t)(wordIndex * BITMAP_WORD_BITS + bit);
+            clearBits &= clearBits - 1; // drop lowest set bit
+        }
+    }
+
+    return noOfClearBits;
+}
+
+/*
+ * @brief Free bitmap
+ * 
+ * @param Bitmap (pointer*)
+ * @return void
+ * 
+ */
+void freeBitmap(Bitmap *bitmap)
+{
+    free(bitmap->words);
+    bitmap->words = NULL;
+    bitmap->noOfWords = 0;
+    bitmap->noOfBits = 0;
+}
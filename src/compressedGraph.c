@@ -0,0 +1,336 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include "compressedGraph.h"
+#include "arena.h"
+#include "graphBuilder.h"
+#include "types.h"
+
+// a 64 bit value never takes more than ten varint bytes
+#define MAX_VARINT_BYTES 10
+
+/*
+ * @brief Byte buffer data structure
+ *
+ * ByteBuffer struct collects an encoded stream
+ * whose final length is only known at the end
+ *
+ * @member uint8_t pointer [array] (bytes)
+ * @member size_t (length) => bytes written so far
+ * @member size_t (capacity) => bytes that fit before growing
+ *
+ */
+typedef struct ByteBuffer {
+    uint8_t *bytes;
+    size_t length;
+    size_t capacity;
+} ByteBuffer;
+
+/*
+ * @brief declarations for internal functions
+ *
+ * List of static functions local to this file
+ * Meant to be used in this file only
+ *
+ * @note all internal functions are static
+ */
+static void reserveBytes(ByteBuffer *buffer, size_t extra);
+static void writeVarint(ByteBuffer *buffer, uint64_t value);
+static uint8_t *copyToArena(Arena *arena, const ByteBuffer *buffer);
+
+/*
+ * @brief Make room in a byte buffer
+ *
+ * @param ByteBuffer (pointer*)
+ * @param size_t (extra bytes needed)
+ * @return void
+ *
+ */
+static void reserveBytes(ByteBuffer *buffer, size_t extra)
+{
+    if (buffer->length + extra <= buffer->capacity)
+    {
+        return;
+    }
+
+    size_t capacity = buffer->capacity == 0 ? 4096 : buffer->capacity * 2;
+
+    while (capacity < buffer->length + extra)
+    {
+        capacity *= 2;
+    }
+
+    uint8_t *bytes = (uint8_t *)realloc(buffer->bytes, capacity);
+
+    if (bytes == NULL)
+    {
+        perror("Failed to allocate memory\n");
+        exit(EXIT_FAILURE);
+    }
+
+    buffer->bytes = bytes;
+    buffer->capacity = capacity;
+}
+
+/*
+ * @brief Append one varint
+ *
+ * @param ByteBuffer (pointer*) => room for MAX_VARINT_BYTES reserved
+ * @param uint64_t (value)
+ * @return void
+ *
+ */
+static void writeVarint(ByteBuffer *buffer, uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        buffer->bytes[buffer->length++] = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+
+    buffer->bytes[buffer->length++] = (uint8_t)value;
+}
+
+/*
+ * @brief Copy a finished stream into an arena
+ *
+ * @param Arena (pointer*)
+ * @param ByteBuffer (pointer*)
+ * @return uint8_t pointer [array]
+ *
+ */
+static uint8_t *copyToArena(Arena *arena, const ByteBuffer *buffer)
+{
+    uint8_t *bytes = (uint8_t *)arenaAllocate(arena, buffer->length);
+
+    if (buffer->length > 0)
+    {
+        memcpy(bytes, buffer->bytes, buffer->length);
+    }
+
+    return bytes;
+}
+
+/*
+ * @brief Compress the adjacency of a graph
+ *
+ * Every row is sorted and written as varint gaps,
+ * which takes one byte for most edges of a graph
+ * whose neighbours have nearby ids. Weights get a
+ * stream of their own only when they differ. The
+ * edge arrays are released once the rows are
+ * encoded, only top-down traversals run afterwards
+ *
+ * @param Graph (pointer*)
+ * @return void
+ *
+ * @note Compressing a compressed graph does nothing
+ *
+ */
+void compressGraph(Graph *graph)
+{
+    if (graph->compressed != NULL)
+    {
+        return;
+    }
+
+    unsigned int noOfNodes = graph->noOfNodes;
+    size_t maxDegree = 0;
+    bool uniform = true;
+    unsigned int uniformWeight = graph->noOfEdges > 0 ? graph->edgeWeights[0] : 0;
+
+    for (VertexId vertex = 0; vertex < noOfNodes; vertex++)
+    {
+        size_t degree = graph->edgeOffsets[vertex + 1] - graph->edgeOffsets[vertex];
+        maxDegree = degree > maxDegree ? degree : maxDegree;
+    }
+
+    for (size_t edge = 0; edge < graph->noOfEdges && uniform; edge++)
+    {
+        uniform = graph->edgeWeights[edge] == uniformWeight;
+    }
+
+    uint64_t *keys = (uint64_t *)malloc((maxDegree + 1) * sizeof(uint64_t));
+
+    if (keys == NULL)
+    {
+        perror("Failed to allocate memory\n");
+        exit(EXIT_FAILURE);
+    }
+
+    Arena arena;
+    initArena(&arena);
+
+    CompressedAdjacency *compressed = (CompressedAdjacency *)arenaAllocate(&arena, sizeof(CompressedAdjacency));
+    compressed->rowOffsets = (size_t *)arenaAllocate(&arena, ((size_t)noOfNodes + 1) * sizeof(size_t));
+    compressed->weightOffsets = uniform
+        ? NULL : (size_t *)arenaAllocate(&arena, ((size_t)noOfNodes + 1) * sizeof(size_t));
+    compressed->uniformWeight = uniform ? uniformWeight : 0;
+
+    ByteBuffer rows = { NULL, 0, 0 };
+    ByteBuffer weights = { NULL, 0, 0 };
+
+    for (VertexId vertex = 0; vertex < noOfNodes; vertex++)
+    {
+        size_t degree = sortRowKeys(graph, vertex, ROW_KEY_WEIGHT, keys);
+        VertexId previous = vertex;
+
+        compressed->rowOffsets[vertex] = rows.length;
+        reserveBytes(&rows, degree * MAX_VARINT_BYTES);
+
+        for (size_t index = 0; index < degree; index++)
+        {
+            VertexId neighbour = (VertexId)(keys[index] >> 32);
+
+            if (index == 0)
+            {
+                // the first neighbour may lie below the vertex, zigzag keeps it small either way
+                int64_t difference = (int64_t)neighbour - (int64_t)vertex;
+                writeVarint(&rows, (uint64_t)difference << 1 ^ (uint64_t)(difference >> 63));
+            }
+            else
+            {
+                writeVarint(&rows, neighbour - previous);
+            }
+
+            previous = neighbour;
+        }
+
+        if (!uniform)
+        {
+            compressed->weightOffsets[vertex] = weights.length;
+            reserveBytes(&weights, degree * MAX_VARINT_BYTES);
+
+            for (size_t index = 0; index < degree; index++)
+            {
+                writeVarint(&weights, (uint32_t)keys[index]);
+            }
+        }
+    }
+
+    compressed->rowOffsets[noOfNodes] = rows.length;
+    compressed->rows = copyToArena(&arena, &rows);
+    compressed->weights = NULL;
+
+    if (!uniform)
+    {
+        compressed->weightOffsets[noOfNodes] = weights.length;
+        compressed->weights = copyToArena(&arena, &weights);
+    }
+
+    free(keys);
+    free(rows.bytes);
+    free(weights.bytes);
+
+    replaceGraphArena(graph, &arena);
+
+    graph->compressed = compressed;
+    graph->edgeOffsets = NULL;
+    graph->adjacentNodes = NULL;
+    graph->edgeWeights = NULL;
+}
+
+/*
+ * @brief Get the bytes the adjacency takes
+ *
+ * Counts the row offsets, neighbours and weights,
+ * in whichever form the graph keeps them
+ *
+ * @param Graph (pointer*)
+ * @return size_t
+ *
+ */
+size_t getAdjacencyBytes(const Graph *graph)
+{
+    size_t offsetBytes = ((size_t)graph->noOfNodes + 1) * sizeof(size_t);
+    const CompressedAdjacency *compressed = graph->compressed;
+
+    if (compressed == NULL)
+    {
+        return offsetBytes + graph->noOfEdges * (sizeof(VertexId) + sizeof(unsigned int));
+    }
+
+    size_t bytes = offsetBytes + compressed->rowOffsets[graph->noOfNodes];
+
+    if (compressed->weights != NULL)
+    {
+        bytes += offsetBytes + compressed->weightOffsets[graph->noOfNodes];
+    }
+
+    return bytes;
+}
+
+/*
+ * @brief Decode the row of a vertex
+ *
+ * Works on compressed and plain graphs alike. A
+ * compressed row comes back in ascending order
+ *
+ * @param Graph (pointer*)
+ * @param VertexId (vertex)
+ * @param VertexId pointer [array] (neighbours) => room for the out degree
+ * @param unsigned int pointer [array] (weights) => room for the out degree, may be NULL
+ * @return size_t (out degree)
+ *
+ */
+size_t decodeCompressedRow
+(
+    const Graph *graph,
+    VertexId vertex,
+    VertexId *neighbours,
+    unsigned int *weights
+)
+{
+    const CompressedAdjacency *compressed = graph->compressed;
+
+    if (compressed == NULL)
+    {
+        size_t rowStart = graph->edgeOffsets[vertex];
+        size_t degree = graph->edgeOffsets[vertex + 1] - rowStart;
+
+        memcpy(neighbours, graph->adjacentNodes + rowStart, degree * sizeof(VertexId));
+
+        if (weights != NULL)
+        {
+            memcpy(weights, graph->edgeWeights + rowStart, degree * sizeof(unsigned int));
+        }
+
+        return degree;
+    }
+
+    const uint8_t *bytes = compressed->rows + compressed->rowOffsets[vertex];
+    const uint8_t *rowEnd = compressed->rows + compressed->rowOffsets[vertex + 1];
+    size_t degree = 0;
+    uint64_t value;
+
+    while (bytes < rowEnd)
+    {
+        bytes = readVarint(bytes, &value);
+        neighbours[degree] = degree == 0
+            ? decodeFirstNeighbour(vertex, value) : neighbours[degree - 1] + (VertexId)value;
+        degree++;
+    }
+
+    if (weights == NULL)
+    {
+        return degree;
+    }
+
+    const uint8_t *weightBytes = compressed->weights == NULL
+        ? NULL : compressed->weights + compressed->weightOffsets[vertex];
+
+    for (size_t index = 0; index < degree; index++)
+    {
+        if (weightBytes == NULL)
+        {
+            weights[index] = compressed->uniformWeight;
+            continue;
+        }
+
+        weightBytes = readVarint(weightBytes, &value);
+        weights[index] = (unsigned int)value;
+    }
+
+    return degree;
+}
@@ -0,0 +1,604 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <pthread.h>
+#include "connectedComponents.h"
+#include "graphBuilder.h"
+#include "parallelBfs.h"
+#include "workerThreads.h"
+#include "reorder.h"
+#include "types.h"
+
+/*
+ * @brief Neighbours of every vertex linked before sampling
+ *
+ * Two rounds already merge most of a large
+ * component in graphs with a giant component
+ *
+ */
+#define NEIGHBOR_ROUNDS 2
+
+/*
+ * @brief Vertices whose component is sampled to find the largest one
+ */
+#define COMPONENT_SAMPLES 1024
+
+/*
+ * @brief Vertices handed to a thread at a time while linking
+ */
+#define LINK_CHUNK 1024
+
+/*
+ * @brief Components state data structure
+ *
+ * ComponentsState struct is shared by every thread
+ * of an Afforest search. Phases are separated by a
+ * barrier, and every linking phase hands out vertices
+ * from its own counter so no reset is needed
+ *
+ * @member Graph (pointer*) => graph being labelled
+ * @member VertexId pointer [array] (parents) => union find forest, roots point to themselves
+ * @member unsigned int pointer [array] (labels) => component number of the roots, then of every vertex
+ * @member unsigned int pointer [array] (root counts) => roots in the range of every thread
+ * @member size_t pointer [array] (edges examined) => edges linked by every thread
+ * @member unsigned int (number of threads) => threads taking part
+ * @member VertexId (largest component) => sampled root the last phase skips
+ * @member size_t [array] (next chunk) => next vertex to hand out, one per linking phase
+ * @member pthread_barrier_t (barrier) => separates the phases
+ * @member WorkerLaunch (launch) => holds the workers until all are created
+ *
+ */
+typedef struct ComponentsState {
+    const Graph *graph;
+    VertexId *parents;
+    unsigned int *labels;
+    unsigned int *rootCounts;
+    size_t *edgesExamined;
+    unsigned int noOfThreads;
+    VertexId largestComponent;
+    size_t nextChunk[NEIGHBOR_ROUNDS + 1];
+    pthread_barrier_t barrier;
+    WorkerLaunch launch;
+} ComponentsState;
+
+/*
+ * @brief Worker argument data structure
+ *
+ * @member ComponentsState (pointer*) => shared state
+ * @member unsigned int (thread index) => picks the thread's vertex range
+ *
+ */
+typedef struct ComponentsWorkerArgument {
+    ComponentsState *state;
+    unsigned int threadIndex;
+} ComponentsWorkerArgument;
+
+/*
+ * @brief declarations for internal functions
+ *
+ * List of static functions local to this file
+ * Meant to be used in this file only
+ *
+ * @note all internal functions are static
+ */
+static void linkVertices(VertexId *parents, VertexId first, VertexId second);
+static void compressRange(VertexId *parents, VertexId rangeStart, VertexId rangeEnd);
+static VertexId sampleLargestComponent(const ComponentsState *state);
+static void linkNeighbors(ComponentsState *state, unsigned int threadIndex, unsigned int round);
+static void linkRemainingEdges(ComponentsState *state, unsigned int threadIndex);
+static void numberRoots(ComponentsState *state, unsigned int threadIndex, VertexId rangeStart, VertexId rangeEnd);
+static void *componentsWorker(void *argument);
+static void renumberInListOrder(const Graph *graph, Components *components);
+
+/*
+ * @brief Join the trees of two vertices
+ *
+ * The larger root is hooked under the smaller one
+ * with a compare and swap, retrying on the new roots
+ * when another thread got there first. Roots are
+ * therefore always the smallest vertex of their tree
+ *
+ * @param VertexId pointer [array] (parents)
+ * @param VertexId (first vertex)
+ * @param VertexId (second vertex)
+ * @return void
+ *
+ */
+static void linkVertices(VertexId *parents, VertexId first, VertexId second)
+{
+    VertexId firstParent = __atomic_load_n(&parents[first], __ATOMIC_RELAXED);
+    VertexId secondParent = __atomic_load_n(&parents[second], __ATOMIC_RELAXED);
+
+    while (firstParent != secondParent)
+    {
+        VertexId high = firstParent > secondParent ? firstParent : secondParent;
+        VertexId low = firstParent + secondParent - high;
+        VertexId highParent = __atomic_load_n(&parents[high], __ATOMIC_RELAXED);
+
+        if (highParent == low)
+        {
+            return;
+        }
+
+        if
+        (
+            highParent == high &&
+            __atomic_compare_exchange_n(&parents[high], &highParent, low, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED)
+        )
+        {
+            return;
+        }
+
+        firstParent = __atomic_load_n(&parents[__atomic_load_n(&parents[high], __ATOMIC_RELAXED)], __ATOMIC_RELAXED);
+        secondParent = __atomic_load_n(&parents[low], __ATOMIC_RELAXED);
+    }
+}
+
+/*
+ * @brief Point every vertex of a range at its root
+ *
+ * @param VertexId pointer [array] (parents)
+ * @param VertexId (range start)
+ * @param VertexId (range end)
+ * @return void
+ *
+ */
+static void compressRange(VertexId *parents, VertexId rangeStart, VertexId rangeEnd)
+{
+    for (VertexId vertex = rangeStart; vertex < rangeEnd; vertex++)
+    {
+        VertexId parent = __atomic_load_n(&parents[vertex], __ATOMIC_RELAXED);
+        VertexId grandParent = __atomic_load_n(&parents[parent], __ATOMIC_RELAXED);
+
+        while (parent != grandParent)
+        {
+            parent = grandParent;
+            grandParent = __atomic_load_n(&parents[parent], __ATOMIC_RELAXED);
+        }
+
+        __atomic_store_n(&parents[vertex], parent, __ATOMIC_RELAXED);
+    }
+}
+
+/*
+ * @brief Guess the largest component from a sample of vertices
+ *
+ * Run by a single thread between barriers. Uses a
+ * fixed xorshift sequence so runs are repeatable
+ *
+ * @param ComponentsState (pointer*)
+ * @return VertexId (most frequent root in the sample)
+ *
+ */
+static VertexId sampleLargestComponent(const ComponentsState *state)
+{
+    unsigned int noOfNodes = state->graph->noOfNodes;
+    VertexId samples[COMPONENT_SAMPLES];
+    unsigned int counts[COMPONENT_SAMPLES];
+    unsigned int noOfDistinct = 0;
+    uint64_t random = 0x9E3779B97F4A7C15ULL;
+
+    for (unsigned int sample = 0; sample < COMPONENT_SAMPLES; sample++)
+    {
+        random ^= random << 13;
+        random ^= random >> 7;
+        random ^= random << 17;
+
+        VertexId root = state->parents[random % noOfNodes];
+        unsigned int index = 0;
+
+        while (index < noOfDistinct && samples[index] != root)
+        {
+            index++;
+        }
+
+        if (index == noOfDistinct)
+        {
+            samples[noOfDistinct] = root;
+            counts[noOfDistinct++] = 0;
+        }
+
+        counts[index]++;
+    }
+
+    unsigned int largest = 0;
+
+    for (unsigned int index = 1; index < noOfDistinct; index++)
+    {
+        if (counts[index] > counts[largest])
+        {
+            largest = index;
+        }
+    }
+
+    return samples[largest];
+}
+
+/*
+ * @brief Link every vertex to one of its neighbours
+ *
+ * Round r links each vertex with the r-th entry of
+ * its row, so every round hooks at most one edge
+ * per vertex
+ *
+ * @param ComponentsState (pointer*)
+ * @param unsigned int (thread index)
+ * @param unsigned int (round)
+ * @return void
+ *
+ */
+static void linkNeighbors(ComponentsState *state, unsigned int threadIndex, unsigned int round)
+{
+    const Graph *graph = state->graph;
+    size_t edgesExamined = 0;
+    size_t chunkStart;
+
+    while
+    (
+        (chunkStart = __atomic_fetch_add(&state->nextChunk[round], LINK_CHUNK, __ATOMIC_RELAXED))
+        < graph->noOfNodes
+    )
+    {
+        size_t chunkEnd = chunkStart + LINK_CHUNK < graph->noOfNodes ? chunkStart + LINK_CHUNK : graph->noOfNodes;
+
+        for (size_t vertex = chunkStart; vertex < chunkEnd; vertex++)
+        {
+            size_t edge = graph->edgeOffsets[vertex] + round;
+
+            if (edge < graph->edgeOffsets[vertex + 1])
+            {
+                linkVertices(state->parents, (VertexId)vertex, graph->adjacentNodes[edge]);
+                edgesExamined++;
+            }
+        }
+    }
+
+    state->edgesExamined[threadIndex] += edgesExamined;
+}
+
+/*
+ * @brief Link the edges the neighbour rounds left out
+ *
+ * Vertices already in the sampled largest component
+ * are skipped, as any edge they have into another
+ * component is also seen from that side. A directed
+ * graph stores an edge in the row of its source only,
+ * so there the incoming rows are linked as well
+ *
+ * @param ComponentsState (pointer*)
+ * @param unsigned int (thread index)
+ * @return void
+ *
+ */
+static void linkRemainingEdges(ComponentsState *state, unsigned int threadIndex)
+{
+    const Graph *graph = state->graph;
+    size_t edgesExamined = 0;
+    size_t chunkStart;
+
+    while
+    (
+        (chunkStart = __atomic_fetch_add(&state->nextChunk[NEIGHBOR_ROUNDS], LINK_CHUNK, __ATOMIC_RELAXED))
+        < graph->noOfNodes
+    )
+    {
+        size_t chunkEnd = chunkStart + LINK_CHUNK < graph->noOfNodes ? chunkStart + LINK_CHUNK : graph->noOfNodes;
+
+        for (size_t vertex = chunkStart; vertex < chunkEnd; vertex++)
+        {
+            if (__atomic_load_n(&state->parents[vertex], __ATOMIC_RELAXED) == state->largestComponent)
+            {
+                continue;
+            }
+
+            size_t rowStart = graph->edgeOffsets[vertex] + NEIGHBOR_ROUNDS;
+            size_t rowEnd = graph->edgeOffsets[vertex + 1];
+
+            for (size_t edge = rowStart; edge < rowEnd; edge++)
+            {
+                linkVertices(state->parents, (VertexId)vertex, graph->adjacentNodes[edge]);
+            }
+
+            edgesExamined += rowEnd > rowStart ? rowEnd - rowStart : 0;
+
+            if (graph->directed)
+            {
+                for (size_t edge = graph->incomingOffsets[vertex]; edge < graph->incomingOffsets[vertex + 1]; edge++)
+                {
+                    linkVertices(state->parents, (VertexId)vertex, graph->incomingNodes[edge]);
+                }
+
+                edgesExamined += graph->incomingOffsets[vertex + 1] - graph->incomingOffsets[vertex];
+            }
+        }
+    }
+
+    state->edgesExamined[threadIndex] += edgesExamined;
+}
+
+/*
+ * @brief Number the roots of a thread's range
+ *
+ * Each thread numbers its roots after the roots
+ * of the threads before it, which numbers the
+ * components in node list order
+ *
+ * @param ComponentsState (pointer*)
+ * @param unsigned int (thread index)
+ * @param VertexId (range start)
+ * @param VertexId (range end)
+ * @return void
+ *
+ */
+static void numberRoots(ComponentsState *state, unsigned int threadIndex, VertexId rangeStart, VertexId rangeEnd)
+{
+    unsigned int label = 0;
+
+    for (unsigned int thread = 0; thread < threadIndex; thread++)
+    {
+        label += state->rootCounts[thread];
+    }
+
+    for (VertexId vertex = rangeStart; vertex < rangeEnd; vertex++)
+    {
+        if (state->parents[vertex] == vertex)
+        {
+            state->labels[vertex] = label++;
+        }
+    }
+}
+
+/*
+ * @brief Worker thread body
+ *
+ * Runs every phase of the search together
+ * with the other workers
+ *
+ * @param void pointer (ComponentsWorkerArgument)
+ * @return void pointer (NULL)
+ *
+ */
+static void *componentsWorker(void *argument)
+{
+    ComponentsWorkerArgument *workerArgument = (ComponentsWorkerArgument *)argument;
+    ComponentsState *state = workerArgument->state;
+    unsigned int threadIndex = workerArgument->threadIndex;
+    unsigned int noOfNodes = state->graph->noOfNodes;
+
+    // static ranges for the even phases, linking balances by chunks instead
+    VertexId rangeStart = (VertexId)((uint64_t)noOfNodes * threadIndex / state->noOfThreads);
+    VertexId rangeEnd = (VertexId)((uint64_t)noOfNodes * (threadIndex + 1) / state->noOfThreads);
+
+    if (!enterWorker(&state->launch))
+    {
+        return NULL;
+    }
+
+    for (VertexId vertex = rangeStart; vertex < rangeEnd; vertex++)
+    {
+        state->parents[vertex] = vertex;
+    }
+
+    pthread_barrier_wait(&state->barrier);
+
+    for (unsigned int round = 0; round < NEIGHBOR_ROUNDS; round++)
+    {
+        linkNeighbors(state, threadIndex, round);
+
+        pthread_barrier_wait(&state->barrier);
+
+        compressRange(state->parents, rangeStart, rangeEnd);
+
+        pthread_barrier_wait(&state->barrier);
+    }
+
+    if (threadIndex == 0)
+    {
+        state->largestComponent = sampleLargestComponent(state);
+    }
+
+    pthread_barrier_wait(&state->barrier);
+
+    linkRemainingEdges(state, threadIndex);
+
+    pthread_barrier_wait(&state->barrier);
+
+    compressRange(state->parents, rangeStart, rangeEnd);
+
+    state->rootCounts[threadIndex] = 0;
+    for (VertexId vertex = rangeStart; vertex < rangeEnd; vertex++)
+    {
+        state->rootCounts[threadIndex] += state->parents[vertex] == vertex;
+    }
+
+    pthread_barrier_wait(&state->barrier);
+
+    numberRoots(state, threadIndex, rangeStart, rangeEnd);
+
+    pthread_barrier_wait(&state->barrier);
+
+    // only the labels of roots are read, so roots keep theirs untouched
+    for (VertexId vertex = rangeStart; vertex < rangeEnd; vertex++)
+    {
+        if (state->parents[vertex] != vertex)
+        {
+            state->labels[vertex] = state->labels[state->parents[vertex]];
+        }
+    }
+
+    return NULL;
+}
+
+/*
+ * @brief Number components in node list order
+ *
+ * Workers number components by their smallest
+ * vertex, which is only the node list order
+ * while the graph is not reordered
+ *
+ * @param Graph (pointer*)
+ * @param Components (pointer*)
+ * @return void
+ *
+ */
+static void renumberInListOrder(const Graph *graph, Components *components)
+{
+    unsigned int *newLabels = (unsigned int *)malloc(components->noOfComponents * sizeof(unsigned int));
+
+    if (newLabels == NULL)
+    {
+        perror("Failed to allocate memory\n");
+        exit(EXIT_FAILURE);
+    }
+
+    for (unsigned int label = 0; label < components->noOfComponents; label++)
+    {
+        newLabels[label] = UINT32_MAX;
+    }
+
+    unsigned int nextLabel = 0;
+
+    for (VertexId position = 0; position < graph->noOfNodes; position++)
+    {
+        unsigned int label = components->labels[getListedVertex(graph, position)];
+
+        if (newLabels[label] == UINT32_MAX)
+        {
+            newLabels[label] = nextLabel++;
+        }
+    }
+
+    for (VertexId vertex = 0; vertex < graph->noOfNodes; vertex++)
+    {
+        components->labels[vertex] = newLabels[components->labels[vertex]];
+    }
+
+    free(newLabels);
+}
+
+/*
+ * @brief Label the connected components of a graph
+ *
+ * Multithreaded Afforest: a few rounds link every
+ * vertex to single neighbours, a sample of vertices
+ * picks the component that is most likely the giant
+ * one, and only vertices outside it link the rest of
+ * their edges. Directed graphs get their weakly
+ * connected components
+ *
+ * @param Graph (pointer*) => incoming arrays are built if the graph is directed
+ * @param unsigned int (threads, 0 for every online core)
+ * @param Components (pointer*) => filled in, release with freeComponents
+ * @return void
+ *
+ */
+void findConnectedComponents(Graph *graph, unsigned int noOfThreads, Components *components)
+{
+    components->labels = (unsigned int *)malloc(graph->noOfNodes * sizeof(unsigned int));
+    components->sizes = NULL;
+    components->noOfComponents = 0;
+    components->edgesExamined = 0;
+
+    if (graph->noOfNodes == 0)
+    {
+        return;
+    }
+
+    if (graph->directed)
+    {
+        buildIncomingArrays(graph);
+    }
+
+    ComponentsState state = { 0 };
+    state.graph = graph;
+    state.labels = components->labels;
+    state.noOfThreads = resolveThreadCount(noOfThreads);
+
+    if (state.noOfThreads > graph->noOfNodes)
+    {
+        state.noOfThreads = graph->noOfNodes;
+    }
+
+    state.parents = (VertexId *)malloc(graph->noOfNodes * sizeof(VertexId));
+    state.rootCounts = (unsigned int *)calloc(state.noOfThreads, sizeof(unsigned int));
+    state.edgesExamined = (size_t *)calloc(state.noOfThreads, sizeof(size_t));
+    pthread_t *threads = (pthread_t *)malloc(state.noOfThreads * sizeof(pthread_t));
+    ComponentsWorkerArgument *workerArguments = (ComponentsWorkerArgument *)malloc
+    (
+        state.noOfThreads * sizeof(ComponentsWorkerArgument)
+    );
+
+    if
+    (
+        components->labels == NULL || state.parents == NULL || state.rootCounts == NULL ||
+        state.edgesExamined == NULL || threads == NULL || workerArguments == NULL
+    )
+    {
+        perror("Failed to allocate memory\n");
+        exit(EXIT_FAILURE);
+    }
+
+    pthread_barrier_init(&state.barrier, NULL, state.noOfThreads);
+
+    // the calling thread works as thread 0
+    for (unsigned int thread = 0; thread < state.noOfThreads; thread++)
+    {
+        workerArguments[thread].state = &state;
+        workerArguments[thread].threadIndex = thread;
+    }
+
+    startWorkers
+    (
+        &state.launch, threads, state.noOfThreads, componentsWorker,
+        workerArguments, sizeof(ComponentsWorkerArgument)
+    );
+    componentsWorker(&workerArguments[0]);
+    joinWorkers(&state.launch, threads, state.noOfThreads);
+
+    pthread_barrier_destroy(&state.barrier);
+
+    for (unsigned int thread = 0; thread < state.noOfThreads; thread++)
+    {
+        components->noOfComponents += state.rootCounts[thread];
+        components->edgesExamined += state.edgesExamined[thread];
+    }
+
+    if (graph->vertexOrder != NULL)
+    {
+        renumberInListOrder(graph, components);
+    }
+
+    components->sizes = (unsigned int *)calloc(components->noOfComponents, sizeof(unsigned int));
+
+    if (components->sizes == NULL)
+    {
+        perror("Failed to allocate memory\n");
+        exit(EXIT_FAILURE);
+    }
+
+    for (size_t vertex = 0; vertex < graph->noOfNodes; vertex++)
+    {
+        components->sizes[components->labels[vertex]]++;
+    }
+
+    free(state.parents);
+    free(state.rootCounts);
+    free(state.edgesExamined);
+    free(threads);
+    free(workerArguments);
+}
+
+/*
+ * @brief Free connected components
+ *
+ * @param Components (pointer*)
+ * @return void
+ *
+ */
+void freeComponents(Components *components)
+{
+    free(components->labels);
+    free(components->sizes);
+    components->labels = NULL;
+    components->sizes = NULL;
+}
@@ -1,61 +1,102 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
-#include <ctype.h>
 #include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <pthread.h>
 #include "decipherFile.h"
+#include "graphBuilder.h"
+#include "graphSnapshot.h"
+#include "parallelBfs.h"
+#include "traversalProfile.h"
+#include "workerThreads.h"
+#include "vertexDictionary.h"
 #include "types.h"
 
 /*
- * @brief declarations for internal functions
+ * @brief Scanner data structure
  *
- * List of static functions local to this file
- * Meant to be used in this file only
+ * Scanner struct walks the memory mapped graph
+ * file in place. Tokens are handed out as pointer
+ * and length pairs into the mapping, nothing is copied
  * 
- * @note all internal functions are static
+ * @member char pointer [array] (position) => next unread byte
+ * @member char pointer [array] (end) => one past the last byte of the file
+ * @member char pointer [array] (file name) => used in error messages
+ * @member size_t (line number) => current line, starting at 1
+ *
  */
-static void initGraph(Graph *graph);
-static unsigned int getNoOfNodes();
-static char *getNodeList();
-static bool isGraphDirected();
-static void createNewNode
-(
-    GraphNode **adjacencyList,
-    char startingVectorName,
-    char endingVectorName,
-    unsigned int weight
-);
-static void trackTotalWeight(Graph *graph, unsigned int weight);
-static void constructAdjacencyList(Graph *graph, GraphNode **adjacencyList, bool isDirected);
+typedef struct Scanner {
+    const char *position;
+    const char *end;
+    const char *fileName;
+    size_t lineNumber;
+} Scanner;
 
 /*
- * @brief FILE pointer
+ * @brief Smallest edge section slice worth a thread
+ *
+ * Small files are parsed by fewer threads so
+ * thread start up never outweighs the parsing
  *
- * File structure used to read from the
- * target file
- * 
- * @note This variable has global scope
  */
-FILE *file;
+#define MIN_CHUNK_BYTES (1 << 16)
 
 /*
- * @brief constant string file name 
+ * @brief Edge chunk data structure
  *
- * Relative file path of graph data file
+ * EdgeChunk struct is one newline aligned slice of
+ * the edge section, parsed by its own thread into
+ * its own edge list
  * 
- * @note This constant has global scope
+ * @member Graph (pointer*) => graph whose dictionary resolves names
+ * @member Scanner (scanner) => walks the slice, line number relative to it
+ * @member EdgeList (edge list) => edges of the slice in file order
+ * @member unsigned int (total weight) => weight of the slice's edges
+ * @member char pointer [array] (error message) => NULL unless parsing failed
+ *
  */
-const char fileName[] = "data/graph.txt";
+typedef struct EdgeChunk {
+    const Graph *graph;
+    Scanner scanner;
+    EdgeList edgeList;
+    unsigned int totalWeight;
+    const char *errorMessage;
+} EdgeChunk;
 
 /*
- * @brief line buffer
+ * @brief declarations for internal functions
  *
- * Line buffer to read a line from
- * the file
+ * List of static functions local to this file
+ * Meant to be used in this file only
  * 
- * @note This variable has global scope
+ * @note all internal functions are static
  */
-char line[256];
+static void initGraph(Graph *graph);
+static void failParse(const Scanner *scanner, const char *message);
+static bool isBlank(char character);
+static bool readToken(Scanner *scanner, const char **token, size_t *length);
+static bool parseUnsigned(const char *token, size_t length, unsigned int *value);
+static bool skipLineEnd(Scanner *scanner);
+static void finishLine(Scanner *scanner);
+static unsigned int getNoOfNodes(Scanner *scanner);
+static void getNodeList(Graph *graph, Scanner *scanner);
+static bool isGraphDirected(Scanner *scanner);
+static void trackTotalWeight(Graph *graph, unsigned int weight);
+static const char *collectEdge(EdgeChunk *chunk);
+static void *parseEdgeChunk(void *argument);
+static EdgeList *parseEdgeSection
+(
+    Graph *graph,
+    Scanner *scanner,
+    unsigned int noOfThreads,
+    unsigned int *noOfLists
+);
+static const char *mapGraphFile(const char *fileName, size_t *length);
+static void appendSource(VertexId **sources, unsigned int *noOfSources, unsigned int *capacity, VertexId source);
 
 /*
  * @brief Initialize graph struct
@@ -68,67 +109,238 @@ static void initGraph(Graph *graph)
 {
     graph->noOfNodes = 0;
     graph->totalWeight = 0;
-    graph->nodeList = NULL;
+    graph->noOfEdges = 0;
     graph->directed = true;
-    graph->adjacentLists = NULL;
+    graph->edgeOffsets = NULL;
+    graph->adjacentNodes = NULL;
+    graph->edgeWeights = NULL;
+    graph->incomingOffsets = NULL;
+    graph->incomingNodes = NULL;
+    graph->incomingPositions = NULL;
+    graph->snapshotMapping = NULL;
+    graph->snapshotLength = 0;
+    graph->vertexOrder = NULL;
+    graph->compressed = NULL;
+    graph->sortedRows = false;
+    initArena(&graph->arena);
+    initVertexDictionary(&graph->dictionary, 0);
+}
+
+/*
+ * @brief Report a parse error and exit
+ * 
+ * @param Scanner (pointer*)
+ * @param char pointer [array] (message)
+ * @return void
+ * 
+ */
+static void failParse(const Scanner *scanner, const char *message)
+{
+    fprintf(stderr, "%s:%zu: %s\n", scanner->fileName, scanner->lineNumber, message);
+    exit(EXIT_FAILURE);
+}
+
+/*
+ * @brief Check for whitespace within a line
+ * 
+ * @param char (character)
+ * @return bool
+ * 
+ */
+static bool isBlank(char character)
+{
+    return character == ' ' || character == '\t' || character == '\r' ||
+        character == '\v' || character == '\f';
+}
+
+/*
+ * @brief Read next token on the current line
+ * 
+ * @param Scanner (pointer*)
+ * @param char pointer (pointer*) => receives start of token
+ * @param size_t (pointer*) => receives token length
+ * @return bool (false if the line has no tokens left)
+ * 
+ */
+static bool readToken(Scanner *scanner, const char **token, size_t *length)
+{
+    const char *cursor = scanner->position;
+
+    while (cursor < scanner->end && isBlank(*cursor))
+    {
+        cursor++;
+    }
+
+    if (cursor == scanner->end || *cursor == '\n')
+    {
+        scanner->position = cursor;
+        return false;
+    }
+
+    const char *tokenEnd = cursor;
+    while (tokenEnd < scanner->end && *tokenEnd != '\n' && !isBlank(*tokenEnd))
+    {
+        tokenEnd++;
+    }
+
+    *token = cursor;
+    *length = (size_t)(tokenEnd - cursor);
+    scanner->position = tokenEnd;
+
+    return true;
+}
+
+/*
+ * @brief Parse an unsigned decimal token
+ * 
+ * @param char pointer [array] (token)
+ * @param size_t (token length)
+ * @param unsigned int (pointer*) => receives the value
+ * @return bool (false if not a number or out of range)
+ * 
+ */
+static bool parseUnsigned(const char *token, size_t length, unsigned int *value)
+{
+    if (length == 0)
+    {
+        return false;
+    }
+
+    unsigned long long number = 0;
+
+    for (size_t index = 0; index < length; index++)
+    {
+        unsigned int digit = (unsigned int)(token[index] - '0');
+
+        if (digit > 9)
+        {
+            return false;
+        }
+
+        number = number * 10 + digit;
+
+        if (number > 0xFFFFFFFFULL)
+        {
+            return false;
+        }
+    }
+
+    *value = (unsigned int)number;
+
+    return true;
+}
+
+/*
+ * @brief Move past the end of the current line
+ * 
+ * @param Scanner (pointer*)
+ * @return bool (false if the line has tokens left)
+ * 
+ */
+static bool skipLineEnd(Scanner *scanner)
+{
+    const char *token;
+    size_t length;
+
+    if (readToken(scanner, &token, &length))
+    {
+        return false;
+    }
+
+    if (scanner->position < scanner->end)
+    {
+        scanner->position++; // skip the newline
+    }
+
+    scanner->lineNumber++;
+
+    return true;
+}
+
+/*
+ * @brief Move past the end of the current line
+ * 
+ * @param Scanner (pointer*)
+ * @return void
+ * 
+ * @note Exits if the line has tokens left
+ * 
+ */
+static void finishLine(Scanner *scanner)
+{
+    if (!skipLineEnd(scanner))
+    {
+        failParse(scanner, "Unexpected text at end of line");
+    }
 }
 
 /*
  * @brief Extract number of nodes from line
  * 
+ * @param Scanner (pointer*)
  * @return unsigned int (number of nodes)
  * 
  */
-static unsigned int getNoOfNodes()
+static unsigned int getNoOfNodes(Scanner *scanner)
 {
+    const char *token;
+    size_t length;
     unsigned int number;
-    if (!sscanf(line, "%u", &number))
+
+    if (!readToken(scanner, &token, &length) || !parseUnsigned(token, length, &number))
     {
-        perror("Error in getting number\n");
-        exit(EXIT_FAILURE);
+        failParse(scanner, "Error in getting number");
     }
 
+    finishLine(scanner);
+
     return number;
 }
 
 /*
  * @brief Extract node names from line
  * 
- * Retrieve the names of nodes to a
- * dynamic array and return its pointer
+ * Interns the names of nodes into the vertex
+ * dictionary of the graph. Vertex identifiers are
+ * handed out in the order the names appear
  * 
- * @return char array (pointer*)
+ * @param Graph (pointer*)
+ * @param Scanner (pointer*)
+ * @return void
  * 
  */
-static char *getNodeList()
+static void getNodeList(Graph *graph, Scanner *scanner)
 {
-    unsigned int fullLength = 0;
-    unsigned int filledLength = 0;
-    while (line[fullLength] != '\n')
+    // every name takes at least a byte and a separator, so a
+    // count the rest of the file cannot hold is never allocated
+    size_t maxNames = (size_t)(scanner->end - scanner->position) / 2 + 1;
+    VertexId expectedNames = graph->noOfNodes < maxNames ? graph->noOfNodes : (VertexId)maxNames;
+
+    // size the dictionary up front so interning rarely rehashes
+    freeVertexDictionary(&graph->dictionary);
+    initVertexDictionary(&graph->dictionary, expectedNames);
+
+    const char *token;
+    size_t length;
+
+    while (readToken(scanner, &token, &length))
     {
-        if (!isspace(line[fullLength]))
+        VertexId namesBefore = graph->dictionary.noOfNames;
+
+        internVertexName(&graph->dictionary, token, length);
+
+        if (graph->dictionary.noOfNames == namesBefore)
         {
-            filledLength++;
+            failParse(scanner, "Duplicate node name");
         }
-        fullLength++;
     }
 
-    char *nodeList = (char*)malloc(filledLength * sizeof(char));
-    if (nodeList == NULL)
+    if (graph->dictionary.noOfNames != graph->noOfNodes)
     {
-        perror("Failed to allocate memory\n");
-        exit(EXIT_FAILURE);
-    }
-
-    for (size_t index = 0, nodeIndex = 0; index < fullLength; index++)
-    {
-        if (!isspace(line[index]))
-        {
-            nodeList[nodeIndex++] = line[index];
-        }
+        failParse(scanner, "Node list does not match the number of nodes");
     }
 
-    return nodeList;
+    finishLine(scanner);
 }
 
 /*
@@ -138,170 +350,320 @@ static char *getNodeList()
  * from the file and return true if directed and false
  * if not
  * 
+ * @param Scanner (pointer*)
  * @return bool
  * 
  */
-static bool isGraphDirected()
+static bool isGraphDirected(Scanner *scanner)
 {
+    const char *token;
+    size_t length;
     bool isDirected = false;
 
-    size_t length = 0;
-    while (line[length] != '\n' && line[length] != '\0')
+    if (!readToken(scanner, &token, &length))
     {
-        length++;
+        failParse(scanner, "Incorrect graph type specified!");
     }
 
-    char *directionName = (char*)malloc((length+1) * sizeof(char));
-    if (directionName == NULL)
-    {
-        perror("Failed to allocate memory\n");
-        exit(EXIT_FAILURE);
-    }
-
-    size_t index;
-    for (index = 0; index < length; index++)
-    {
-        directionName[index] = line[index];
-    }
-
-    directionName[index] = '\0'; // add null termination for strings
-
-    if (strcmp(directionName, "directed") == 0)
+    if (length == 8 && memcmp(token, "directed", 8) == 0)
     {
         isDirected = true;
     }
-    else if (strcmp(directionName, "undirected") == 0)
+    else if (length == 10 && memcmp(token, "undirected", 10) == 0)
     {
         isDirected = false;
     }
     else
     {
-        perror("Incorrect graph type specified!\n");
-        exit(EXIT_FAILURE);
+        failParse(scanner, "Incorrect graph type specified!");
     }
 
-    free(directionName); // free dynamically allocated array
+    finishLine(scanner);
 
     return isDirected;
 }
 
 /*
- * @brief Create a node in adjacency list
+ * @brief Track total weight of graph
  * 
- * Creates a node in adjacency list as per the data
- * from the graph file
+ * Adds the weight of a edge to
+ * previously calculated total weights one
+ * at a time
  * 
- * @param GraphNode [2D array] (pointer to pointer*)
- * @param char (starting vector name)
- * @param char (ending vector name)
+ * @param Graph (pointer*)
  * @param unsigned int (weight)
  * @return void
  * 
  */
-static void createNewNode
-(
-    GraphNode **adjacencyList,
-    char startingVectorName,
-    char endingVectorName,
-    unsigned int weight
-)
+static void trackTotalWeight(Graph *graph, unsigned int weight)
+{
+    graph->totalWeight += weight;
+}
+
+/*
+ * @brief Collect an edge from line
+ * 
+ * Parses an edge from the graph file and
+ * appends it to the chunk's edge list. A reverse
+ * edge is appended too if undirected
+ * 
+ * @param EdgeChunk (pointer*)
+ * @return char pointer [array] (error message, NULL on success)
+ * 
+ * @note Blank lines are skipped
+ * @note Only reads the dictionary, so chunks may run concurrently
+ * 
+ */
+static const char *collectEdge(EdgeChunk *chunk)
 {
-    GraphNode *currentGraphNode = adjacencyList[startingVectorName - 'A'];
-    GraphNode *lastGraphNode = NULL;
+    Scanner *scanner = &chunk->scanner;
+    const char *startingVectorName, *endingVectorName, *weightText;
+    size_t startingLength, endingLength, weightLength;
+    unsigned int weight;
 
-    while (currentGraphNode != NULL)
+    if (!readToken(scanner, &startingVectorName, &startingLength))
     {
-        lastGraphNode = currentGraphNode;
-        currentGraphNode = currentGraphNode->next;
+        skipLineEnd(scanner); // blank line
+        return NULL;
     }
 
-    GraphNode *newGraphNode = (GraphNode*)malloc(sizeof(GraphNode));
+    if
+    (
+        !readToken(scanner, &endingVectorName, &endingLength) ||
+        !readToken(scanner, &weightText, &weightLength) ||
+        !parseUnsigned(weightText, weightLength, &weight)
+    )
+    {
+        return "Error reading edge";
+    }
 
-    if (newGraphNode == NULL)
+    const VertexDictionary *dictionary = &chunk->graph->dictionary;
+    VertexId startingVertex = findVertexId(dictionary, startingVectorName, startingLength);
+    VertexId endingVertex = findVertexId(dictionary, endingVectorName, endingLength);
+
+    if (startingVertex == INVALID_VERTEX || endingVertex == INVALID_VERTEX)
     {
-        perror("Failed to allocate memory\n");
-        exit(EXIT_FAILURE);
+        return "Edge refers to a node missing from the node list";
     }
 
-    newGraphNode->nodeName = endingVectorName;
-    newGraphNode->weight = weight;
-    newGraphNode->next = NULL;
+    appendEdge(&chunk->edgeList, startingVertex, endingVertex, weight);
 
-    if (lastGraphNode != NULL)
+    chunk->totalWeight += weight; // add the weight of the edge
+
+    // add a bidirectional edge if undirected
+    if (!chunk->graph->directed)
     {
-        lastGraphNode->next = newGraphNode;
+        appendEdge(&chunk->edgeList, endingVertex, startingVertex, weight);
     }
-    else
+
+    if (!skipLineEnd(scanner))
     {
-        adjacencyList[startingVectorName - 'A'] = newGraphNode;
+        return "Unexpected text at end of line";
     }
+
+    return NULL;
 }
 
 /*
- * @brief Track total weight of graph
+ * @brief Edge chunk parsing thread
  * 
- * Adds the weight of a edge to
- * previously calculated total weights one
- * at a time
+ * Collects edges until the end of the chunk
+ * or the first malformed line
  * 
- * @param Graph (pointer*)
- * @param unsigned int (weight)
- * @return void
+ * @param void pointer (EdgeChunk)
+ * @return void pointer (NULL)
  * 
  */
-static void trackTotalWeight(Graph *graph, unsigned int weight)
+static void *parseEdgeChunk(void *argument)
 {
-    graph->totalWeight += weight;
+    EdgeChunk *chunk = (EdgeChunk *)argument;
+
+    while (chunk->scanner.position < chunk->scanner.end && chunk->errorMessage == NULL)
+    {
+        chunk->errorMessage = collectEdge(chunk);
+    }
+
+    return NULL;
 }
 
 /*
- * @brief Construct adjacency list
+ * @brief Parse the edge section of the file
  * 
- * Creates the full adjacency list from
- * the data in graph file
+ * Splits the rest of the file into newline aligned
+ * slices and parses every slice on its own thread
+ * into an edge list of its own
  * 
- * @param GraphNode [2D array] (pointer to pointer*)
- * @param bool (directed or undirected)
- * @return void
+ * @param Graph (pointer*)
+ * @param Scanner (pointer*) => positioned after the header
+ * @param unsigned int (number of threads, 0 for every online core)
+ * @param unsigned int (pointer*) => receives the number of edge lists
+ * @return EdgeList pointer [array] (edge lists, in file order)
+ * 
+ * @note Errors report the same line a sequential parse would
  * 
  */
-static void constructAdjacencyList(Graph *graph, GraphNode **adjacencyList, bool isDirected)
+static EdgeList *parseEdgeSection
+(
+    Graph *graph,
+    Scanner *scanner,
+    unsigned int noOfThreads,
+    unsigned int *noOfLists
+)
 {
-    char startingVectorName, endingVectorName;
-    unsigned int weight;
+    size_t sectionLength = (size_t)(scanner->end - scanner->position);
+    unsigned int noOfChunks = resolveThreadCount(noOfThreads);
 
-    if (sscanf(line, " %c %c %u", &startingVectorName, &endingVectorName, &weight))
+    if (noOfChunks > sectionLength / MIN_CHUNK_BYTES + 1)
     {
-        createNewNode(adjacencyList, startingVectorName, endingVectorName, weight);
+        noOfChunks = (unsigned int)(sectionLength / MIN_CHUNK_BYTES + 1);
+    }
 
-        trackTotalWeight(graph, weight); // add the weight of the edge
+    EdgeChunk *chunks = (EdgeChunk *)malloc(noOfChunks * sizeof(EdgeChunk));
+    pthread_t *threads = (pthread_t *)malloc(noOfChunks * sizeof(pthread_t));
+    EdgeList *edgeLists = (EdgeList *)malloc(noOfChunks * sizeof(EdgeList));
 
-        // add a bidirectional edge if undirected
-        if (!isDirected)
+    if (chunks == NULL || threads == NULL || edgeLists == NULL)
+    {
+        perror("Failed to allocate memory\n");
+        exit(EXIT_FAILURE);
+    }
+
+    const char *chunkStart = scanner->position;
+
+    for (unsigned int chunk = 0; chunk < noOfChunks; chunk++)
+    {
+        const char *chunkEnd = scanner->end;
+
+        // cut just after the first newline past the even split point
+        if (chunk + 1 < noOfChunks)
         {
-            createNewNode(adjacencyList, endingVectorName, startingVectorName, weight);
+            chunkEnd = scanner->position + sectionLength / noOfChunks * (chunk + 1);
+
+            if (chunkEnd < chunkStart)
+            {
+                chunkEnd = chunkStart;
+            }
+
+            const char *newline = memchr(chunkEnd, '\n', (size_t)(scanner->end - chunkEnd));
+            chunkEnd = newline == NULL ? scanner->end : newline + 1;
         }
+
+        chunks[chunk].graph = graph;
+        chunks[chunk].scanner.position = chunkStart;
+        chunks[chunk].scanner.end = chunkEnd;
+        chunks[chunk].scanner.fileName = scanner->fileName;
+        chunks[chunk].scanner.lineNumber = 0;
+        chunks[chunk].totalWeight = 0;
+        chunks[chunk].errorMessage = NULL;
+        initEdgeList(&chunks[chunk].edgeList);
+
+        chunkStart = chunkEnd;
     }
-    else {
-        perror("Error reading file\n");
+
+    // the calling thread parses the first chunk, chunks never wait on each other
+    WorkerLaunch launch;
+    startWorkers(&launch, threads, noOfChunks, parseEdgeChunk, chunks, sizeof(EdgeChunk));
+    parseEdgeChunk(&chunks[0]);
+    joinWorkers(&launch, threads, noOfChunks);
+
+    for (unsigned int chunk = 0; chunk < noOfChunks; chunk++)
+    {
+        // chunk line numbers are relative to where the chunk starts
+        chunks[chunk].scanner.lineNumber += scanner->lineNumber;
+
+        if (chunks[chunk].errorMessage != NULL)
+        {
+            failParse(&chunks[chunk].scanner, chunks[chunk].errorMessage);
+        }
+
+        scanner->lineNumber = chunks[chunk].scanner.lineNumber;
+        trackTotalWeight(graph, chunks[chunk].totalWeight);
+        edgeLists[chunk] = chunks[chunk].edgeList;
+    }
+
+    scanner->position = scanner->end;
+
+    free(chunks);
+    free(threads);
+
+    *noOfLists = noOfChunks;
+
+    return edgeLists;
+}
+
+/*
+ * @brief Memory map graph file
+ * 
+ * Maps the whole file read only
+ * 
+ * @param char pointer [array] (file name)
+ * @param size_t (pointer*) => receives file length
+ * @return char pointer [array] (start of mapping)
+ * 
+ */
+static const char *mapGraphFile(const char *fileName, size_t *length)
+{
+    int fileDescriptor = open(fileName, O_RDONLY);
+    if (fileDescriptor == -1)
+    {
+        perror("Error in file\n");
+        exit(EXIT_FAILURE);
+    }
+
+    struct stat fileStatus;
+    if (fstat(fileDescriptor, &fileStatus) == -1)
+    {
+        perror("Error in file\n");
         exit(EXIT_FAILURE);
     }
+
+    if (fileStatus.st_size == 0)
+    {
+        fprintf(stderr, "%s: file is empty\n", fileName);
+        exit(EXIT_FAILURE);
+    }
+
+    *length = (size_t)fileStatus.st_size;
+
+    void *mapping = mmap(NULL, *length, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+    if (mapping == MAP_FAILED)
+    {
+        perror("Failed to map file\n");
+        exit(EXIT_FAILURE);
+    }
+
+    close(fileDescriptor); // the mapping stays valid
+
+    return (const char *)mapping;
 }
 
 /*
  * @brief Create graph structure from file
  * 
  * Creates the complete graph structure
- * and return its pointer
+ * and return its pointer. The file is memory
+ * mapped and tokenized in place, or used as is
+ * when it is a binary snapshot
  * 
+ * @param char pointer [array] (file name)
+ * @param unsigned int (threads parsing edges, 0 for every online core)
+ * @param LoadTimings (pointer*) => receives stage timings, may be NULL
  * @return Graph (pointer)
  * 
  */
-Graph *createGraphFromFile()
+Graph *createGraphFromFile(const char *fileName, unsigned int noOfThreads, LoadTimings *timings)
 {
-    Graph *graph = (Graph*)malloc(sizeof(Graph));
+    LoadTimings localTimings;
+    double loadStart = readClock();
 
-    initGraph(graph);
+    if (timings == NULL)
+    {
+        timings = &localTimings;
+    }
+
+    timings->buildSeconds = 0;
+
+    Graph *graph = (Graph*)malloc(sizeof(Graph));
 
     if (graph == NULL)
     {
@@ -309,60 +671,152 @@ Graph *createGraphFromFile()
         exit(EXIT_FAILURE);
     }
 
-    file = fopen(fileName, "r");
-    if (file == NULL)
+    initGraph(graph);
+
+    size_t fileLength;
+    const char *fileContents = mapGraphFile(fileName, &fileLength);
+
+    if (isGraphSnapshot(fileContents, fileLength))
     {
-        perror("Error in file\n");
-        exit(EXIT_FAILURE);
+        openGraphSnapshot(graph, (void *)fileContents, fileLength, fileName);
+        timings->loadSeconds = readClock() - loadStart;
+        return graph;
     }
 
-    int lineNumber = 1;
+    madvise((void *)fileContents, fileLength, MADV_SEQUENTIAL);
+
+    Scanner scanner;
+    scanner.position = fileContents;
+    scanner.end = fileContents + fileLength;
+    scanner.fileName = fileName;
+    scanner.lineNumber = 1;
+
+    // first three lines are the header
+    graph->noOfNodes = getNoOfNodes(&scanner);
+    getNodeList(graph, &scanner);
+    graph->directed = isGraphDirected(&scanner);
+
+    unsigned int noOfLists;
+    EdgeList *edgeLists = parseEdgeSection(graph, &scanner, noOfThreads, &noOfLists);
 
-    // reads line by line from graph data file
-    while (fgets(line, sizeof(line), file))
+    // names were copied into the dictionary, so the text can go before the build
+    munmap((void *)fileContents, fileLength);
+
+    // lay out all collected edges contiguously, one thread per list
+    double buildStart = readClock();
+    buildAdjacencyArraysFromLists(graph, edgeLists, noOfLists);
+    timings->buildSeconds = readClock() - buildStart;
+
+    for (unsigned int list = 0; list < noOfLists; list++)
     {
-        if (lineNumber == 1)
-        {
-            graph->noOfNodes = getNoOfNodes();
-            graph->adjacentLists = (GraphNode**)malloc(graph->noOfNodes * sizeof(GraphNode));
+        freeEdgeList(&edgeLists[list]);
+    }
 
-            if (graph->adjacentLists == NULL)
-            {
-                perror("Failed to allocate memory\n");
-                exit(EXIT_FAILURE);
-            }
+    free(edgeLists);
 
-            // initialize adjacency list
-            for (size_t index = 0; index < graph->noOfNodes; index++)
-            {
-                graph->adjacentLists[index] = NULL;
-            }
-        }
-        else if (lineNumber == 2)
-        {
-            graph->nodeList = getNodeList();
-        }
-        else if (lineNumber == 3)
+    timings->loadSeconds = readClock() - loadStart - timings->buildSeconds;
+
+    return graph;
+}
+
+/*
+ * @brief Append a source to a growable list
+ * 
+ * @param VertexId pointer (pointer*) => list, grown by doubling
+ * @param unsigned int (pointer*) => number of sources
+ * @param unsigned int (pointer*) => capacity of the list
+ * @param VertexId (source)
+ * @return void
+ * 
+ */
+static void appendSource(VertexId **sources, unsigned int *noOfSources, unsigned int *capacity, VertexId source)
+{
+    if (*noOfSources == *capacity)
+    {
+        unsigned int newCapacity = *capacity == 0 ? 64 : *capacity * 2;
+        VertexId *newSources = (VertexId *)realloc(*sources, newCapacity * sizeof(VertexId));
+
+        if (newSources == NULL)
         {
-            graph->directed = isGraphDirected();
+            perror("Failed to allocate memory\n");
+            exit(EXIT_FAILURE);
         }
-        else
+
+        *sources = newSources;
+        *capacity = newCapacity;
+    }
+
+    (*sources)[(*noOfSources)++] = source;
+}
+
+/*
+ * @brief Read a list of source vertices from file
+ * 
+ * Resolves every whitespace separated node name
+ * in the file against the graph's dictionary, keeping
+ * the order of the file
+ * 
+ * @param Graph (pointer*)
+ * @param char pointer [array] (file name)
+ * @param unsigned int (pointer*) => receives number of sources
+ * @return VertexId pointer [array] (sources, caller frees)
+ * 
+ * @note Exits on a name missing from the node list
+ * 
+ */
+VertexId *readSourceList(const Graph *graph, const char *fileName, unsigned int *noOfSources)
+{
+    size_t fileLength;
+    const char *fileContents = mapGraphFile(fileName, &fileLength);
+
+    Scanner scanner;
+    scanner.position = fileContents;
+    scanner.end = fileContents + fileLength;
+    scanner.fileName = fileName;
+    scanner.lineNumber = 1;
+
+    VertexId *sources = NULL;
+    unsigned int capacity = 0;
+    *noOfSources = 0;
+
+    while (scanner.position < scanner.end)
+    {
+        const char *token;
+        size_t length;
+
+        while (readToken(&scanner, &token, &length))
         {
-            constructAdjacencyList(graph, graph->adjacentLists, graph->directed);
+            VertexId source = findVertexId(&graph->dictionary, token, length);
+
+            if (source == INVALID_VERTEX)
+            {
+                failParse(&scanner, "Source is missing from the node list");
+            }
+
+            appendSource(&sources, noOfSources, &capacity, source);
         }
 
-        lineNumber++;
-        
+        finishLine(&scanner);
     }
 
-    return graph;
+    munmap((void *)fileContents, fileLength);
+
+    if (*noOfSources == 0)
+    {
+        fprintf(stderr, "%s: no sources listed\n", fileName);
+        exit(EXIT_FAILURE);
+    }
+
+    return sources;
 }
 
 /*
  * @brief Free dynamically created graph structs
  * 
  * Frees the dynamically created structs that were
- * not immediately freed upon creation
+ * not immediately freed upon creation. The arrays
+ * all sit in the graph's arena, so this releases
+ * a few large blocks however many edges there are
  * 
  * @param Graph (pointer*)
  * @return void
@@ -370,21 +824,17 @@ Graph *createGraphFromFile()
  */
 void freeGraph(Graph *graph)
 {
-    // free individual linked lists
-    for (size_t index = 0; index < graph->noOfNodes; index++)
+    freeArena(&graph->arena);
+
+    // snapshot arrays live in the mapping itself
+    if (graph->snapshotMapping != NULL)
     {
-        GraphNode *current = graph->adjacentLists[index];
-        while (current != NULL)
-        {
-            GraphNode *temp = current;
-            current = current->next;
-            free(temp);
-        }
+        munmap(graph->snapshotMapping, graph->snapshotLength);
+        free(graph);
+        return;
     }
 
-    free(graph->adjacentLists);
-
-    free(graph->nodeList);
+    freeVertexDictionary(&graph->dictionary);
 
     free(graph);
 }
\ No newline at end of file
@@ -0,0 +1,621 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include "directionOptimizing.h"
+#include "bitmap.h"
+#include "graphBuilder.h"
+#include "reorder.h"
+#include "types.h"
+#include "logic.h"
+#include "traversalProfile.h"
+#include "bfsVisitor.h"
+
+/*
+ * @brief Bottom-up scratch data structure
+ *
+ * BottomUpScratch struct holds the per vertex
+ * arrays used by bottom-up steps. It is allocated
+ * once per traversal and left clean after each level
+ * 
+ * @member Bitmap (frontier) => marks vertices of the current frontier
+ * @member VertexId pointer [array] (frontier rank) => path index of frontier vertices, INVALID_VERTEX otherwise
+ * @member Bitmap (next frontier) => marks vertices found but not yet placed in the path
+ * @member VertexId pointer [array] (candidates) => vertices found by the last bottom-up step
+ * @member size_t (pending in edges) => in degree sum of vertices found but not yet placed
+ *
+ */
+typedef struct BottomUpScratch {
+    Bitmap frontier;
+    VertexId *frontierRank;
+    Bitmap nextFrontier;
+    VertexId *candidates;
+    size_t pendingInEdges;
+} BottomUpScratch;
+
+/*
+ * @brief Straggler data structure
+ *
+ * Straggler struct pairs a vertex that was not placed
+ * by the frontier scan with the edge a top-down step
+ * would have discovered it through
+ * 
+ * @member VertexId (parent rank) => path index of the discovering frontier vertex
+ * @member unsigned int (position) => position of the edge in the parent's row
+ * @member VertexId (vertex) => the vertex waiting to be placed
+ *
+ */
+typedef struct Straggler {
+    VertexId parentRank;
+    unsigned int position;
+    VertexId vertex;
+} Straggler;
+
+/*
+ * @brief declarations for internal functions
+ *
+ * List of static functions local to this file
+ * Meant to be used in this file only
+ * 
+ * @note all internal functions are static
+ */
+static size_t getOutDegree(const Graph *graph, VertexId vertex);
+static size_t getInDegree(const Graph *graph, VertexId vertex);
+static unsigned int topDownStep
+(
+    const Graph *graph,
+    Bitmap *visited,
+    VertexId *traversalPath,
+    unsigned int levelStart,
+    unsigned int levelEnd,
+    size_t *scoutCount,
+    size_t *edgesExamined
+);
+static unsigned int bottomUpStep
+(
+    const Graph *graph,
+    const Bitmap *visited,
+    BottomUpScratch *scratch,
+    size_t *edgesExamined
+);
+static int compareStragglers(const void *first, const void *second);
+static unsigned int placeStragglers
+(
+    const Graph *graph,
+    Bitmap *visited,
+    BottomUpScratch *scratch,
+    VertexId *traversalPath,
+    unsigned int scanStart,
+    unsigned int pathLength,
+    unsigned int nextCount,
+    size_t *scoutCount,
+    size_t *edgesExamined
+);
+static unsigned int orderNextLevel
+(
+    const Graph *graph,
+    Bitmap *visited,
+    BottomUpScratch *scratch,
+    VertexId *traversalPath,
+    unsigned int levelStart,
+    unsigned int levelEnd,
+    unsigned int nextCount,
+    size_t *scoutCount,
+    size_t *edgesExamined
+);
+
+/*
+ * @brief Get out degree of a vertex
+ * 
+ * @param Graph (pointer*)
+ * @param VertexId (vertex)
+ * @return size_t (number of outgoing edges)
+ * 
+ */
+static size_t getOutDegree(const Graph *graph, VertexId vertex)
+{
+    return graph->edgeOffsets[vertex + 1] - graph->edgeOffsets[vertex];
+}
+
+/*
+ * @brief Get in degree of a vertex
+ * 
+ * @param Graph (pointer*)
+ * @param VertexId (vertex)
+ * @return size_t (number of incoming edges)
+ * 
+ */
+static size_t getInDegree(const Graph *graph, VertexId vertex)
+{
+    return graph->incomingOffsets[vertex + 1] - graph->incomingOffsets[vertex];
+}
+
+/*
+ * @brief Top-down step
+ * 
+ * Scans the outgoing edges of every frontier
+ * vertex in path order and appends unvisited
+ * neighbours to the path
+ * 
+ * @param Graph (pointer*)
+ * @param Bitmap (pointer*) => visited
+ * @param VertexId pointer [array] (traversal path)
+ * @param unsigned int (start of frontier in path)
+ * @param unsigned int (end of frontier in path)
+ * @param size_t (pointer*) => receives out degree sum of the next frontier
+ * @param size_t (pointer*) => edges examined counter
+ * @return unsigned int (end of next frontier in path)
+ * 
+ */
+static unsigned int topDownStep
+(
+    const Graph *graph,
+    Bitmap *visited,
+    VertexId *traversalPath,
+    unsigned int levelStart,
+    unsigned int levelEnd,
+    size_t *scoutCount,
+    size_t *edgesExamined
+)
+{
+    unsigned int pathLength = levelEnd;
+    size_t nextScoutCount = 0;
+
+    for (unsigned int index = levelStart; index < levelEnd; index++)
+    {
+        VertexId frontierNode = traversalPath[index];
+        size_t rowEnd = graph->edgeOffsets[frontierNode + 1];
+
+        *edgesExamined += rowEnd - graph->edgeOffsets[frontierNode];
+
+        for (size_t edge = graph->edgeOffsets[frontierNode]; edge < rowEnd; edge++)
+        {
+            VertexId adjacentNode = graph->adjacentNodes[edge];
+
+            if (!testBit(visited, adjacentNode))
+            {
+                setBit(visited, adjacentNode);
+                traversalPath[pathLength++] = adjacentNode;
+                nextScoutCount += getOutDegree(graph, adjacentNode);
+            }
+        }
+    }
+
+    *scoutCount = nextScoutCount;
+
+    return pathLength;
+}
+
+/*
+ * @brief Bottom-up step
+ * 
+ * Every unvisited vertex looks for any predecessor
+ * in the frontier and stops at the first one found.
+ * Found vertices are marked in the next frontier and
+ * listed as candidates in vertex order
+ * 
+ * @param Graph (pointer*)
+ * @param Bitmap (pointer*) => visited
+ * @param BottomUpScratch (pointer*)
+ * @param size_t (pointer*) => edges examined counter
+ * @return unsigned int (size of next frontier)
+ * 
+ * @note Unvisited vertices are enumerated from the visited
+ *       bitmap a word at a time with count trailing zeros
+ * 
+ */
+static unsigned int bottomUpStep
+(
+    const Graph *graph,
+    const Bitmap *visited,
+    BottomUpScratch *scratch,
+    size_t *edgesExamined
+)
+{
+    unsigned int nextCount = 0;
+    size_t pendingInEdges = 0;
+
+    for (size_t wordIndex = 0; wordIndex < visited->noOfWords; wordIndex++)
+    {
+        uint64_t unvisitedBits = ~visited->words[wordIndex];
+
+        // whole words of visited vertices are skipped at once
+        while (unvisitedBits != 0)
+        {
+            size_t bit = (size_t)__builtin_ctzll(unvisitedBits);
+            VertexId vertex = (VertexId)(wordIndex * BITMAP_WORD_BITS + bit);
+            unvisitedBits &= unvisitedBits - 1; // drop lowest set bit
+
+            if (vertex >= graph->noOfNodes)
+            {
+                break;
+            }
+
+            size_t rowEnd = graph->incomingOffsets[vertex + 1];
+
+            for (size_t edge = graph->incomingOffsets[vertex]; edge < rowEnd; edge++)
+            {
+                (*edgesExamined)++;
+
+                if (testBit(&scratch->frontier, graph->incomingNodes[edge]))
+                {
+                    setBit(&scratch->nextFrontier, vertex);
+                    scratch->candidates[nextCount++] = vertex;
+                    pendingInEdges += getInDegree(graph, vertex);
+                    break;
+                }
+            }
+        }
+    }
+
+    scratch->pendingInEdges = pendingInEdges;
+
+    return nextCount;
+}
+
+/*
+ * @brief Compare stragglers by discovering edge
+ * 
+ * @param void pointer (first straggler)
+ * @param void pointer (second straggler)
+ * @return int (qsort ordering)
+ * 
+ */
+static int compareStragglers(const void *first, const void *second)
+{
+    const Straggler *firstStraggler = (const Straggler *)first;
+    const Straggler *secondStraggler = (const Straggler *)second;
+
+    if (firstStraggler->parentRank != secondStraggler->parentRank)
+    {
+        return firstStraggler->parentRank < secondStraggler->parentRank ? -1 : 1;
+    }
+
+    if (firstStraggler->position != secondStraggler->position)
+    {
+        return firstStraggler->position < secondStraggler->position ? -1 : 1;
+    }
+
+    return 0;
+}
+
+/*
+ * @brief Place vertices the frontier scan did not reach
+ * 
+ * Every unplaced vertex scans its incoming edges for
+ * the earliest one from the frontier, ranked by the
+ * predecessor's path index and then by the edge's
+ * position in the predecessor's row. Sorting by that
+ * edge gives exactly the top-down discovery order
+ * 
+ * @param Graph (pointer*)
+ * @param Bitmap (pointer*) => visited
+ * @param BottomUpScratch (pointer*)
+ * @param VertexId pointer [array] (traversal path)
+ * @param unsigned int (path index where the frontier scan stopped)
+ * @param unsigned int (current path length)
+ * @param unsigned int (size of next frontier)
+ * @param size_t (pointer*) => out degree sum of the next frontier, added to
+ * @param size_t (pointer*) => edges examined counter
+ * @return unsigned int (end of next frontier in path)
+ * 
+ */
+static unsigned int placeStragglers
+(
+    const Graph *graph,
+    Bitmap *visited,
+    BottomUpScratch *scratch,
+    VertexId *traversalPath,
+    unsigned int scanStart,
+    unsigned int pathLength,
+    unsigned int nextCount,
+    size_t *scoutCount,
+    size_t *edgesExamined
+)
+{
+    unsigned int noOfStragglers = 0;
+
+    for (unsigned int index = 0; index < nextCount; index++)
+    {
+        if (testBit(&scratch->nextFrontier, scratch->candidates[index]))
+        {
+            noOfStragglers++;
+        }
+    }
+
+    Straggler *stragglers = (Straggler *)malloc(noOfStragglers * sizeof(Straggler));
+
+    if (stragglers == NULL)
+    {
+        perror("Failed to allocate memory\n");
+        exit(EXIT_FAILURE);
+    }
+
+    unsigned int stragglerIndex = 0;
+
+    // earliest frontier edge decides the discovery order
+    for (unsigned int index = 0; index < nextCount; index++)
+    {
+        VertexId vertex = scratch->candidates[index];
+
+        if (!testBit(&scratch->nextFrontier, vertex))
+        {
+            continue;
+        }
+
+        VertexId parentRank = INVALID_VERTEX;
+        unsigned int position = 0;
+        size_t rowEnd = graph->incomingOffsets[vertex + 1];
+
+        *edgesExamined += rowEnd - graph->incomingOffsets[vertex];
+
+        for (size_t edge = graph->incomingOffsets[vertex]; edge < rowEnd; edge++)
+        {
+            VertexId rank = scratch->frontierRank[graph->incomingNodes[edge]];
+
+            if
+            (
+                rank != INVALID_VERTEX && rank >= scanStart &&
+                (rank < parentRank || (rank == parentRank && graph->incomingPositions[edge] < position))
+            )
+            {
+                parentRank = rank;
+                position = graph->incomingPositions[edge];
+            }
+        }
+
+        stragglers[stragglerIndex].parentRank = parentRank;
+        stragglers[stragglerIndex].position = position;
+        stragglers[stragglerIndex].vertex = vertex;
+        stragglerIndex++;
+    }
+
+    qsort(stragglers, noOfStragglers, sizeof(Straggler), compareStragglers);
+
+    size_t nextScoutCount = 0;
+
+    for (unsigned int index = 0; index < noOfStragglers; index++)
+    {
+        VertexId vertex = stragglers[index].vertex;
+
+        clearBit(&scratch->nextFrontier, vertex);
+        setBit(visited, vertex);
+        traversalPath[pathLength++] = vertex;
+        nextScoutCount += getOutDegree(graph, vertex);
+    }
+
+    free(stragglers);
+
+    *scoutCount += nextScoutCount;
+
+    return pathLength;
+}
+
+/*
+ * @brief Order the level found by a bottom-up step
+ * 
+ * Appends the next frontier to the path in the
+ * order a top-down step would have discovered it.
+ * Frontier vertices are scanned in path order until
+ * the vertices still unplaced have fewer incoming
+ * edges than the frontier has outgoing edges left.
+ * The remaining vertices are then placed as stragglers
+ * 
+ * @param Graph (pointer*)
+ * @param Bitmap (pointer*) => visited
+ * @param BottomUpScratch (pointer*)
+ * @param VertexId pointer [array] (traversal path)
+ * @param unsigned int (start of frontier in path)
+ * @param unsigned int (end of frontier in path)
+ * @param unsigned int (size of next frontier)
+ * @param size_t (pointer*) => receives out degree sum of the next frontier
+ * @param size_t (pointer*) => edges examined counter
+ * @return unsigned int (end of next frontier in path)
+ * 
+ */
+static unsigned int orderNextLevel
+(
+    const Graph *graph,
+    Bitmap *visited,
+    BottomUpScratch *scratch,
+    VertexId *traversalPath,
+    unsigned int levelStart,
+    unsigned int levelEnd,
+    unsigned int nextCount,
+    size_t *scoutCount,
+    size_t *edgesExamined
+)
+{
+    unsigned int pathLength = levelEnd;
+    unsigned int nextEnd = levelEnd + nextCount;
+    size_t nextScoutCount = 0;
+    size_t remainingFrontierEdges = 0;
+
+    for (unsigned int index = levelStart; index < levelEnd; index++)
+    {
+        remainingFrontierEdges += getOutDegree(graph, traversalPath[index]);
+    }
+
+    unsigned int index = levelStart;
+
+    while (index < levelEnd && pathLength < nextEnd)
+    {
+        // cheaper to resolve the rest through their incoming edges
+        if (scratch->pendingInEdges < remainingFrontierEdges)
+        {
+            break;
+        }
+
+        VertexId frontierNode = traversalPath[index];
+        size_t rowEnd = graph->edgeOffsets[frontierNode + 1];
+
+        for (size_t edge = graph->edgeOffsets[frontierNode]; edge < rowEnd; edge++)
+        {
+            VertexId adjacentNode = graph->adjacentNodes[edge];
+
+            (*edgesExamined)++;
+
+            if (testBit(&scratch->nextFrontier, adjacentNode))
+            {
+                clearBit(&scratch->nextFrontier, adjacentNode);
+                setBit(visited, adjacentNode);
+                traversalPath[pathLength++] = adjacentNode;
+                nextScoutCount += getOutDegree(graph, adjacentNode);
+                scratch->pendingInEdges -= getInDegree(graph, adjacentNode);
+            }
+        }
+
+        remainingFrontierEdges -= getOutDegree(graph, frontierNode);
+        index++;
+    }
+
+    *scoutCount = nextScoutCount;
+
+    if (pathLength < nextEnd)
+    {
+        pathLength = placeStragglers
+        (
+            graph, visited, scratch, traversalPath,
+            index, pathLength, nextCount, scoutCount, edgesExamined
+        );
+    }
+
+    return pathLength;
+}
+
+/*
+ * @brief Direction optimizing breadth first search
+ * 
+ * Level synchronous bfs that runs top-down steps while
+ * the frontier is small and bottom-up steps while it is
+ * large. The path doubles as the queue, each level being
+ * a contiguous slice of it, so the resulting order is the
+ * same as the top-down bfs
+ * 
+ * @param Graph (pointer*)
+ * @param TraversalOptions (pointer*)
+ * @param Bitmap (pointer*) => visited, all clear on entry
+ * @param VertexId pointer [array] (traversal path, room for every node)
+ * @param size_t (pointer*) => receives number of edges examined
+ * @return unsigned int (traversal length)
+ * 
+ * @note Builds the incoming arrays of the graph if missing
+ * 
+ */
+unsigned int directionOptimizingTraversal
+(
+    Graph *graph,
+    const TraversalOptions *options,
+    Bitmap *visited,
+    VertexId *traversalPath,
+    size_t *edgesExamined
+)
+{
+    *edgesExamined = 0;
+
+    if (graph->noOfNodes == 0)
+    {
+        return 0;
+    }
+
+    buildIncomingArrays(graph);
+
+    BottomUpScratch scratch;
+    initBitmap(&scratch.frontier, graph->noOfNodes);
+    initBitmap(&scratch.nextFrontier, graph->noOfNodes);
+    scratch.frontierRank = (VertexId *)malloc(graph->noOfNodes * sizeof(VertexId));
+    scratch.candidates = (VertexId *)malloc(graph->noOfNodes * sizeof(VertexId));
+    scratch.pendingInEdges = 0;
+
+    if (scratch.frontierRank == NULL || scratch.candidates == NULL)
+    {
+        perror("Failed to allocate memory\n");
+        exit(EXIT_FAILURE);
+    }
+
+    for (size_t index = 0; index < graph->noOfNodes; index++)
+    {
+        scratch.frontierRank[index] = INVALID_VERTEX;
+    }
+
+    // traversal starts from the first node in the node list
+    unsigned int levelStart = 0;
+    unsigned int levelEnd = 1;
+    traversalPath[0] = getListedVertex(graph, 0);
+    setBit(visited, traversalPath[0]);
+
+    size_t scoutCount = getOutDegree(graph, traversalPath[0]);
+    size_t edgesToCheck = graph->noOfEdges - scoutCount;
+    unsigned int previousFrontierSize = 0;
+    unsigned int level = 0;
+    bool bottomUp = false;
+
+    while (levelStart < levelEnd)
+    {
+        unsigned int frontierSize = levelEnd - levelStart;
+
+        visitLevel(options->visitor, traversalPath, levelStart, levelEnd, level++);
+
+        if (bottomUp)
+        {
+            // leave bottom-up once the frontier is shrinking and small
+            if (frontierSize < previousFrontierSize && frontierSize <= graph->noOfNodes / options->beta)
+            {
+                bottomUp = false;
+            }
+        }
+        else if (scoutCount > edgesToCheck / options->alpha)
+        {
+            bottomUp = true;
+        }
+
+        unsigned int nextEnd;
+
+        PROFILE_LEVEL(options->profile, frontierSize, *edgesExamined, levelEnd, bottomUp);
+
+        if (bottomUp)
+        {
+            for (unsigned int index = levelStart; index < levelEnd; index++)
+            {
+                setBit(&scratch.frontier, traversalPath[index]);
+                scratch.frontierRank[traversalPath[index]] = index;
+            }
+
+            unsigned int nextCount = bottomUpStep(graph, visited, &scratch, edgesExamined);
+
+            nextEnd = orderNextLevel
+            (
+                graph, visited, &scratch, traversalPath,
+                levelStart, levelEnd, nextCount, &scoutCount, edgesExamined
+            );
+
+            for (unsigned int index = levelStart; index < levelEnd; index++)
+            {
+                clearBit(&scratch.frontier, traversalPath[index]);
+                scratch.frontierRank[traversalPath[index]] = INVALID_VERTEX;
+            }
+        }
+        else
+        {
+            nextEnd = topDownStep
+            (
+                graph, visited, traversalPath, levelStart, levelEnd, &scoutCount, edgesExamined
+            );
+        }
+
+        // out degree of the new frontier is no longer unexplored
+        edgesToCheck = edgesToCheck > scoutCount ? edgesToCheck - scoutCount : 0;
+
+        previousFrontierSize = frontierSize;
+        levelStart = levelEnd;
+        levelEnd = nextEnd;
+    }
+
+    PROFILE_FINISH(options->profile, *edgesExamined, levelEnd);
+
+    freeBitmap(&scratch.frontier);
+    freeBitmap(&scratch.nextFrontier);
+    free(scratch.frontierRank);
+    free(scratch.candidates);
+
+    return levelEnd;
+}
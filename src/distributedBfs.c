@@ -0,0 +1,1057 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include "distributedBfs.h"
+#include "bfsVisitor.h"
+#include "bitmap.h"
+#include "graphBuilder.h"
+#include "reorder.h"
+#include "types.h"
+
+/*
+ * @brief Vertex buffer data structure
+ *
+ * @member VertexId pointer [array] (vertices)
+ * @member size_t (length) => vertices in the buffer
+ * @member size_t (capacity) => vertices that fit before growing
+ *
+ */
+typedef struct VertexBuffer {
+    VertexId *vertices;
+    size_t length;
+    size_t capacity;
+} VertexBuffer;
+
+/*
+ * @brief Peer channel data structure
+ *
+ * PeerChannel struct is one end of the socket
+ * between two workers. Every level each worker
+ * sends every other worker one batch, a vertex
+ * count followed by the vertices, even when it
+ * is empty, so both know when the level is done
+ *
+ * @member int (file descriptor) => non-blocking socket to the peer
+ * @member VertexBuffer (outgoing) => batch for the peer, the count in its first slot
+ * @member size_t (bytes written) => part of the outgoing batch already sent
+ * @member uint32_t (incoming length) => vertices in the peer's batch
+ * @member size_t (header bytes read) => part of the incoming count already read
+ * @member VertexBuffer (incoming) => batch from the peer
+ * @member size_t (bytes read) => part of the incoming vertices already read
+ *
+ */
+typedef struct PeerChannel {
+    int fileDescriptor;
+    VertexBuffer outgoing;
+    size_t bytesWritten;
+    uint32_t incomingLength;
+    size_t headerBytesRead;
+    VertexBuffer incoming;
+    size_t bytesRead;
+} PeerChannel;
+
+/*
+ * @brief Level report data structure
+ *
+ * LevelReport struct is what a worker sends the
+ * coordinator after each level, followed by the
+ * vertices it claimed
+ *
+ * @member size_t (number of claimed vertices) => vertices of the next level the worker owns
+ * @member size_t (edges examined)
+ * @member LevelTraffic (traffic) => what the worker sent, level size unused
+ *
+ */
+typedef struct LevelReport {
+    size_t noOfClaimed;
+    size_t edgesExamined;
+    LevelTraffic traffic;
+} LevelReport;
+
+/*
+ * @brief Worker state data structure
+ *
+ * WorkerState struct is everything one worker
+ * process keeps. A worker owns a range of vertex
+ * ids and only ever reads the rows and visited
+ * bits of its own vertices
+ *
+ * @member Graph (pointer*) => graph loaded before the workers were forked
+ * @member unsigned int (worker index)
+ * @member unsigned int (number of workers)
+ * @member VertexId pointer [array] (first vertices) => first vertex of each worker, then the number of nodes
+ * @member Bitmap (visited) => owned vertices reached so far
+ * @member Bitmap (sent) => vertices of other workers already handed off
+ * @member VertexBuffer (frontier) => owned vertices of the level being expanded
+ * @member VertexBuffer (next) => owned vertices claimed for the next level
+ * @member PeerChannel pointer [array] (peers) => one per worker, own entry unused
+ * @member int (coordinator) => socket to the coordinator
+ *
+ */
+typedef struct WorkerState {
+    const Graph *graph;
+    unsigned int workerIndex;
+    unsigned int noOfWorkers;
+    const VertexId *firstVertices;
+    Bitmap visited;
+    Bitmap sent;
+    VertexBuffer frontier;
+    VertexBuffer next;
+    PeerChannel *peers;
+    int coordinator;
+} WorkerState;
+
+/*
+ * @brief declarations for internal functions
+ *
+ * List of static functions local to this file
+ * Meant to be used in this file only
+ *
+ * @note all internal functions are static
+ */
+static void pushVertex(VertexBuffer *buffer, VertexId vertex);
+static bool sendFully(int fileDescriptor, const void *data, size_t length);
+static bool receiveFully(int fileDescriptor, void *data, size_t length);
+static void failWorker(const char *message);
+static unsigned int findOwner(const WorkerState *state, VertexId vertex);
+static void expandFrontier(WorkerState *state, LevelReport *report);
+static bool writeBatch(PeerChannel *peer);
+static bool readBatch(PeerChannel *peer);
+static void exchangeBatches(WorkerState *state, LevelTraffic *traffic);
+static void claimReceived(WorkerState *state);
+static void runWorker
+(
+    const Graph *graph,
+    const VertexId *firstVertices,
+    unsigned int workerIndex,
+    unsigned int noOfWorkers,
+    const int *peerSockets,
+    int coordinator
+);
+static void closeOtherSockets
+(
+    const int *peerSockets,
+    const int *workerSockets,
+    unsigned int noOfWorkers,
+    unsigned int workerIndex
+);
+static void recordLevel
+(
+    DistributedTraversalStats *stats,
+    unsigned int *capacity,
+    const LevelTraffic *traffic
+);
+static unsigned int collectReports
+(
+    const int *coordinatorSockets,
+    unsigned int noOfWorkers,
+    VertexId *traversalPath,
+    unsigned int rear,
+    unsigned int noOfNodes,
+    LevelTraffic *traffic,
+    DistributedTraversalStats *stats
+);
+
+/*
+ * @brief Push a vertex to a buffer
+ *
+ * @param VertexBuffer (pointer*)
+ * @param VertexId (vertex)
+ * @return void
+ *
+ */
+static void pushVertex(VertexBuffer *buffer, VertexId vertex)
+{
+    if (buffer->length == buffer->capacity)
+    {
+        size_t newCapacity = buffer->capacity == 0 ? 256 : buffer->capacity * 2;
+        VertexId *newVertices = (VertexId *)realloc(buffer->vertices, newCapacity * sizeof(VertexId));
+
+        if (newVertices == NULL)
+        {
+            perror("Failed to allocate memory\n");
+            exit(EXIT_FAILURE);
+        }
+
+        buffer->vertices = newVertices;
+        buffer->capacity = newCapacity;
+    }
+
+    buffer->vertices[buffer->length++] = vertex;
+}
+
+/*
+ * @brief Send a whole message on a blocking socket
+ *
+ * @param int (file descriptor)
+ * @param void pointer (data)
+ * @param size_t (length in bytes)
+ * @return bool (false if the other side is gone)
+ *
+ */
+static bool sendFully(int fileDescriptor, const void *data, size_t length)
+{
+    const char *bytes = (const char *)data;
+
+    while (length > 0)
+    {
+        ssize_t bytesSent = send(fileDescriptor, bytes, length, MSG_NOSIGNAL);
+
+        if (bytesSent < 0 && errno == EINTR)
+        {
+            continue;
+        }
+
+        if (bytesSent <= 0)
+        {
+            return false;
+        }
+
+        bytes += bytesSent;
+        length -= (size_t)bytesSent;
+    }
+
+    return true;
+}
+
+/*
+ * @brief Receive a whole message on a blocking socket
+ *
+ * @param int (file descriptor)
+ * @param void pointer (data)
+ * @param size_t (length in bytes)
+ * @return bool (false if the other side is gone)
+ *
+ */
+static bool receiveFully(int fileDescriptor, void *data, size_t length)
+{
+    char *bytes = (char *)data;
+
+    while (length > 0)
+    {
+        ssize_t bytesReceived = recv(fileDescriptor, bytes, length, 0);
+
+        if (bytesReceived < 0 && errno == EINTR)
+        {
+            continue;
+        }
+
+        if (bytesReceived <= 0)
+        {
+            return false;
+        }
+
+        bytes += bytesReceived;
+        length -= (size_t)bytesReceived;
+    }
+
+    return true;
+}
+
+/*
+ * @brief End a worker process that cannot go on
+ *
+ * The coordinator sees the closed socket
+ *
+ * @param char pointer [array] (message)
+ * @return void
+ *
+ */
+static void failWorker(const char *message)
+{
+    perror(message);
+    _exit(EXIT_FAILURE);
+}
+
+/*
+ * @brief Find the worker that owns a vertex
+ *
+ * @param WorkerState (pointer*)
+ * @param VertexId (vertex)
+ * @return unsigned int (worker index)
+ *
+ */
+static unsigned int findOwner(const WorkerState *state, VertexId vertex)
+{
+    unsigned int owner = 0;
+
+    while (vertex >= state->firstVertices[owner + 1])
+    {
+        owner++;
+    }
+
+    return owner;
+}
+
+/*
+ * @brief Expand the worker's part of the level
+ *
+ * Owned neighbours are claimed right away. The
+ * others go to the batch of their owner, once:
+ * a vertex handed off before has reached its
+ * owner already, so sending it again is dropped
+ *
+ * @param WorkerState (pointer*)
+ * @param LevelReport (pointer*) => counts edges and dropped duplicates
+ * @return void
+ *
+ */
+static void expandFrontier(WorkerState *state, LevelReport *report)
+{
+    const Graph *graph = state->graph;
+    VertexId firstOwned = state->firstVertices[state->workerIndex];
+    VertexId lastOwned = state->firstVertices[state->workerIndex + 1];
+
+    for (size_t index = 0; index < state->frontier.length; index++)
+    {
+        VertexId frontierNode = state->frontier.vertices[index];
+        size_t rowEnd = graph->edgeOffsets[frontierNode + 1];
+
+        report->edgesExamined += rowEnd - graph->edgeOffsets[frontierNode];
+
+        for (size_t edge = graph->edgeOffsets[frontierNode]; edge < rowEnd; edge++)
+        {
+            VertexId adjacentNode = graph->adjacentNodes[edge];
+
+            if (adjacentNode >= firstOwned && adjacentNode < lastOwned)
+            {
+                if (!testBit(&state->visited, adjacentNode))
+                {
+                    setBit(&state->visited, adjacentNode);
+                    pushVertex(&state->next, adjacentNode);
+                }
+            }
+            else if (testBit(&state->sent, adjacentNode))
+            {
+                report->traffic.duplicatesDropped++;
+            }
+            else
+            {
+                setBit(&state->sent, adjacentNode);
+                pushVertex(&state->peers[findOwner(state, adjacentNode)].outgoing, adjacentNode);
+            }
+        }
+    }
+}
+
+/*
+ * @brief Write as much of a batch as the socket takes
+ *
+ * @param PeerChannel (pointer*)
+ * @return bool (true once the whole batch is sent)
+ *
+ */
+static bool writeBatch(PeerChannel *peer)
+{
+    size_t batchBytes = peer->outgoing.length * sizeof(VertexId);
+
+    while (peer->bytesWritten < batchBytes)
+    {
+        ssize_t bytesSent = send
+        (
+            peer->fileDescriptor, (const char *)peer->outgoing.vertices + peer->bytesWritten,
+            batchBytes - peer->bytesWritten, MSG_NOSIGNAL
+        );
+
+        if (bytesSent < 0 && errno == EINTR)
+        {
+            continue;
+        }
+
+        if (bytesSent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+        {
+            return false;
+        }
+
+        if (bytesSent <= 0)
+        {
+            failWorker("Failed to send batch\n");
+        }
+
+        peer->bytesWritten += (size_t)bytesSent;
+    }
+
+    return true;
+}
+
+/*
+ * @brief Read as much of a batch as has arrived
+ *
+ * @param PeerChannel (pointer*)
+ * @return bool (true once the whole batch is read)
+ *
+ */
+static bool readBatch(PeerChannel *peer)
+{
+    while (true)
+    {
+        char *target;
+        size_t remaining;
+
+        if (peer->headerBytesRead < sizeof(uint32_t))
+        {
+            target = (char *)&peer->incomingLength + peer->headerBytesRead;
+            remaining = sizeof(uint32_t) - peer->headerBytesRead;
+        }
+        else
+        {
+            remaining = peer->incomingLength * sizeof(VertexId) - peer->bytesRead;
+
+            if (remaining == 0)
+            {
+                peer->incoming.length = peer->incomingLength;
+                return true;
+            }
+
+            target = (char *)peer->incoming.vertices + peer->bytesRead;
+        }
+
+        ssize_t bytesReceived = recv(peer->fileDescriptor, target, remaining, 0);
+
+        if (bytesReceived < 0 && errno == EINTR)
+        {
+            continue;
+        }
+
+        if (bytesReceived < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+        {
+            return false;
+        }
+
+        if (bytesReceived <= 0)
+        {
+            failWorker("Failed to receive batch\n");
+        }
+
+        if (peer->headerBytesRead < sizeof(uint32_t))
+        {
+            peer->headerBytesRead += (size_t)bytesReceived;
+
+            if (peer->headerBytesRead == sizeof(uint32_t) && peer->incomingLength > peer->incoming.capacity)
+            {
+                VertexId *vertices = (VertexId *)realloc
+                (
+                    peer->incoming.vertices, peer->incomingLength * sizeof(VertexId)
+                );
+
+                if (vertices == NULL)
+                {
+                    perror("Failed to allocate memory\n");
+                    exit(EXIT_FAILURE);
+                }
+
+                peer->incoming.vertices = vertices;
+                peer->incoming.capacity = peer->incomingLength;
+            }
+        }
+        else
+        {
+            peer->bytesRead += (size_t)bytesReceived;
+        }
+    }
+}
+
+/*
+ * @brief Swap batches with every other worker
+ *
+ * Sends and receives at the same time, so two
+ * workers sending each other large batches
+ * never wait on each other
+ *
+ * @param WorkerState (pointer*)
+ * @param LevelTraffic (pointer*) => counts what was sent
+ * @return void
+ *
+ */
+static void exchangeBatches(WorkerState *state, LevelTraffic *traffic)
+{
+    unsigned int noOfWorkers = state->noOfWorkers;
+    struct pollfd *pollSockets = (struct pollfd *)malloc(noOfWorkers * sizeof(struct pollfd));
+    unsigned int *pollPeers = (unsigned int *)malloc(noOfWorkers * sizeof(unsigned int));
+    bool *sending = (bool *)malloc(noOfWorkers * sizeof(bool));
+    bool *receiving = (bool *)malloc(noOfWorkers * sizeof(bool));
+
+    if (pollSockets == NULL || pollPeers == NULL || sending == NULL || receiving == NULL)
+    {
+        perror("Failed to allocate memory\n");
+        exit(EXIT_FAILURE);
+    }
+
+    unsigned int pending = 0;
+
+    for (unsigned int worker = 0; worker < noOfWorkers; worker++)
+    {
+        PeerChannel *peer = &state->peers[worker];
+
+        sending[worker] = receiving[worker] = worker != state->workerIndex;
+
+        if (worker == state->workerIndex)
+        {
+            continue;
+        }
+
+        size_t batchLength = peer->outgoing.length - 1;
+
+        peer->outgoing.vertices[0] = (VertexId)batchLength;
+        peer->bytesWritten = 0;
+        peer->headerBytesRead = 0;
+        peer->bytesRead = 0;
+        peer->incoming.length = 0;
+        pending += 2;
+
+        traffic->batches += batchLength > 0;
+        traffic->verticesSent += batchLength;
+        traffic->bytesSent += peer->outgoing.length * sizeof(VertexId);
+    }
+
+    while (pending > 0)
+    {
+        unsigned int noOfPolled = 0;
+
+        for (unsigned int worker = 0; worker < noOfWorkers; worker++)
+        {
+            if (sending[worker] || receiving[worker])
+            {
+                pollSockets[noOfPolled].fd = state->peers[worker].fileDescriptor;
+                pollSockets[noOfPolled].events = (short)((sending[worker] ? POLLOUT : 0) | (receiving[worker] ? POLLIN : 0));
+                pollSockets[noOfPolled].revents = 0;
+                pollPeers[noOfPolled++] = worker;
+            }
+        }
+
+        if (poll(pollSockets, noOfPolled, -1) < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            failWorker("Failed to wait for batches\n");
+        }
+
+        for (unsigned int index = 0; index < noOfPolled; index++)
+        {
+            unsigned int worker = pollPeers[index];
+            short events = pollSockets[index].revents;
+
+            if (sending[worker] && (events & (POLLOUT | POLLERR | POLLHUP)) && writeBatch(&state->peers[worker]))
+            {
+                sending[worker] = false;
+                pending--;
+            }
+
+            if (receiving[worker] && (events & (POLLIN | POLLERR | POLLHUP)) && readBatch(&state->peers[worker]))
+            {
+                receiving[worker] = false;
+                pending--;
+            }
+        }
+    }
+
+    for (unsigned int worker = 0; worker < noOfWorkers; worker++)
+    {
+        // the first slot stays reserved for the batch length
+        if (worker != state->workerIndex)
+        {
+            state->peers[worker].outgoing.length = 1;
+        }
+    }
+
+    free(pollSockets);
+    free(pollPeers);
+    free(sending);
+    free(receiving);
+}
+
+/*
+ * @brief Claim the vertices other workers handed off
+ *
+ * Batches are taken in worker order, so every run
+ * with the same number of workers gives the same path
+ *
+ * @param WorkerState (pointer*)
+ * @return void
+ *
+ */
+static void claimReceived(WorkerState *state)
+{
+    for (unsigned int worker = 0; worker < state->noOfWorkers; worker++)
+    {
+        PeerChannel *peer = &state->peers[worker];
+
+        for (size_t index = 0; index < peer->incoming.length; index++)
+        {
+            VertexId vertex = peer->incoming.vertices[index];
+
+            if (!testBit(&state->visited, vertex))
+            {
+                setBit(&state->visited, vertex);
+                pushVertex(&state->next, vertex);
+            }
+        }
+    }
+}
+
+/*
+ * @brief Worker process body
+ *
+ * Expands its own vertices level by level,
+ * swapping batches with the other workers and
+ * reporting to the coordinator, until the
+ * coordinator says the traversal is over
+ *
+ * @param Graph (pointer*)
+ * @param VertexId pointer [array] (first vertices) => ownership ranges
+ * @param unsigned int (worker index)
+ * @param unsigned int (number of workers)
+ * @param int pointer [array] (peer sockets) => the worker's row of the socket matrix
+ * @param int (coordinator socket)
+ * @return void
+ *
+ * @note Never returns, the process exits
+ *
+ */
+static void runWorker
+(
+    const Graph *graph,
+    const VertexId *firstVertices,
+    unsigned int workerIndex,
+    unsigned int noOfWorkers,
+    const int *peerSockets,
+    int coordinator
+)
+{
+    WorkerState state;
+    state.graph = graph;
+    state.workerIndex = workerIndex;
+    state.noOfWorkers = noOfWorkers;
+    state.firstVertices = firstVertices;
+    state.coordinator = coordinator;
+    initBitmap(&state.visited, graph->noOfNodes);
+    initBitmap(&state.sent, graph->noOfNodes);
+    memset(&state.frontier, 0, sizeof(VertexBuffer));
+    memset(&state.next, 0, sizeof(VertexBuffer));
+    state.peers = (PeerChannel *)calloc(noOfWorkers, sizeof(PeerChannel));
+
+    if (state.peers == NULL)
+    {
+        perror("Failed to allocate memory\n");
+        exit(EXIT_FAILURE);
+    }
+
+    for (unsigned int worker = 0; worker < noOfWorkers; worker++)
+    {
+        PeerChannel *peer = &state.peers[worker];
+
+        peer->fileDescriptor = peerSockets[worker];
+
+        if (worker != workerIndex)
+        {
+            fcntl(peer->fileDescriptor, F_SETFL, fcntl(peer->fileDescriptor, F_GETFL) | O_NONBLOCK);
+            pushVertex(&peer->outgoing, 0);
+        }
+    }
+
+    VertexId source = getListedVertex(graph, 0);
+
+    if (findOwner(&state, source) == workerIndex)
+    {
+        setBit(&state.visited, source);
+        pushVertex(&state.frontier, source);
+    }
+
+    uint32_t proceed = 1;
+
+    while (proceed)
+    {
+        LevelReport report;
+        memset(&report, 0, sizeof(report));
+
+        expandFrontier(&state, &report);
+        exchangeBatches(&state, &report.traffic);
+        claimReceived(&state);
+
+        report.noOfClaimed = state.next.length;
+
+        if
+        (
+            !sendFully(coordinator, &report, sizeof(report)) ||
+            !sendFully(coordinator, state.next.vertices, state.next.length * sizeof(VertexId)) ||
+            !receiveFully(coordinator, &proceed, sizeof(proceed))
+        )
+        {
+            failWorker("Lost the coordinator\n");
+        }
+
+        VertexBuffer expanded = state.frontier;
+        state.frontier = state.next;
+        state.next = expanded;
+        state.next.length = 0;
+    }
+
+    _exit(EXIT_SUCCESS);
+}
+
+/*
+ * @brief Close the sockets a worker does not use
+ *
+ * @param int pointer [array] (peer sockets) => worker by worker matrix
+ * @param int pointer [array] (worker sockets) => worker ends of the coordinator sockets
+ * @param unsigned int (number of workers)
+ * @param unsigned int (worker index) => worker keeping its own sockets
+ * @return void
+ *
+ */
+static void closeOtherSockets
+(
+    const int *peerSockets,
+    const int *workerSockets,
+    unsigned int noOfWorkers,
+    unsigned int workerIndex
+)
+{
+    for (unsigned int worker = 0; worker < noOfWorkers; worker++)
+    {
+        if (worker == workerIndex)
+        {
+            continue;
+        }
+
+        close(workerSockets[worker]);
+
+        for (unsigned int peer = 0; peer < noOfWorkers; peer++)
+        {
+            if (peer != worker)
+            {
+                close(peerSockets[(size_t)worker * noOfWorkers + peer]);
+            }
+        }
+    }
+}
+
+/*
+ * @brief Record the traffic of a level
+ *
+ * @param DistributedTraversalStats (pointer*)
+ * @param unsigned int (pointer*) => levels allocated
+ * @param LevelTraffic (pointer*)
+ * @return void
+ *
+ */
+static void recordLevel
+(
+    DistributedTraversalStats *stats,
+    unsigned int *capacity,
+    const LevelTraffic *traffic
+)
+{
+    if (stats->noOfLevels == *capacity)
+    {
+        *capacity = *capacity == 0 ? 16 : *capacity * 2;
+
+        LevelTraffic *levels = (LevelTraffic *)realloc(stats->levels, *capacity * sizeof(LevelTraffic));
+
+        if (levels == NULL)
+        {
+            perror("Failed to allocate memory\n");
+            exit(EXIT_FAILURE);
+        }
+
+        stats->levels = levels;
+    }
+
+    stats->levels[stats->noOfLevels++] = *traffic;
+}
+
+/*
+ * @brief Collect the level reports of every worker
+ *
+ * The claimed vertices go to the path in worker order
+ *
+ * @param int pointer [array] (coordinator sockets) => one per worker
+ * @param unsigned int (number of workers)
+ * @param VertexId pointer [array] (traversal path)
+ * @param unsigned int (rear) => vertices on the path
+ * @param unsigned int (number of nodes)
+ * @param LevelTraffic (pointer*) => receives the summed traffic
+ * @param DistributedTraversalStats (pointer*) => counts edges and report bytes
+ * @return unsigned int (new rear)
+ *
+ * @note Exits if a worker is gone or reports more vertices than the graph has
+ *
+ */
+static unsigned int collectReports
+(
+    const int *coordinatorSockets,
+    unsigned int noOfWorkers,
+    VertexId *traversalPath,
+    unsigned int rear,
+    unsigned int noOfNodes,
+    LevelTraffic *traffic,
+    DistributedTraversalStats *stats
+)
+{
+    for (unsigned int worker = 0; worker < noOfWorkers; worker++)
+    {
+        LevelReport report;
+
+        if
+        (
+            !receiveFully(coordinatorSockets[worker], &report, sizeof(report)) ||
+            report.noOfClaimed > noOfNodes - rear ||
+            !receiveFully
+            (
+                coordinatorSockets[worker], traversalPath + rear, report.noOfClaimed * sizeof(VertexId)
+            )
+        )
+        {
+            fprintf(stderr, "Worker process %u failed\n", worker);
+            exit(EXIT_FAILURE);
+        }
+
+        rear += (unsigned int)report.noOfClaimed;
+        stats->edgesExamined += report.edgesExamined;
+        stats->reportBytes += sizeof(report) + report.noOfClaimed * sizeof(VertexId);
+        traffic->batches += report.traffic.batches;
+        traffic->verticesSent += report.traffic.verticesSent;
+        traffic->bytesSent += report.traffic.bytesSent;
+        traffic->duplicatesDropped += report.traffic.duplicatesDropped;
+    }
+
+    return rear;
+}
+
+/*
+ * @brief Breadth First Search over worker processes
+ *
+ * Forks one worker per partition of the loaded
+ * graph. Each worker owns a range of vertices
+ * holding about the same number of edges. Every
+ * level the workers expand their own vertices,
+ * swap deduplicated batches of the neighbours the
+ * others own over unix sockets and report the
+ * vertices they claimed. The coordinator, the
+ * calling process, puts the reports together into
+ * the traversal path and ends the traversal once a
+ * level comes back empty
+ *
+ * @param Graph (pointer*) => plain adjacency arrays
+ * @param unsigned int (number of processes) => at most MAX_BFS_PROCESSES
+ * @param BfsVisitor (pointer*) => receives the levels and unreachable nodes, may be NULL
+ * @param DistributedTraversalStats (pointer*) => receives the traffic, free with
+ *                                                 freeDistributedTraversalStats
+ * @return void
+ *
+ * @note Each level lists the vertices of one worker after
+ *       the other; the path differs from the top-down one
+ *       only in the order within a level
+ *
+ */
+void runDistributedTraversal
+(
+    const Graph *graph,
+    unsigned int noOfProcesses,
+    const BfsVisitor *visitor,
+    DistributedTraversalStats *stats
+)
+{
+    memset(stats, 0, sizeof(DistributedTraversalStats));
+    stats->noOfProcesses = noOfProcesses;
+
+    if (graph->noOfNodes == 0)
+    {
+        return;
+    }
+
+    VertexId *firstVertices = (VertexId *)malloc((noOfProcesses + 1) * sizeof(VertexId));
+    int *peerSockets = (int *)malloc((size_t)noOfProcesses * noOfProcesses * sizeof(int));
+    int *coordinatorSockets = (int *)malloc(noOfProcesses * sizeof(int));
+    int *workerSockets = (int *)malloc(noOfProcesses * sizeof(int));
+    pid_t *workers = (pid_t *)malloc(noOfProcesses * sizeof(pid_t));
+    VertexId *traversalPath = (VertexId *)malloc((size_t)graph->noOfNodes * sizeof(VertexId));
+
+    if
+    (
+        firstVertices == NULL || peerSockets == NULL || coordinatorSockets == NULL ||
+        workerSockets == NULL || workers == NULL || traversalPath == NULL
+    )
+    {
+        perror("Failed to allocate memory\n");
+        exit(EXIT_FAILURE);
+    }
+
+    for (unsigned int worker = 0; worker < noOfProcesses; worker++)
+    {
+        firstVertices[worker] = graph->noOfEdges > 0
+            ? findEdgeBoundary(graph, graph->noOfEdges * worker / noOfProcesses)
+            : (VertexId)((size_t)graph->noOfNodes * worker / noOfProcesses);
+    }
+
+    firstVertices[noOfProcesses] = graph->noOfNodes;
+
+    for (unsigned int worker = 0; worker < noOfProcesses; worker++)
+    {
+        int sockets[2];
+
+        if (socketpair(AF_UNIX, SOCK_STREAM, 0, sockets) != 0)
+        {
+            perror("Failed to create socket\n");
+            exit(EXIT_FAILURE);
+        }
+
+        coordinatorSockets[worker] = sockets[0];
+        workerSockets[worker] = sockets[1];
+        peerSockets[(size_t)worker * noOfProcesses + worker] = -1;
+
+        for (unsigned int peer = worker + 1; peer < noOfProcesses; peer++)
+        {
+            if (socketpair(AF_UNIX, SOCK_STREAM, 0, sockets) != 0)
+            {
+                perror("Failed to create socket\n");
+                exit(EXIT_FAILURE);
+            }
+
+            peerSockets[(size_t)worker * noOfProcesses + peer] = sockets[0];
+            peerSockets[(size_t)peer * noOfProcesses + worker] = sockets[1];
+        }
+    }
+
+    // anything still buffered would be written again by every worker
+    fflush(stdout);
+    fflush(stderr);
+
+    for (unsigned int worker = 0; worker < noOfProcesses; worker++)
+    {
+        workers[worker] = fork();
+
+        if (workers[worker] < 0)
+        {
+            perror("Failed to create process\n");
+            exit(EXIT_FAILURE);
+        }
+
+        if (workers[worker] == 0)
+        {
+            for (unsigned int other = 0; other < noOfProcesses; other++)
+            {
+                close(coordinatorSockets[other]);
+            }
+
+            closeOtherSockets(peerSockets, workerSockets, noOfProcesses, worker);
+            runWorker
+            (
+                graph, firstVertices, worker, noOfProcesses,
+                peerSockets + (size_t)worker * noOfProcesses, workerSockets[worker]
+            );
+        }
+    }
+
+    closeOtherSockets(peerSockets, workerSockets, noOfProcesses, noOfProcesses);
+
+    unsigned int capacity = 0, level = 0;
+    unsigned int levelStart = 0, levelEnd = 1;
+
+    traversalPath[0] = getListedVertex(graph, 0);
+    visitLevel(visitor, traversalPath, 0, 1, 0);
+
+    while (true)
+    {
+        LevelTraffic traffic = { levelEnd - levelStart, 0, 0, 0, 0 };
+        unsigned int rear = collectReports
+        (
+            coordinatorSockets, noOfProcesses, traversalPath, levelEnd, graph->noOfNodes, &traffic, stats
+        );
+
+        recordLevel(stats, &capacity, &traffic);
+
+        uint32_t proceed = rear > levelEnd;
+
+        for (unsigned int worker = 0; worker < noOfProcesses; worker++)
+        {
+            if (!sendFully(coordinatorSockets[worker], &proceed, sizeof(proceed)))
+            {
+                fprintf(stderr, "Worker process %u failed\n", worker);
+                exit(EXIT_FAILURE);
+            }
+        }
+
+        if (!proceed)
+        {
+            break;
+        }
+
+        visitLevel(visitor, traversalPath, levelEnd, rear, ++level);
+        levelStart = levelEnd;
+        levelEnd = rear;
+    }
+
+    for (unsigned int worker = 0; worker < noOfProcesses; worker++)
+    {
+        int status;
+
+        close(coordinatorSockets[worker]);
+
+        if (waitpid(workers[worker], &status, 0) < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != EXIT_SUCCESS)
+        {
+            fprintf(stderr, "Worker process %u failed\n", worker);
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    stats->traversalLength = levelEnd;
+
+    if (visitor != NULL && visitor->onUnreachable != NULL)
+    {
+        Bitmap reached;
+        initBitmap(&reached, graph->noOfNodes);
+
+        for (unsigned int index = 0; index < levelEnd; index++)
+        {
+            setBit(&reached, traversalPath[index]);
+        }
+
+        // node list order, which a reordered graph no longer has by id
+        for (VertexId position = 0; position < graph->noOfNodes; position++)
+        {
+            VertexId vertex = getListedVertex(graph, position);
+
+            if (!testBit(&reached, vertex))
+            {
+                visitor->onUnreachable(vertex, visitor->context);
+            }
+        }
+
+        freeBitmap(&reached);
+    }
+
+    free(firstVertices);
+    free(peerSockets);
+    free(coordinatorSockets);
+    free(workerSockets);
+    free(workers);
+    free(traversalPath);
+}
+
+/*
+ * @brief Free distributed traversal stats struct
+ *
+ * @param DistributedTraversalStats (pointer*)
+ * @return void
+ *
+ */
+void freeDistributedTraversalStats(DistributedTraversalStats *stats)
+{
+    free(stats->levels);
+
+    stats->levels = NULL;
+    stats->noOfLevels = 0;
+}
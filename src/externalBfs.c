@@ -0,0 +1,503 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "externalBfs.h"
+#include "bfsVisitor.h"
+#include "bitmap.h"
+#include "graphSnapshot.h"
+#include "types.h"
+
+/*
+ * @brief Read sizes of the semi-external bfs
+ *
+ * Rows are read up to EXTERNAL_BUFFER_EDGES
+ * neighbours (4 MiB) at a time. Rows closer than
+ * EXTERNAL_GAP_EDGES (64 KiB) to the previous one
+ * are read together with the bytes in between,
+ * which is cheaper than seeking over them
+ *
+ */
+#define EXTERNAL_BUFFER_EDGES ((size_t)1 << 20)
+#define EXTERNAL_GAP_EDGES ((size_t)1 << 14)
+
+/*
+ * @brief Discovered vertex data structure
+ *
+ * @member uint64_t (key) => queue rank of the parent in the high half,
+ *                           position in the parent's row in the low half
+ * @member VertexId (vertex)
+ *
+ */
+typedef struct DiscoveredVertex {
+    uint64_t key;
+    VertexId vertex;
+} DiscoveredVertex;
+
+/*
+ * @brief External state data structure
+ *
+ * ExternalState struct is everything the
+ * semi-external bfs keeps in memory, a few bytes
+ * per vertex and one read buffer
+ *
+ * A level is expanded in ascending vertex order
+ * so the rows are read front to back. The key a
+ * vertex is discovered with says where the queue
+ * of the top-down traversal would have put it, so
+ * sorting a level by key gives the same path
+ *
+ * @member ExternalGraph (pointer*)
+ * @member Bitmap (visited) => vertices reached so far
+ * @member Bitmap (discovered) => vertices reached by the level being expanded
+ * @member uint64_t pointer [array] (keys) => smallest discovery key while a level is
+ *                                            expanded, rank in its level afterwards
+ * @member VertexId pointer [array] (traversal path) => vertices in top-down queue order
+ * @member unsigned int (rear) => vertices on the path
+ * @member VertexId pointer [array] (edges) => read buffer
+ * @member size_t (bytes read) => adjacency bytes read so far
+ * @member size_t (edges examined)
+ *
+ */
+typedef struct ExternalState {
+    const ExternalGraph *graph;
+    Bitmap visited;
+    Bitmap discovered;
+    uint64_t *keys;
+    VertexId *traversalPath;
+    unsigned int rear;
+    VertexId *edges;
+    size_t bytesRead;
+    size_t edgesExamined;
+} ExternalState;
+
+/*
+ * @brief declarations for internal functions
+ *
+ * List of static functions local to this file
+ * Meant to be used in this file only
+ *
+ * @note all internal functions are static
+ */
+static void initExternalState(ExternalState *state, const ExternalGraph *graph);
+static void freeExternalState(ExternalState *state);
+static int compareVertexIds(const void *first, const void *second);
+static int compareDiscoveredVertices(const void *first, const void *second);
+static void scanRow
+(
+    ExternalState *state,
+    VertexId vertex,
+    size_t firstEdge,
+    size_t lastEdge,
+    const VertexId *neighbours
+);
+static void readEdges(ExternalState *state, size_t firstEdge, size_t lastEdge);
+static void expandLevel(ExternalState *state, unsigned int levelStart, unsigned int levelEnd);
+static void orderLevel(ExternalState *state, unsigned int levelStart, unsigned int levelEnd);
+static void recordLevel
+(
+    ExternalTraversalStats *stats,
+    unsigned int *capacity,
+    unsigned int levelSize,
+    size_t bytesRead
+);
+
+/*
+ * @brief Initialize external state struct
+ *
+ * @param ExternalState (pointer*)
+ * @param ExternalGraph (pointer*)
+ * @return void
+ *
+ */
+static void initExternalState(ExternalState *state, const ExternalGraph *graph)
+{
+    unsigned int noOfNodes = graph->noOfNodes;
+
+    state->graph = graph;
+    initBitmap(&state->visited, noOfNodes);
+    initBitmap(&state->discovered, noOfNodes);
+    state->keys = (uint64_t *)malloc((size_t)noOfNodes * sizeof(uint64_t));
+    state->traversalPath = (VertexId *)malloc((size_t)noOfNodes * sizeof(VertexId));
+    state->rear = 0;
+    state->edges = (VertexId *)malloc(EXTERNAL_BUFFER_EDGES * sizeof(VertexId));
+    state->bytesRead = 0;
+    state->edgesExamined = 0;
+
+    if (state->keys == NULL || state->traversalPath == NULL || state->edges == NULL)
+    {
+        perror("Failed to allocate memory\n");
+        exit(EXIT_FAILURE);
+    }
+}
+
+/*
+ * @brief Free external state struct
+ *
+ * @param ExternalState (pointer*)
+ * @return void
+ *
+ */
+static void freeExternalState(ExternalState *state)
+{
+    freeBitmap(&state->visited);
+    freeBitmap(&state->discovered);
+    free(state->keys);
+    free(state->traversalPath);
+    free(state->edges);
+}
+
+/*
+ * @brief Compare vertex ids in ascending order
+ *
+ * @param void pointer (first vertex)
+ * @param void pointer (second vertex)
+ * @return int
+ *
+ */
+static int compareVertexIds(const void *first, const void *second)
+{
+    VertexId firstVertex = *(const VertexId *)first;
+    VertexId secondVertex = *(const VertexId *)second;
+
+    return (firstVertex > secondVertex) - (firstVertex < secondVertex);
+}
+
+/*
+ * @brief Compare discovered vertices by key
+ *
+ * @param void pointer (first discovered vertex)
+ * @param void pointer (second discovered vertex)
+ * @return int
+ *
+ */
+static int compareDiscoveredVertices(const void *first, const void *second)
+{
+    uint64_t firstKey = ((const DiscoveredVertex *)first)->key;
+    uint64_t secondKey = ((const DiscoveredVertex *)second)->key;
+
+    return (firstKey > secondKey) - (firstKey < secondKey);
+}
+
+/*
+ * @brief Scan part of a row that is in memory
+ *
+ * A vertex the level already discovered keeps
+ * the smaller of its keys, since the top-down
+ * queue puts it after whichever parent it
+ * dequeues first
+ *
+ * @param ExternalState (pointer*)
+ * @param VertexId (vertex) => owner of the row
+ * @param size_t (first edge)
+ * @param size_t (last edge, exclusive)
+ * @param VertexId pointer [array] (neighbours) => neighbours of the edges from first edge on
+ * @return void
+ *
+ */
+static void scanRow
+(
+    ExternalState *state,
+    VertexId vertex,
+    size_t firstEdge,
+    size_t lastEdge,
+    const VertexId *neighbours
+)
+{
+    size_t rowStart = state->graph->edgeOffsets[vertex];
+    uint64_t rank = state->keys[vertex] << 32;
+
+    for (size_t edge = firstEdge; edge < lastEdge; edge++)
+    {
+        VertexId adjacentNode = neighbours[edge - firstEdge];
+        uint64_t key = rank | (edge - rowStart);
+
+        if (!testBit(&state->visited, adjacentNode))
+        {
+            setBit(&state->visited, adjacentNode);
+            setBit(&state->discovered, adjacentNode);
+            state->keys[adjacentNode] = key;
+            state->traversalPath[state->rear++] = adjacentNode;
+        }
+        else if (testBit(&state->discovered, adjacentNode) && key < state->keys[adjacentNode])
+        {
+            state->keys[adjacentNode] = key;
+        }
+    }
+
+    state->edgesExamined += lastEdge - firstEdge;
+}
+
+/*
+ * @brief Read a range of edges into the buffer
+ *
+ * @param ExternalState (pointer*)
+ * @param size_t (first edge)
+ * @param size_t (last edge, exclusive) => at most EXTERNAL_BUFFER_EDGES past the first
+ * @return void
+ *
+ */
+static void readEdges(ExternalState *state, size_t firstEdge, size_t lastEdge)
+{
+    if (lastEdge > firstEdge)
+    {
+        readExternalEdges(state->graph, firstEdge, lastEdge - firstEdge, state->edges);
+        state->bytesRead += (lastEdge - firstEdge) * sizeof(VertexId);
+    }
+}
+
+/*
+ * @brief Expand one level
+ *
+ * Walks the level in ascending vertex order and
+ * reads nearby rows together, so the file is read
+ * front to back once per level at most
+ *
+ * @param ExternalState (pointer*)
+ * @param unsigned int (level start) => on the traversal path
+ * @param unsigned int (level end, exclusive)
+ * @return void
+ *
+ */
+static void expandLevel(ExternalState *state, unsigned int levelStart, unsigned int levelEnd)
+{
+    const size_t *edgeOffsets = state->graph->edgeOffsets;
+    unsigned int levelSize = levelEnd - levelStart;
+    VertexId *frontier = (VertexId *)malloc((size_t)levelSize * sizeof(VertexId));
+
+    if (frontier == NULL)
+    {
+        perror("Failed to allocate memory\n");
+        exit(EXIT_FAILURE);
+    }
+
+    memcpy(frontier, state->traversalPath + levelStart, (size_t)levelSize * sizeof(VertexId));
+    qsort(frontier, levelSize, sizeof(VertexId), compareVertexIds);
+
+    unsigned int index = 0;
+
+    while (index < levelSize)
+    {
+        size_t firstEdge = edgeOffsets[frontier[index]];
+        size_t lastEdge = edgeOffsets[frontier[index] + 1];
+        unsigned int batchEnd = index + 1;
+
+        while
+        (
+            batchEnd < levelSize &&
+            edgeOffsets[frontier[batchEnd] + 1] - firstEdge <= EXTERNAL_BUFFER_EDGES &&
+            edgeOffsets[frontier[batchEnd]] - lastEdge <= EXTERNAL_GAP_EDGES
+        )
+        {
+            lastEdge = edgeOffsets[frontier[batchEnd] + 1];
+            batchEnd++;
+        }
+
+        if (lastEdge - firstEdge <= EXTERNAL_BUFFER_EDGES)
+        {
+            readEdges(state, firstEdge, lastEdge);
+
+            for (unsigned int position = index; position < batchEnd; position++)
+            {
+                VertexId vertex = frontier[position];
+                size_t rowStart = edgeOffsets[vertex];
+
+                scanRow(state, vertex, rowStart, edgeOffsets[vertex + 1], state->edges + (rowStart - firstEdge));
+            }
+        }
+        else
+        {
+            // a row larger than the buffer is read a piece at a time
+            for (size_t chunkStart = firstEdge; chunkStart < lastEdge; chunkStart += EXTERNAL_BUFFER_EDGES)
+            {
+                size_t chunkEnd = lastEdge - chunkStart > EXTERNAL_BUFFER_EDGES
+                    ? chunkStart + EXTERNAL_BUFFER_EDGES : lastEdge;
+
+                readEdges(state, chunkStart, chunkEnd);
+                scanRow(state, frontier[index], chunkStart, chunkEnd, state->edges);
+            }
+        }
+
+        index = batchEnd;
+    }
+
+    free(frontier);
+}
+
+/*
+ * @brief Put a newly discovered level in queue order
+ *
+ * Sorts the level by discovery key and replaces
+ * every key with the vertex's rank in the level
+ *
+ * @param ExternalState (pointer*)
+ * @param unsigned int (level start) => on the traversal path
+ * @param unsigned int (level end, exclusive)
+ * @return void
+ *
+ */
+static void orderLevel(ExternalState *state, unsigned int levelStart, unsigned int levelEnd)
+{
+    unsigned int levelSize = levelEnd - levelStart;
+
+    if (levelSize == 0)
+    {
+        return;
+    }
+
+    DiscoveredVertex *level = (DiscoveredVertex *)malloc((size_t)levelSize * sizeof(DiscoveredVertex));
+
+    if (level == NULL)
+    {
+        perror("Failed to allocate memory\n");
+        exit(EXIT_FAILURE);
+    }
+
+    for (unsigned int index = 0; index < levelSize; index++)
+    {
+        VertexId vertex = state->traversalPath[levelStart + index];
+
+        level[index].key = state->keys[vertex];
+        level[index].vertex = vertex;
+    }
+
+    qsort(level, levelSize, sizeof(DiscoveredVertex), compareDiscoveredVertices);
+
+    for (unsigned int index = 0; index < levelSize; index++)
+    {
+        VertexId vertex = level[index].vertex;
+
+        state->traversalPath[levelStart + index] = vertex;
+        state->keys[vertex] = index;
+        clearBit(&state->discovered, vertex);
+    }
+
+    free(level);
+}
+
+/*
+ * @brief Append a level to the stats
+ *
+ * @param ExternalTraversalStats (pointer*)
+ * @param unsigned int (pointer*) => capacity of the level arrays
+ * @param unsigned int (level size)
+ * @param size_t (bytes read)
+ * @return void
+ *
+ */
+static void recordLevel
+(
+    ExternalTraversalStats *stats,
+    unsigned int *capacity,
+    unsigned int levelSize,
+    size_t bytesRead
+)
+{
+    if (stats->noOfLevels == *capacity)
+    {
+        *capacity = *capacity == 0 ? 16 : *capacity * 2;
+
+        unsigned int *levelSizes = (unsigned int *)realloc(stats->levelSizes, *capacity * sizeof(unsigned int));
+        size_t *levelBytesRead = (size_t *)realloc(stats->levelBytesRead, *capacity * sizeof(size_t));
+
+        if (levelSizes == NULL || levelBytesRead == NULL)
+        {
+            perror("Failed to allocate memory\n");
+            exit(EXIT_FAILURE);
+        }
+
+        stats->levelSizes = levelSizes;
+        stats->levelBytesRead = levelBytesRead;
+    }
+
+    stats->levelSizes[stats->noOfLevels] = levelSize;
+    stats->levelBytesRead[stats->noOfLevels] = bytesRead;
+    stats->noOfLevels++;
+}
+
+/*
+ * @brief Semi-external breadth first search
+ *
+ * Runs a bfs from the first node of a snapshot
+ * with only per vertex state in memory, reading
+ * the adjacency from the file level by level.
+ * The visitor sees the same levels, in the same
+ * order, as with the in memory top-down traversal,
+ * then the unreachable nodes
+ *
+ * @param ExternalGraph (pointer*)
+ * @param BfsVisitor (pointer*) => may be NULL
+ * @param ExternalTraversalStats (pointer*) => receives the bytes read per level
+ * @return void
+ *
+ */
+void runExternalTraversal(ExternalGraph *graph, const BfsVisitor *visitor, ExternalTraversalStats *stats)
+{
+    stats->traversalLength = 0;
+    stats->edgesExamined = 0;
+    stats->noOfLevels = 0;
+    stats->levelSizes = NULL;
+    stats->levelBytesRead = NULL;
+
+    if (graph->noOfNodes == 0)
+    {
+        return;
+    }
+
+    ExternalState state;
+    initExternalState(&state, graph);
+
+    // a snapshot keeps the node list order, so the first node is vertex 0
+    state.traversalPath[state.rear++] = 0;
+    state.keys[0] = 0;
+    setBit(&state.visited, 0);
+
+    unsigned int levelStart = 0, levelEnd = 1, level = 0, capacity = 0;
+
+    while (levelStart < levelEnd)
+    {
+        visitLevel(visitor, state.traversalPath, levelStart, levelEnd, level++);
+
+        size_t bytesRead = state.bytesRead;
+
+        expandLevel(&state, levelStart, levelEnd);
+        orderLevel(&state, levelEnd, state.rear);
+        recordLevel(stats, &capacity, levelEnd - levelStart, state.bytesRead - bytesRead);
+
+        levelStart = levelEnd;
+        levelEnd = state.rear;
+    }
+
+    if (visitor != NULL && visitor->onUnreachable != NULL)
+    {
+        for (VertexId vertex = 0; vertex < graph->noOfNodes; vertex++)
+        {
+            if (!testBit(&state.visited, vertex))
+            {
+                visitor->onUnreachable(vertex, visitor->context);
+            }
+        }
+    }
+
+    stats->traversalLength = state.rear;
+    stats->edgesExamined = state.edgesExamined;
+
+    freeExternalState(&state);
+}
+
+/*
+ * @brief Free external traversal stats
+ *
+ * @param ExternalTraversalStats (pointer*)
+ * @return void
+ *
+ */
+void freeExternalTraversalStats(ExternalTraversalStats *stats)
+{
+    free(stats->levelSizes);
+    free(stats->levelBytesRead);
+
+    stats->levelSizes = NULL;
+    stats->levelBytesRead = NULL;
+    stats->noOfLevels = 0;
+}
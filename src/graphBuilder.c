@@ -0,0 +1,750 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "graphBuilder.h"
+#include "arena.h"
+#include "types.h"
+#include "workerThreads.h"
+
+/*
+ * @brief Build state data structure
+ *
+ * BuildState struct is shared by the threads of a
+ * parallel counting sort. Every thread owns one edge
+ * list, and one range of vertices in every chunk.
+ * The vertices are sorted one chunk at a time so the
+ * per list counts only cover the current chunk
+ * 
+ * @member EdgeList pointer [array] (edge lists) => edges in file order
+ * @member unsigned int (number of lists) => also the number of threads
+ * @member VertexId (number of nodes)
+ * @member VertexId (chunk length) => vertices sorted per pass
+ * @member size_t pointer [2d array] (list counts) => per list degree, then row offset, of the chunk
+ * @member size_t pointer [array] (range sums) => number of edges in every range of the chunk
+ * @member size_t pointer [array] (edge offsets) => row offsets being built
+ * @member VertexId pointer [array] (adjacent nodes) => neighbours being built
+ * @member unsigned int pointer [array] (edge weights) => weights being built
+ * @member pthread_barrier_t (barrier) => separates the phases of the sort
+ * @member WorkerLaunch (launch) => holds the workers until all are created
+ *
+ */
+typedef struct BuildState {
+    const EdgeList *edgeLists;
+    unsigned int noOfLists;
+    VertexId noOfNodes;
+    VertexId chunkLength;
+    size_t **listCounts;
+    size_t *rangeSums;
+    size_t *edgeOffsets;
+    VertexId *adjacentNodes;
+    unsigned int *edgeWeights;
+    pthread_barrier_t barrier;
+    WorkerLaunch launch;
+} BuildState;
+
+/*
+ * @brief Build argument data structure
+ *
+ * @member BuildState (pointer*) => shared state
+ * @member unsigned int (list index) => list and vertex range of this thread
+ *
+ */
+typedef struct BuildArgument {
+    BuildState *state;
+    unsigned int listIndex;
+} BuildArgument;
+
+/*
+ * @brief Lock serializing lazy builds of the incoming arrays
+ *
+ * Traversals sharing a graph may all ask for the
+ * incoming arrays at once, only the first builds them
+ *
+ */
+static pthread_mutex_t incomingLock = PTHREAD_MUTEX_INITIALIZER;
+
+/*
+ * @brief declarations for internal functions
+ *
+ * List of static functions local to this file
+ * Meant to be used in this file only
+ * 
+ * @note all internal functions are static
+ */
+static void growEdgeList(EdgeList *edgeList);
+static VertexId getRangeStart
+(
+    const BuildState *state,
+    VertexId chunkStart,
+    VertexId chunkEnd,
+    unsigned int range
+);
+static void countListDegrees(BuildState *state, unsigned int listIndex, VertexId chunkStart, VertexId chunkEnd);
+static void sumVertexDegrees(BuildState *state, unsigned int listIndex, VertexId chunkStart, VertexId chunkEnd);
+static void prefixSumRange(BuildState *state, unsigned int listIndex, VertexId chunkStart, VertexId chunkEnd);
+static void scatterList(BuildState *state, unsigned int listIndex, VertexId chunkStart, VertexId chunkEnd);
+static void *buildWorker(void *argument);
+static void *carryOver(const Graph *graph, Arena *arena, void *array, size_t size);
+
+/*
+ * @brief Initialize edge list struct
+ * 
+ * @param EdgeList (pointer*)
+ * @return void
+ * 
+ */
+void initEdgeList(EdgeList *edgeList)
+{
+    initArena(&edgeList->arena);
+    edgeList->first = NULL;
+    edgeList->last = NULL;
+    edgeList->length = 0;
+}
+
+/*
+ * @brief Grow edge list
+ * 
+ * Chains a new block from the list's arena.
+ * Edges already stored never move
+ * 
+ * @param EdgeList (pointer*)
+ * @return void
+ * 
+ */
+static void growEdgeList(EdgeList *edgeList)
+{
+    EdgeBlock *block = (EdgeBlock *)arenaAllocate(&edgeList->arena, sizeof(EdgeBlock));
+    block->next = NULL;
+    block->length = 0;
+
+    if (edgeList->last == NULL)
+    {
+        edgeList->first = block;
+    }
+    else
+    {
+        edgeList->last->next = block;
+    }
+
+    edgeList->last = block;
+}
+
+/*
+ * @brief Append an edge to edge list
+ * 
+ * @param EdgeList (pointer*)
+ * @param VertexId (source vertex)
+ * @param VertexId (destination vertex)
+ * @param unsigned int (weight)
+ * @return void
+ * 
+ */
+void appendEdge
+(
+    EdgeList *edgeList,
+    VertexId source,
+    VertexId destination,
+    unsigned int weight
+)
+{
+    if (edgeList->last == NULL || edgeList->last->length == EDGE_BLOCK_LENGTH)
+    {
+        growEdgeList(edgeList);
+    }
+
+    Edge *edge = &edgeList->last->edges[edgeList->last->length++];
+    edgeList->length++;
+    edge->source = source;
+    edge->destination = destination;
+    edge->weight = weight;
+}
+
+/*
+ * @brief Free edge list
+ * 
+ * @param EdgeList (pointer*)
+ * @return void
+ * 
+ */
+void freeEdgeList(EdgeList *edgeList)
+{
+    freeArena(&edgeList->arena);
+    initEdgeList(edgeList);
+}
+
+/*
+ * @brief Build compressed sparse row arrays
+ * 
+ * Builds the offsets, neighbour and weight
+ * arrays of the graph from a single edge list
+ * 
+ * @param Graph (pointer*)
+ * @param EdgeList (pointer*)
+ * @return void
+ * 
+ * @note The sort is stable so neighbours keep file order
+ * @note Runs in O(V + E) time
+ * 
+ */
+void buildAdjacencyArrays(Graph *graph, const EdgeList *edgeList)
+{
+    buildAdjacencyArraysFromLists(graph, edgeList, 1);
+}
+
+/*
+ * @brief Get the first vertex of a range in a chunk
+ * 
+ * @param BuildState (pointer*)
+ * @param VertexId (chunk start)
+ * @param VertexId (chunk end, exclusive)
+ * @param unsigned int (range index, number of lists for the chunk end)
+ * @return VertexId
+ * 
+ */
+static VertexId getRangeStart
+(
+    const BuildState *state,
+    VertexId chunkStart,
+    VertexId chunkEnd,
+    unsigned int range
+)
+{
+    return chunkStart + (VertexId)((unsigned long long)(chunkEnd - chunkStart) * range / state->noOfLists);
+}
+
+/*
+ * @brief Count out degrees of one edge list
+ * 
+ * Only edges leaving the chunk are counted
+ * 
+ * @param BuildState (pointer*)
+ * @param unsigned int (list index)
+ * @param VertexId (chunk start)
+ * @param VertexId (chunk end, exclusive)
+ * @return void
+ * 
+ */
+static void countListDegrees(BuildState *state, unsigned int listIndex, VertexId chunkStart, VertexId chunkEnd)
+{
+    const EdgeList *edgeList = &state->edgeLists[listIndex];
+    size_t *listCounts = state->listCounts[listIndex];
+
+    memset(listCounts, 0, (size_t)(chunkEnd - chunkStart) * sizeof(size_t));
+
+    for (const EdgeBlock *block = edgeList->first; block != NULL; block = block->next)
+    {
+        for (size_t index = 0; index < block->length; index++)
+        {
+            VertexId source = block->edges[index].source;
+
+            if (source >= chunkStart && source < chunkEnd)
+            {
+                listCounts[source - chunkStart]++;
+            }
+        }
+    }
+}
+
+/*
+ * @brief Sum degrees over a range of vertices
+ * 
+ * Turns the per list counts of every vertex in the
+ * thread's range of the chunk into the offset of that
+ * list's edges within the row, and stores the row length
+ * 
+ * @param BuildState (pointer*)
+ * @param unsigned int (list index, doubles as the range index)
+ * @param VertexId (chunk start)
+ * @param VertexId (chunk end, exclusive)
+ * @return void
+ * 
+ */
+static void sumVertexDegrees(BuildState *state, unsigned int listIndex, VertexId chunkStart, VertexId chunkEnd)
+{
+    VertexId rangeEnd = getRangeStart(state, chunkStart, chunkEnd, listIndex + 1);
+    size_t rangeSum = 0;
+
+    for (VertexId vertex = getRangeStart(state, chunkStart, chunkEnd, listIndex); vertex < rangeEnd; vertex++)
+    {
+        size_t degree = 0;
+
+        for (unsigned int list = 0; list < state->noOfLists; list++)
+        {
+            size_t count = state->listCounts[list][vertex - chunkStart];
+            state->listCounts[list][vertex - chunkStart] = degree;
+            degree += count;
+        }
+
+        state->edgeOffsets[vertex + 1] = degree;
+        rangeSum += degree;
+    }
+
+    state->rangeSums[listIndex] = rangeSum;
+}
+
+/*
+ * @brief Prefix sum offsets over a range of vertices
+ * 
+ * Continues from the offset the previous chunk ended at
+ * 
+ * @param BuildState (pointer*)
+ * @param unsigned int (list index, doubles as the range index)
+ * @param VertexId (chunk start)
+ * @param VertexId (chunk end, exclusive)
+ * @return void
+ * 
+ */
+static void prefixSumRange(BuildState *state, unsigned int listIndex, VertexId chunkStart, VertexId chunkEnd)
+{
+    VertexId rangeEnd = getRangeStart(state, chunkStart, chunkEnd, listIndex + 1);
+    size_t offset = state->edgeOffsets[chunkStart];
+
+    for (unsigned int range = 0; range < listIndex; range++)
+    {
+        offset += state->rangeSums[range];
+    }
+
+    for (VertexId vertex = getRangeStart(state, chunkStart, chunkEnd, listIndex); vertex < rangeEnd; vertex++)
+    {
+        offset += state->edgeOffsets[vertex + 1];
+        state->edgeOffsets[vertex + 1] = offset;
+    }
+}
+
+/*
+ * @brief Scatter the edges of one list leaving the chunk
+ * 
+ * @param BuildState (pointer*)
+ * @param unsigned int (list index)
+ * @param VertexId (chunk start)
+ * @param VertexId (chunk end, exclusive)
+ * @return void
+ * 
+ */
+static void scatterList(BuildState *state, unsigned int listIndex, VertexId chunkStart, VertexId chunkEnd)
+{
+    const EdgeList *edgeList = &state->edgeLists[listIndex];
+    size_t *listCounts = state->listCounts[listIndex];
+
+    for (const EdgeBlock *block = edgeList->first; block != NULL; block = block->next)
+    {
+        for (size_t index = 0; index < block->length; index++)
+        {
+            const Edge *edge = &block->edges[index];
+
+            if (edge->source < chunkStart || edge->source >= chunkEnd)
+            {
+                continue;
+            }
+
+            size_t position = state->edgeOffsets[edge->source] + listCounts[edge->source - chunkStart]++;
+
+            state->adjacentNodes[position] = edge->destination;
+            state->edgeWeights[position] = edge->weight;
+        }
+    }
+}
+
+/*
+ * @brief Builder thread
+ * 
+ * Runs every phase of the counting sort for one
+ * edge list and one range of vertices, chunk by chunk
+ * 
+ * @param void pointer (BuildArgument)
+ * @return void pointer (NULL)
+ * 
+ */
+static void *buildWorker(void *argument)
+{
+    BuildArgument *buildArgument = (BuildArgument *)argument;
+    BuildState *state = buildArgument->state;
+    unsigned int listIndex = buildArgument->listIndex;
+
+    if (!enterWorker(&state->launch))
+    {
+        return NULL;
+    }
+
+    for (VertexId chunkStart = 0; chunkStart < state->noOfNodes; )
+    {
+        VertexId chunkEnd = state->noOfNodes - chunkStart > state->chunkLength
+            ? chunkStart + state->chunkLength : state->noOfNodes;
+
+        countListDegrees(state, listIndex, chunkStart, chunkEnd);
+        pthread_barrier_wait(&state->barrier);
+
+        sumVertexDegrees(state, listIndex, chunkStart, chunkEnd);
+        pthread_barrier_wait(&state->barrier);
+
+        prefixSumRange(state, listIndex, chunkStart, chunkEnd);
+        pthread_barrier_wait(&state->barrier);
+
+        // the next count only touches this thread's own list counts
+        scatterList(state, listIndex, chunkStart, chunkEnd);
+
+        chunkStart = chunkEnd;
+    }
+
+    return NULL;
+}
+
+/*
+ * @brief Build compressed sparse row arrays from several lists
+ * 
+ * Builds the offsets, neighbour and weight arrays
+ * with a counting sort over the source vertex of every
+ * edge. Each list is counted and scattered by its own
+ * thread and the degree prefix sum is split by vertex range.
+ * The vertices are sorted in as few chunks as keep the
+ * per list counts within the size of the rows, so the
+ * counts never outgrow the graph whatever the thread count
+ * 
+ * @param Graph (pointer*)
+ * @param EdgeList pointer [array] (edge lists, in file order)
+ * @param unsigned int (number of lists)
+ * @return void
+ * 
+ * @note Rows list the edges of earlier lists first, so
+ *       neighbours keep file order across lists too
+ * @note Runs in O(V * lists + E * chunks) work with O(V + E) memory,
+ *       one chunk unless V * lists exceeds max(V, E)
+ * 
+ */
+void buildAdjacencyArraysFromLists
+(
+    Graph *graph,
+    const EdgeList *edgeLists,
+    unsigned int noOfLists
+)
+{
+    unsigned int noOfNodes = graph->noOfNodes;
+    size_t noOfEdges = 0;
+
+    for (unsigned int list = 0; list < noOfLists; list++)
+    {
+        noOfEdges += edgeLists[list].length;
+    }
+
+    BuildState state;
+    state.edgeLists = edgeLists;
+    state.noOfLists = noOfLists;
+    state.edgeOffsets = (size_t *)arenaAllocateZeroed(&graph->arena, (noOfNodes + 1) * sizeof(size_t));
+    state.adjacentNodes = (VertexId *)arenaAllocate(&graph->arena, (noOfEdges + 1) * sizeof(VertexId));
+    state.edgeWeights = (unsigned int *)arenaAllocate(&graph->arena, (noOfEdges + 1) * sizeof(unsigned int));
+    state.listCounts = (size_t **)malloc(noOfLists * sizeof(size_t *));
+    state.rangeSums = (size_t *)malloc(noOfLists * sizeof(size_t));
+
+    // all the counts together hold no more entries than the rows or the offsets
+    size_t countBudget = noOfEdges > (size_t)noOfNodes + 1 ? noOfEdges : (size_t)noOfNodes + 1;
+    size_t chunkLength = countBudget / noOfLists;
+
+    state.noOfNodes = noOfNodes;
+    state.chunkLength = (VertexId)(chunkLength == 0 ? 1 : chunkLength < noOfNodes ? chunkLength : noOfNodes);
+
+    pthread_t *threads = (pthread_t *)malloc(noOfLists * sizeof(pthread_t));
+    BuildArgument *buildArguments = (BuildArgument *)malloc(noOfLists * sizeof(BuildArgument));
+
+    if
+    (
+        state.listCounts == NULL || state.rangeSums == NULL ||
+        threads == NULL || buildArguments == NULL
+    )
+    {
+        perror("Failed to allocate memory\n");
+        exit(EXIT_FAILURE);
+    }
+
+    for (unsigned int list = 0; list < noOfLists; list++)
+    {
+        state.listCounts[list] = (size_t *)malloc(((size_t)state.chunkLength + 1) * sizeof(size_t));
+
+        if (state.listCounts[list] == NULL)
+        {
+            perror("Failed to allocate memory\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    pthread_barrier_init(&state.barrier, NULL, noOfLists);
+
+    // the calling thread builds the first list
+    for (unsigned int list = 0; list < noOfLists; list++)
+    {
+        buildArguments[list].state = &state;
+        buildArguments[list].listIndex = list;
+    }
+
+    startWorkers(&state.launch, threads, noOfLists, buildWorker, buildArguments, sizeof(BuildArgument));
+    buildWorker(&buildArguments[0]);
+    joinWorkers(&state.launch, threads, noOfLists);
+
+    pthread_barrier_destroy(&state.barrier);
+
+    for (unsigned int list = 0; list < noOfLists; list++)
+    {
+        free(state.listCounts[list]);
+    }
+
+    free(state.listCounts);
+    free(state.rangeSums);
+    free(threads);
+    free(buildArguments);
+
+    graph->noOfEdges = noOfEdges;
+    graph->edgeOffsets = state.edgeOffsets;
+    graph->adjacentNodes = state.adjacentNodes;
+    graph->edgeWeights = state.edgeWeights;
+}
+
+/*
+ * @brief Build incoming adjacency arrays
+ * 
+ * Transposes the compressed sparse row arrays
+ * so the predecessors of every vertex can be
+ * scanned directly. Each incoming edge also keeps
+ * its position within the predecessor's outgoing row
+ * 
+ * @param Graph (pointer*)
+ * @return void
+ * 
+ * @note Does nothing if the arrays already exist
+ * @note Safe to call from threads sharing the graph
+ * @note Predecessors are listed in ascending order
+ * @note Undirected graphs are transposed too, since the
+ *       outgoing rows keep file order rather than sorted order
+ * 
+ */
+void buildIncomingArrays(Graph *graph)
+{
+    if (__atomic_load_n(&graph->incomingOffsets, __ATOMIC_ACQUIRE) != NULL)
+    {
+        return;
+    }
+
+    pthread_mutex_lock(&incomingLock);
+
+    // another traversal may have built them while this one waited
+    if (graph->incomingOffsets != NULL)
+    {
+        pthread_mutex_unlock(&incomingLock);
+        return;
+    }
+
+    unsigned int noOfNodes = graph->noOfNodes;
+    size_t noOfEdges = graph->noOfEdges;
+
+    size_t *incomingOffsets = (size_t *)arenaAllocateZeroed(&graph->arena, (noOfNodes + 1) * sizeof(size_t));
+    VertexId *incomingNodes = (VertexId *)arenaAllocate(&graph->arena, (noOfEdges + 1) * sizeof(VertexId));
+    unsigned int *incomingPositions = (unsigned int *)arenaAllocate
+    (
+        &graph->arena, (noOfEdges + 1) * sizeof(unsigned int)
+    );
+    size_t *insertPositions = (size_t *)malloc((noOfNodes + 1) * sizeof(size_t));
+
+    if (insertPositions == NULL)
+    {
+        perror("Failed to allocate memory\n");
+        exit(EXIT_FAILURE);
+    }
+
+    // count the in degree of every vertex
+    for (size_t edge = 0; edge < noOfEdges; edge++)
+    {
+        incomingOffsets[graph->adjacentNodes[edge] + 1]++;
+    }
+
+    for (size_t index = 0; index < noOfNodes; index++)
+    {
+        incomingOffsets[index + 1] += incomingOffsets[index];
+    }
+
+    for (size_t index = 0; index <= noOfNodes; index++)
+    {
+        insertPositions[index] = incomingOffsets[index];
+    }
+
+    // walking sources in order keeps every incoming row sorted
+    for (VertexId source = 0; source < noOfNodes; source++)
+    {
+        size_t rowStart = graph->edgeOffsets[source];
+
+        for (size_t edge = rowStart; edge < graph->edgeOffsets[source + 1]; edge++)
+        {
+            size_t position = insertPositions[graph->adjacentNodes[edge]]++;
+
+            incomingNodes[position] = source;
+            incomingPositions[position] = (unsigned int)(edge - rowStart);
+        }
+    }
+
+    free(insertPositions);
+
+    graph->incomingNodes = incomingNodes;
+    graph->incomingPositions = incomingPositions;
+
+    // publish the offsets last, readers check them without the lock
+    __atomic_store_n(&graph->incomingOffsets, incomingOffsets, __ATOMIC_RELEASE);
+
+    pthread_mutex_unlock(&incomingLock);
+}
+
+/*
+ * @brief Move an array the old arena owns into a new one
+ *
+ * Arrays inside a snapshot mapping stay where
+ * they are
+ *
+ * @param Graph (pointer*)
+ * @param Arena (pointer*) => arena replacing the graph's
+ * @param void pointer (array, may be NULL)
+ * @param size_t (size in bytes)
+ * @return void pointer (array to use from now on)
+ *
+ */
+static void *carryOver(const Graph *graph, Arena *arena, void *array, size_t size)
+{
+    const char *mapping = (const char *)graph->snapshotMapping;
+    const char *bytes = (const char *)array;
+
+    if (array == NULL || (mapping != NULL && bytes >= mapping && bytes < mapping + graph->snapshotLength))
+    {
+        return array;
+    }
+
+    void *copy = arenaAllocate(arena, size);
+    memcpy(copy, array, size);
+
+    return copy;
+}
+
+/*
+ * @brief Hand a graph over to a new arena
+ *
+ * For rebuilds that write fresh adjacency arrays
+ * into a new arena. Arrays the old arena held that
+ * outlive the rebuild (the node list order, and the
+ * dictionary of a reordered snapshot) are copied
+ * over before the old arena is released. The
+ * incoming arrays are dropped and rebuilt on the
+ * next traversal that needs them
+ *
+ * @param Graph (pointer*)
+ * @param Arena (pointer*) => new arena, taken over by the graph
+ * @return void
+ *
+ * @note The caller points the adjacency at the new arrays afterwards
+ *
+ */
+void replaceGraphArena(Graph *graph, Arena *arena)
+{
+    unsigned int noOfNodes = graph->noOfNodes;
+
+    if (graph->snapshotMapping != NULL)
+    {
+        VertexDictionary *dictionary = &graph->dictionary;
+
+        dictionary->nameOffsets = (size_t *)carryOver
+        (
+            graph, arena, dictionary->nameOffsets, (size_t)noOfNodes * sizeof(size_t)
+        );
+        dictionary->slots = (VertexId *)carryOver
+        (
+            graph, arena, dictionary->slots, dictionary->slotCount * sizeof(VertexId)
+        );
+    }
+
+    graph->vertexOrder = (VertexId *)carryOver(graph, arena, graph->vertexOrder, (size_t)noOfNodes * sizeof(VertexId));
+
+    freeArena(&graph->arena);
+    graph->arena = *arena;
+
+    graph->incomingOffsets = NULL;
+    graph->incomingNodes = NULL;
+    graph->incomingPositions = NULL;
+}
+
+/*
+ * @brief Find the first vertex whose row starts at or after an edge
+ *
+ * Used to split the vertices into ranges
+ * holding about the same number of edges
+ *
+ * @param Graph (pointer*)
+ * @param size_t (edges) => edges before the boundary
+ * @return VertexId
+ *
+ */
+VertexId findEdgeBoundary(const Graph *graph, size_t edges)
+{
+    VertexId low = 0, high = graph->noOfNodes;
+
+    while (low < high)
+    {
+        VertexId middle = low + (high - low) / 2;
+
+        if (graph->edgeOffsets[middle] < edges)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    return low;
+}
+
+/*
+ * @brief Compare 64 bit sort keys in ascending order
+ *
+ * qsort comparator shared by every sort over
+ * packed keys
+ *
+ * @param void pointer (first key)
+ * @param void pointer (second key)
+ * @return int
+ *
+ */
+int compareSortKeys(const void *first, const void *second)
+{
+    uint64_t firstKey = *(const uint64_t *)first;
+    uint64_t secondKey = *(const uint64_t *)second;
+
+    return (firstKey > secondKey) - (firstKey < secondKey);
+}
+
+/*
+ * @brief Sort the row of a vertex
+ *
+ * Each edge becomes a key with the neighbour in
+ * the high half and the payload in the low half,
+ * so copies of an edge end up next to each other
+ *
+ * @param Graph (pointer*) => plain edge arrays
+ * @param VertexId (vertex)
+ * @param RowKeyPayload (payload) => what the low half holds
+ * @param uint64_t pointer [array] (keys) => receives the sorted row
+ * @return size_t (degree)
+ *
+ */
+size_t sortRowKeys(const Graph *graph, VertexId vertex, RowKeyPayload payload, uint64_t *keys)
+{
+    size_t rowStart = graph->edgeOffsets[vertex];
+    size_t degree = graph->edgeOffsets[vertex + 1] - rowStart;
+
+    for (size_t index = 0; index < degree; index++)
+    {
+        uint32_t low = payload == ROW_KEY_POSITION ? (uint32_t)index : graph->edgeWeights[rowStart + index];
+        keys[index] = (uint64_t)graph->adjacentNodes[rowStart + index] << 32 | low;
+    }
+
+    if (degree > 1)
+    {
+        qsort(keys, degree, sizeof(uint64_t), compareSortKeys);
+    }
+
+    return degree;
+}
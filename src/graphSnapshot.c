@@ -0,0 +1,650 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "graphSnapshot.h"
+#include "types.h"
+
+/*
+ * @brief Snapshot format constants
+ *
+ * Magic bytes at the start of every snapshot, the
+ * format version and a byte order mark that reads back
+ * differently on a machine of the other endianness
+ *
+ */
+#define SNAPSHOT_MAGIC "BFSGRAPH"
+#define SNAPSHOT_MAGIC_LENGTH 8
+#define SNAPSHOT_VERSION 1
+#define SNAPSHOT_BYTE_ORDER 0x01020304U
+#define SNAPSHOT_DIRECTED_FLAG 1U
+#define SNAPSHOT_SORTED_FLAG 2U
+
+/*
+ * @brief Sections are padded to this many bytes
+ */
+#define SNAPSHOT_ALIGNMENT 8
+
+// offsets are mapped straight into size_t arrays
+_Static_assert(sizeof(size_t) == sizeof(uint64_t), "snapshots need a 64 bit size_t");
+
+/*
+ * @brief Snapshot header data structure
+ *
+ * SnapshotHeader struct is written at the start of
+ * the file. The sections follow it in a fixed order,
+ * each starting on an 8 byte boundary:
+ * edge offsets (uint64, nodes + 1), adjacent nodes (uint32, edges),
+ * edge weights (uint32, edges), name offsets (uint64, nodes),
+ * dictionary slots (uint32, slot count), name pool (bytes)
+ * 
+ * @member char [array] (magic) => SNAPSHOT_MAGIC
+ * @member uint32_t (version) => SNAPSHOT_VERSION
+ * @member uint32_t (byte order) => SNAPSHOT_BYTE_ORDER as written
+ * @member uint32_t (flags) => SNAPSHOT_DIRECTED_FLAG if directed, SNAPSHOT_SORTED_FLAG if rows are sorted
+ * @member uint32_t (number of nodes) => Graph::noOfNodes
+ * @member uint32_t (total weight) => Graph::totalWeight
+ * @member uint32_t (reserved) => zero
+ * @member uint64_t (number of edges) => Graph::noOfEdges
+ * @member uint64_t (name pool length) => bytes in the name pool
+ * @member uint64_t (slot count) => size of the dictionary hash table
+ *
+ */
+typedef struct SnapshotHeader {
+    char magic[SNAPSHOT_MAGIC_LENGTH];
+    uint32_t version;
+    uint32_t byteOrder;
+    uint32_t flags;
+    uint32_t noOfNodes;
+    uint32_t totalWeight;
+    uint32_t reserved;
+    uint64_t noOfEdges;
+    uint64_t namePoolLength;
+    uint64_t slotCount;
+} SnapshotHeader;
+
+/*
+ * @brief Snapshot layout data structure
+ *
+ * SnapshotLayout struct holds the byte offset of
+ * every section, worked out from the header counts
+ * 
+ * @member size_t (edge offsets)
+ * @member size_t (adjacent nodes)
+ * @member size_t (edge weights)
+ * @member size_t (name offsets)
+ * @member size_t (slots)
+ * @member size_t (name pool)
+ * @member size_t (total length) => expected length of the file
+ *
+ */
+typedef struct SnapshotLayout {
+    size_t edgeOffsets;
+    size_t adjacentNodes;
+    size_t edgeWeights;
+    size_t nameOffsets;
+    size_t slots;
+    size_t namePool;
+    size_t totalLength;
+} SnapshotLayout;
+
+/*
+ * @brief declarations for internal functions
+ *
+ * List of static functions local to this file
+ * Meant to be used in this file only
+ * 
+ * @note all internal functions are static
+ */
+static size_t alignSection(size_t offset);
+static bool getSnapshotLayout(const SnapshotHeader *header, size_t length, SnapshotLayout *layout);
+static void failSnapshot(const char *fileName, const char *message);
+static void checkEdgeOffsets(const size_t *edgeOffsets, unsigned int noOfNodes, size_t noOfEdges, const char *fileName);
+static void checkNeighbours(const VertexId *neighbours, size_t count, unsigned int noOfNodes, const char *fileName);
+static void checkDictionary(const VertexDictionary *dictionary, const char *fileName);
+static void writeSection(FILE *file, const void *data, size_t length, const char *fileName);
+static void readFully(const ExternalGraph *graph, void *data, size_t length, size_t offset);
+
+/*
+ * @brief Round an offset up to the section alignment
+ * 
+ * @param size_t (offset)
+ * @return size_t
+ * 
+ */
+static size_t alignSection(size_t offset)
+{
+    return (offset + SNAPSHOT_ALIGNMENT - 1) & ~(size_t)(SNAPSHOT_ALIGNMENT - 1);
+}
+
+/*
+ * @brief Work out section offsets
+ * 
+ * @param SnapshotHeader (pointer*)
+ * @param size_t (file length)
+ * @param SnapshotLayout (pointer*) => receives the offsets
+ * @return bool (whether the sections fill the file exactly)
+ * 
+ */
+static bool getSnapshotLayout(const SnapshotHeader *header, size_t length, SnapshotLayout *layout)
+{
+    // counts larger than the file are corrupt, bounding them keeps the sums from overflowing
+    if
+    (
+        header->noOfEdges > length / (2 * sizeof(uint32_t)) ||
+        header->slotCount > length / sizeof(uint32_t) || header->namePoolLength > length
+    )
+    {
+        return false;
+    }
+
+    layout->edgeOffsets = alignSection(sizeof(SnapshotHeader));
+    layout->adjacentNodes = alignSection
+    (
+        layout->edgeOffsets + ((size_t)header->noOfNodes + 1) * sizeof(uint64_t)
+    );
+    layout->edgeWeights = alignSection
+    (
+        layout->adjacentNodes + (size_t)header->noOfEdges * sizeof(uint32_t)
+    );
+    layout->nameOffsets = alignSection
+    (
+        layout->edgeWeights + (size_t)header->noOfEdges * sizeof(uint32_t)
+    );
+    layout->slots = alignSection
+    (
+        layout->nameOffsets + (size_t)header->noOfNodes * sizeof(uint64_t)
+    );
+    layout->namePool = alignSection
+    (
+        layout->slots + (size_t)header->slotCount * sizeof(uint32_t)
+    );
+    layout->totalLength = layout->namePool + (size_t)header->namePoolLength;
+
+    return layout->totalLength == length;
+}
+
+/*
+ * @brief Report a bad snapshot and exit
+ * 
+ * @param char pointer [array] (file name)
+ * @param char pointer [array] (message)
+ * @return void
+ * 
+ */
+static void failSnapshot(const char *fileName, const char *message)
+{
+    fprintf(stderr, "%s: %s\n", fileName, message);
+    exit(EXIT_FAILURE);
+}
+
+/*
+ * @brief Check the edge offsets of a snapshot
+ * 
+ * Rows must start at zero, never shrink and end
+ * at the number of edges
+ * 
+ * @param size_t pointer [array] (edge offsets)
+ * @param unsigned int (number of nodes)
+ * @param size_t (number of edges)
+ * @param char pointer [array] (file name used in errors)
+ * @return void
+ * 
+ * @note Exits on corrupt offsets
+ * 
+ */
+static void checkEdgeOffsets(const size_t *edgeOffsets, unsigned int noOfNodes, size_t noOfEdges, const char *fileName)
+{
+    if (edgeOffsets[0] != 0 || edgeOffsets[noOfNodes] != noOfEdges)
+    {
+        failSnapshot(fileName, "snapshot edge offsets are corrupt");
+    }
+
+    for (VertexId vertex = 0; vertex < noOfNodes; vertex++)
+    {
+        if (edgeOffsets[vertex + 1] < edgeOffsets[vertex])
+        {
+            failSnapshot(fileName, "snapshot edge offsets are corrupt");
+        }
+    }
+}
+
+/*
+ * @brief Check that neighbours are vertices of the graph
+ * 
+ * @param VertexId pointer [array] (neighbours)
+ * @param size_t (number of neighbours)
+ * @param unsigned int (number of nodes)
+ * @param char pointer [array] (file name used in errors)
+ * @return void
+ * 
+ * @note Exits on a neighbour out of range
+ * 
+ */
+static void checkNeighbours(const VertexId *neighbours, size_t count, unsigned int noOfNodes, const char *fileName)
+{
+    for (size_t index = 0; index < count; index++)
+    {
+        if (neighbours[index] >= noOfNodes)
+        {
+            failSnapshot(fileName, "snapshot adjacency is corrupt");
+        }
+    }
+}
+
+/*
+ * @brief Check the vertex dictionary of a snapshot
+ * 
+ * The hash table must be a power of two with an
+ * empty slot to end every probe, slots must hold
+ * vertices and every name must end inside the pool
+ * 
+ * @param VertexDictionary (pointer*) => points into the snapshot
+ * @param char pointer [array] (file name used in errors)
+ * @return void
+ * 
+ * @note Exits on a corrupt dictionary
+ * 
+ */
+static void checkDictionary(const VertexDictionary *dictionary, const char *fileName)
+{
+    size_t slotCount = dictionary->slotCount;
+    size_t emptySlots = 0;
+
+    if (slotCount == 0 || (slotCount & (slotCount - 1)) != 0)
+    {
+        failSnapshot(fileName, "snapshot dictionary is corrupt");
+    }
+
+    for (size_t slot = 0; slot < slotCount; slot++)
+    {
+        if (dictionary->slots[slot] == INVALID_VERTEX)
+        {
+            emptySlots++;
+        }
+        else if (dictionary->slots[slot] >= dictionary->noOfNames)
+        {
+            failSnapshot(fileName, "snapshot dictionary is corrupt");
+        }
+    }
+
+    bool poolTerminated = dictionary->namePoolLength > 0 &&
+        dictionary->namePool[dictionary->namePoolLength - 1] == '\0';
+
+    if (emptySlots == 0 || (dictionary->noOfNames > 0 && !poolTerminated))
+    {
+        failSnapshot(fileName, "snapshot dictionary is corrupt");
+    }
+
+    for (VertexId vertex = 0; vertex < dictionary->noOfNames; vertex++)
+    {
+        if (dictionary->nameOffsets[vertex] >= dictionary->namePoolLength)
+        {
+            failSnapshot(fileName, "snapshot dictionary is corrupt");
+        }
+    }
+}
+
+/*
+ * @brief Check for the snapshot magic bytes
+ * 
+ * @param char pointer [array] (file contents)
+ * @param size_t (file length)
+ * @return bool
+ * 
+ */
+bool isGraphSnapshot(const char *contents, size_t length)
+{
+    return length >= SNAPSHOT_MAGIC_LENGTH &&
+        memcmp(contents, SNAPSHOT_MAGIC, SNAPSHOT_MAGIC_LENGTH) == 0;
+}
+
+/*
+ * @brief Open a graph snapshot
+ * 
+ * Validates the header and points the graph's
+ * arrays into the mapping. Nothing is copied, but
+ * the offsets, neighbours and dictionary are checked
+ * once so a corrupt file is refused up front
+ * 
+ * @param Graph (pointer*) => initialized graph to fill
+ * @param void pointer (read only mapping of the whole file)
+ * @param size_t (length of the mapping)
+ * @param char pointer [array] (file name used in errors)
+ * @return void
+ * 
+ * @note The graph takes ownership of the mapping
+ * 
+ */
+void openGraphSnapshot(Graph *graph, void *mapping, size_t length, const char *fileName)
+{
+    if (length < sizeof(SnapshotHeader))
+    {
+        failSnapshot(fileName, "snapshot is truncated");
+    }
+
+    const SnapshotHeader *header = (const SnapshotHeader *)mapping;
+
+    if (header->byteOrder != SNAPSHOT_BYTE_ORDER)
+    {
+        failSnapshot(fileName, "snapshot was written on a machine of different byte order");
+    }
+    if (header->version != SNAPSHOT_VERSION)
+    {
+        failSnapshot(fileName, "unsupported snapshot version");
+    }
+
+    SnapshotLayout layout;
+
+    if (!getSnapshotLayout(header, length, &layout))
+    {
+        failSnapshot(fileName, "snapshot length does not match its header");
+    }
+
+    const char *base = (const char *)mapping;
+
+    graph->noOfNodes = header->noOfNodes;
+    graph->noOfEdges = (size_t)header->noOfEdges;
+    graph->totalWeight = header->totalWeight;
+    graph->directed = (header->flags & SNAPSHOT_DIRECTED_FLAG) != 0;
+    graph->sortedRows = (header->flags & SNAPSHOT_SORTED_FLAG) != 0;
+    graph->edgeOffsets = (size_t *)(base + layout.edgeOffsets);
+    graph->adjacentNodes = (VertexId *)(base + layout.adjacentNodes);
+    graph->edgeWeights = (unsigned int *)(base + layout.edgeWeights);
+
+    checkEdgeOffsets(graph->edgeOffsets, graph->noOfNodes, graph->noOfEdges, fileName);
+    checkNeighbours(graph->adjacentNodes, graph->noOfEdges, graph->noOfNodes, fileName);
+
+    VertexDictionary *dictionary = &graph->dictionary;
+    free(dictionary->nameOffsets);
+    free(dictionary->namePool);
+    free(dictionary->slots);
+
+    dictionary->noOfNames = header->noOfNodes;
+    dictionary->nameCapacity = header->noOfNodes;
+    dictionary->nameOffsets = (size_t *)(base + layout.nameOffsets);
+    dictionary->namePool = (char *)(base + layout.namePool);
+    dictionary->namePoolLength = (size_t)header->namePoolLength;
+    dictionary->namePoolCapacity = (size_t)header->namePoolLength;
+    dictionary->slots = (VertexId *)(base + layout.slots);
+    dictionary->slotCount = (size_t)header->slotCount;
+
+    checkDictionary(dictionary, fileName);
+
+    graph->snapshotMapping = mapping;
+    graph->snapshotLength = length;
+}
+
+/*
+ * @brief Write one section of a snapshot
+ * 
+ * Writes the data followed by zero padding
+ * up to the section alignment
+ * 
+ * @param FILE (pointer*)
+ * @param void pointer (data)
+ * @param size_t (length of data)
+ * @param char pointer [array] (file name used in errors)
+ * @return void
+ * 
+ */
+static void writeSection(FILE *file, const void *data, size_t length, const char *fileName)
+{
+    static const char padding[SNAPSHOT_ALIGNMENT] = { 0 };
+
+    if (length > 0 && fwrite(data, 1, length, file) != length)
+    {
+        failSnapshot(fileName, "failed to write snapshot");
+    }
+
+    size_t paddingLength = alignSection(length) - length;
+
+    if (paddingLength > 0 && fwrite(padding, 1, paddingLength, file) != paddingLength)
+    {
+        failSnapshot(fileName, "failed to write snapshot");
+    }
+}
+
+/*
+ * @brief Save a graph snapshot
+ * 
+ * Writes the header fields, vertex dictionary
+ * and adjacency arrays in the layout that
+ * openGraphSnapshot maps back
+ * 
+ * @param Graph (pointer*)
+ * @param char pointer [array] (file name)
+ * @return void
+ * 
+ */
+void saveGraphSnapshot(const Graph *graph, const char *fileName)
+{
+    const VertexDictionary *dictionary = &graph->dictionary;
+
+    SnapshotHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, SNAPSHOT_MAGIC, SNAPSHOT_MAGIC_LENGTH);
+    header.version = SNAPSHOT_VERSION;
+    header.byteOrder = SNAPSHOT_BYTE_ORDER;
+    header.flags = graph->directed ? SNAPSHOT_DIRECTED_FLAG : 0;
+    header.flags |= graph->sortedRows ? SNAPSHOT_SORTED_FLAG : 0;
+    header.noOfNodes = graph->noOfNodes;
+    header.totalWeight = graph->totalWeight;
+    header.noOfEdges = graph->noOfEdges;
+    header.namePoolLength = dictionary->namePoolLength;
+    header.slotCount = dictionary->slotCount;
+
+    FILE *file = fopen(fileName, "wb");
+    if (file == NULL)
+    {
+        perror("Error in file\n");
+        exit(EXIT_FAILURE);
+    }
+
+    writeSection(file, &header, sizeof(header), fileName);
+    writeSection
+    (
+        file, graph->edgeOffsets, ((size_t)graph->noOfNodes + 1) * sizeof(size_t), fileName
+    );
+    writeSection(file, graph->adjacentNodes, graph->noOfEdges * sizeof(VertexId), fileName);
+    writeSection(file, graph->edgeWeights, graph->noOfEdges * sizeof(unsigned int), fileName);
+    writeSection(file, dictionary->nameOffsets, (size_t)graph->noOfNodes * sizeof(size_t), fileName);
+    writeSection(file, dictionary->slots, dictionary->slotCount * sizeof(VertexId), fileName);
+
+    // the name pool is the last section and needs no padding
+    if
+    (
+        dictionary->namePoolLength > 0 &&
+        fwrite(dictionary->namePool, 1, dictionary->namePoolLength, file) != dictionary->namePoolLength
+    )
+    {
+        failSnapshot(fileName, "failed to write snapshot");
+    }
+
+    if (fclose(file) != 0)
+    {
+        failSnapshot(fileName, "failed to write snapshot");
+    }
+}
+
+/*
+ * @brief Read bytes at an offset of an external graph
+ * 
+ * Retries short reads until everything is in
+ * 
+ * @param ExternalGraph (pointer*)
+ * @param void pointer (data) => receives the bytes
+ * @param size_t (length)
+ * @param size_t (file offset)
+ * @return void
+ * 
+ */
+static void readFully(const ExternalGraph *graph, void *data, size_t length, size_t offset)
+{
+    char *bytes = (char *)data;
+
+    while (length > 0)
+    {
+        ssize_t bytesRead = pread(graph->fileDescriptor, bytes, length, (off_t)offset);
+
+        if (bytesRead <= 0)
+        {
+            failSnapshot(graph->fileName, "failed to read snapshot");
+        }
+
+        bytes += bytesRead;
+        offset += (size_t)bytesRead;
+        length -= (size_t)bytesRead;
+    }
+}
+
+/*
+ * @brief Open a snapshot without loading its adjacency
+ * 
+ * Validates the header like openGraphSnapshot,
+ * reads the edge offsets and maps the name sections.
+ * The adjacency stays on disk, read ahead
+ * sequentially by the kernel
+ * 
+ * @param ExternalGraph (pointer*)
+ * @param char pointer [array] (file name)
+ * @return void
+ * 
+ * @note Exits if the file is not a snapshot
+ * 
+ */
+void openExternalGraph(ExternalGraph *graph, const char *fileName)
+{
+    graph->fileName = fileName;
+    graph->fileDescriptor = open(fileName, O_RDONLY);
+
+    if (graph->fileDescriptor == -1)
+    {
+        perror("Error in file\n");
+        exit(EXIT_FAILURE);
+    }
+
+    struct stat fileStatus;
+    if (fstat(graph->fileDescriptor, &fileStatus) == -1)
+    {
+        perror("Error in file\n");
+        exit(EXIT_FAILURE);
+    }
+
+    SnapshotHeader header;
+
+    if
+    (
+        (size_t)fileStatus.st_size < sizeof(SnapshotHeader) ||
+        pread(graph->fileDescriptor, &header, sizeof(header), 0) != (ssize_t)sizeof(header) ||
+        !isGraphSnapshot(header.magic, SNAPSHOT_MAGIC_LENGTH)
+    )
+    {
+        failSnapshot(fileName, "not a graph snapshot, write one with --save first");
+    }
+    if (header.byteOrder != SNAPSHOT_BYTE_ORDER)
+    {
+        failSnapshot(fileName, "snapshot was written on a machine of different byte order");
+    }
+    if (header.version != SNAPSHOT_VERSION)
+    {
+        failSnapshot(fileName, "unsupported snapshot version");
+    }
+
+    SnapshotLayout layout;
+
+    if (!getSnapshotLayout(&header, (size_t)fileStatus.st_size, &layout))
+    {
+        failSnapshot(fileName, "snapshot length does not match its header");
+    }
+
+    graph->noOfNodes = header.noOfNodes;
+    graph->noOfEdges = (size_t)header.noOfEdges;
+    graph->totalWeight = header.totalWeight;
+    graph->directed = (header.flags & SNAPSHOT_DIRECTED_FLAG) != 0;
+    graph->adjacencyStart = layout.adjacentNodes;
+    graph->offsetBytesRead = ((size_t)graph->noOfNodes + 1) * sizeof(size_t);
+    graph->edgeOffsets = (size_t *)malloc(graph->offsetBytesRead);
+
+    if (graph->edgeOffsets == NULL)
+    {
+        perror("Failed to allocate memory\n");
+        exit(EXIT_FAILURE);
+    }
+
+    readFully(graph, graph->edgeOffsets, graph->offsetBytesRead, layout.edgeOffsets);
+    checkEdgeOffsets(graph->edgeOffsets, graph->noOfNodes, graph->noOfEdges, fileName);
+
+    // the name sections run to the end of the file, a mapping has to start on a page
+    size_t mappingStart = layout.nameOffsets & ~((size_t)sysconf(_SC_PAGESIZE) - 1);
+    graph->nameMappingLength = layout.totalLength - mappingStart;
+    graph->nameMapping = mmap
+    (
+        NULL, graph->nameMappingLength, PROT_READ, MAP_PRIVATE, graph->fileDescriptor, (off_t)mappingStart
+    );
+
+    if (graph->nameMapping == MAP_FAILED)
+    {
+        perror("Failed to map file\n");
+        exit(EXIT_FAILURE);
+    }
+
+    const char *base = (const char *)graph->nameMapping - mappingStart;
+    VertexDictionary *dictionary = &graph->dictionary;
+
+    dictionary->noOfNames = header.noOfNodes;
+    dictionary->nameCapacity = header.noOfNodes;
+    dictionary->nameOffsets = (size_t *)(base + layout.nameOffsets);
+    dictionary->namePool = (char *)(base + layout.namePool);
+    dictionary->namePoolLength = (size_t)header.namePoolLength;
+    dictionary->namePoolCapacity = (size_t)header.namePoolLength;
+    dictionary->slots = (VertexId *)(base + layout.slots);
+    dictionary->slotCount = (size_t)header.slotCount;
+
+    checkDictionary(dictionary, fileName);
+
+    posix_fadvise(graph->fileDescriptor, 0, 0, POSIX_FADV_SEQUENTIAL);
+}
+
+/*
+ * @brief Read neighbours of an external graph
+ * 
+ * The neighbours are checked as they are read,
+ * the adjacency is never checked as a whole
+ * 
+ * @param ExternalGraph (pointer*)
+ * @param size_t (first edge) => index into the adjacent nodes section
+ * @param size_t (number of edges)
+ * @param VertexId pointer [array] (edges) => receives the neighbours
+ * @return void
+ * 
+ */
+void readExternalEdges(const ExternalGraph *graph, size_t firstEdge, size_t noOfEdges, VertexId *edges)
+{
+    readFully
+    (
+        graph, edges, noOfEdges * sizeof(VertexId), graph->adjacencyStart + firstEdge * sizeof(VertexId)
+    );
+    checkNeighbours(edges, noOfEdges, graph->noOfNodes, graph->fileName);
+}
+
+/*
+ * @brief Close an external graph
+ * 
+ * @param ExternalGraph (pointer*)
+ * @return void
+ * 
+ */
+void closeExternalGraph(ExternalGraph *graph)
+{
+    munmap(graph->nameMapping, graph->nameMappingLength);
+    close(graph->fileDescriptor);
+    free(graph->edgeOffsets);
+
+    graph->nameMapping = NULL;
+    graph->edgeOffsets = NULL;
+}
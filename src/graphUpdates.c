@@ -0,0 +1,1002 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "graphUpdates.h"
+#include "bitmap.h"
+#include "graphBuilder.h"
+#include "shortestPath.h"
+#include "types.h"
+
+/*
+ * @brief Updates a batch holds before it first grows
+ */
+#define INITIAL_BATCH_CAPACITY 64
+
+/*
+ * @brief Directed update data structure
+ *
+ * One direction of a queued update. An update of
+ * an undirected graph becomes two of these with the
+ * same sequence number
+ *
+ * @member VertexId (from) => row the update changes
+ * @member VertexId (to) => target of the edge
+ * @member unsigned int (weight) => weight of an inserted edge
+ * @member bool (removal) => removes every from -> to edge
+ * @member size_t (sequence) => position of the update in its batch
+ *
+ */
+typedef struct DirectedUpdate {
+    VertexId from;
+    VertexId to;
+    unsigned int weight;
+    bool removal;
+    size_t sequence;
+} DirectedUpdate;
+
+/*
+ * @brief Edge pair list data structure
+ *
+ * @member VertexId pointer [array] (sources)
+ * @member VertexId pointer [array] (targets)
+ * @member size_t (length) => pairs in the list
+ * @member size_t (capacity) => pairs that fit before growing
+ *
+ */
+typedef struct EdgePairList {
+    VertexId *sources;
+    VertexId *targets;
+    size_t length;
+    size_t capacity;
+} EdgePairList;
+
+/*
+ * @brief Distance heap data structure
+ *
+ * Binary min heap of distance << 32 | vertex keys,
+ * so vertices leave it in order of distance
+ *
+ * @member uint64_t pointer [array] (keys)
+ * @member size_t (length) => keys in the heap
+ * @member size_t (capacity) => keys that fit before growing
+ *
+ */
+typedef struct DistanceHeap {
+    uint64_t *keys;
+    size_t length;
+    size_t capacity;
+} DistanceHeap;
+
+/*
+ * @brief Repair log data structure
+ *
+ * Remembers the distance every vertex had before
+ * a repair first changed it, so the repair can tell
+ * which distances really moved
+ *
+ * @member Bitmap (recorded) => vertices already in the log
+ * @member VertexId pointer [array] (vertices) => vertices in the order they were recorded
+ * @member unsigned int pointer [array] (previous distances) => distance before the repair
+ * @member size_t (length) => vertices in the log
+ * @member size_t (capacity) => vertices that fit before growing
+ *
+ */
+typedef struct RepairLog {
+    Bitmap recorded;
+    VertexId *vertices;
+    unsigned int *previousDistances;
+    size_t length;
+    size_t capacity;
+} RepairLog;
+
+/*
+ * @brief declarations for internal functions
+ *
+ * List of static functions local to this file
+ * Meant to be used in this file only
+ *
+ * @note all internal functions are static
+ */
+static void appendUpdate(UpdateBatch *batch, EdgeUpdate update);
+static DirectedUpdate *expandUpdates(const Graph *graph, const UpdateBatch *batch, size_t *length);
+static int compareByEdge(const void *first, const void *second);
+static int compareBySequence(const void *first, const void *second);
+static size_t selectSurvivors(DirectedUpdate *updates, size_t length, EdgePairList *removals);
+static void appendEdgePair(EdgePairList *list, VertexId from, VertexId to);
+static void freeEdgePairList(EdgePairList *list);
+static void mergeRows
+(
+    Graph *graph,
+    const DirectedUpdate *insertions,
+    size_t noOfInsertions,
+    const EdgePairList *removals,
+    EdgePairList *removedEdges
+);
+static void pushDistance(DistanceHeap *heap, unsigned int distance, VertexId vertex);
+static uint64_t popDistance(DistanceHeap *heap);
+static void recordDistance(RepairLog *log, const IncrementalBfs *bfs, VertexId vertex);
+static bool hasSupport
+(
+    const IncrementalBfs *bfs,
+    const Bitmap *invalidated,
+    const size_t *backwardOffsets,
+    const VertexId *backwardNodes,
+    VertexId vertex
+);
+static void repairDistances
+(
+    Graph *graph,
+    IncrementalBfs *bfs,
+    const EdgePairList *removedEdges,
+    const DirectedUpdate *insertions,
+    size_t noOfInsertions
+);
+
+/*
+ * @brief Initialize an empty update batch
+ *
+ * @param UpdateBatch (pointer*)
+ * @return void
+ *
+ */
+void initUpdateBatch(UpdateBatch *batch)
+{
+    batch->updates = NULL;
+    batch->length = 0;
+    batch->capacity = 0;
+}
+
+/*
+ * @brief Append an update to a batch
+ *
+ * @param UpdateBatch (pointer*)
+ * @param EdgeUpdate (update)
+ * @return void
+ *
+ */
+static void appendUpdate(UpdateBatch *batch, EdgeUpdate update)
+{
+    if (batch->length == batch->capacity)
+    {
+        batch->capacity = batch->capacity == 0 ? INITIAL_BATCH_CAPACITY : batch->capacity * 2;
+        batch->updates = (EdgeUpdate *)realloc(batch->updates, batch->capacity * sizeof(EdgeUpdate));
+
+        if (batch->updates == NULL)
+        {
+            perror("Failed to allocate memory\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    batch->updates[batch->length++] = update;
+}
+
+/*
+ * @brief Queue an edge insertion
+ *
+ * @param UpdateBatch (pointer*)
+ * @param VertexId (from)
+ * @param VertexId (to)
+ * @param unsigned int (weight)
+ * @return void
+ *
+ */
+void queueEdgeInsertion(UpdateBatch *batch, VertexId from, VertexId to, unsigned int weight)
+{
+    EdgeUpdate update = { from, to, weight, false };
+    appendUpdate(batch, update);
+}
+
+/*
+ * @brief Queue an edge removal
+ *
+ * Removes every from -> to edge the graph holds
+ * when the batch is applied, including the ones
+ * inserted earlier in the same batch
+ *
+ * @param UpdateBatch (pointer*)
+ * @param VertexId (from)
+ * @param VertexId (to)
+ * @return void
+ *
+ */
+void queueEdgeRemoval(UpdateBatch *batch, VertexId from, VertexId to)
+{
+    EdgeUpdate update = { from, to, 0, true };
+    appendUpdate(batch, update);
+}
+
+/*
+ * @brief Free an update batch
+ *
+ * @param UpdateBatch (pointer*)
+ * @return void
+ *
+ */
+void freeUpdateBatch(UpdateBatch *batch)
+{
+    free(batch->updates);
+    initUpdateBatch(batch);
+}
+
+/*
+ * @brief Split the updates of a batch into directed updates
+ *
+ * An undirected graph stores every edge in both
+ * rows, so its updates change both rows too
+ *
+ * @param Graph (pointer*)
+ * @param UpdateBatch (pointer*)
+ * @param size_t (pointer*) => set to the number of directed updates
+ * @return DirectedUpdate pointer [array] (caller frees)
+ *
+ */
+static DirectedUpdate *expandUpdates(const Graph *graph, const UpdateBatch *batch, size_t *length)
+{
+    size_t perUpdate = graph->directed ? 1 : 2;
+    DirectedUpdate *updates = (DirectedUpdate *)malloc((batch->length * perUpdate + 1) * sizeof(DirectedUpdate));
+
+    if (updates == NULL)
+    {
+        perror("Failed to allocate memory\n");
+        exit(EXIT_FAILURE);
+    }
+
+    size_t count = 0;
+
+    for (size_t index = 0; index < batch->length; index++)
+    {
+        const EdgeUpdate *update = &batch->updates[index];
+        DirectedUpdate forward = { update->from, update->to, update->weight, update->removal, index };
+
+        updates[count++] = forward;
+
+        if (!graph->directed)
+        {
+            DirectedUpdate backward = { update->to, update->from, update->weight, update->removal, index };
+            updates[count++] = backward;
+        }
+    }
+
+    *length = count;
+
+    return updates;
+}
+
+/*
+ * @brief Order directed updates by edge, then by sequence
+ *
+ * @param void pointer (first DirectedUpdate)
+ * @param void pointer (second DirectedUpdate)
+ * @return int
+ *
+ */
+static int compareByEdge(const void *first, const void *second)
+{
+    const DirectedUpdate *left = (const DirectedUpdate *)first;
+    const DirectedUpdate *right = (const DirectedUpdate *)second;
+
+    if (left->from != right->from)
+    {
+        return left->from < right->from ? -1 : 1;
+    }
+
+    if (left->to != right->to)
+    {
+        return left->to < right->to ? -1 : 1;
+    }
+
+    if (left->sequence != right->sequence)
+    {
+        return left->sequence < right->sequence ? -1 : 1;
+    }
+
+    return 0;
+}
+
+/*
+ * @brief Order directed updates by row, then by sequence
+ *
+ * @param void pointer (first DirectedUpdate)
+ * @param void pointer (second DirectedUpdate)
+ * @return int
+ *
+ */
+static int compareBySequence(const void *first, const void *second)
+{
+    const DirectedUpdate *left = (const DirectedUpdate *)first;
+    const DirectedUpdate *right = (const DirectedUpdate *)second;
+
+    if (left->from != right->from)
+    {
+        return left->from < right->from ? -1 : 1;
+    }
+
+    if (left->sequence != right->sequence)
+    {
+        return left->sequence < right->sequence ? -1 : 1;
+    }
+
+    return 0;
+}
+
+/*
+ * @brief Settle the updates queued for every edge
+ *
+ * Updates must be sorted by edge. A removal cancels
+ * the insertions of the same edge queued before it,
+ * so only insertions after the last removal survive.
+ * Survivors are packed to the front of the array
+ *
+ * @param DirectedUpdate pointer [array] (updates, sorted by edge)
+ * @param size_t (length)
+ * @param EdgePairList (pointer*) => receives every removed edge once, sorted
+ * @return size_t (number of surviving insertions)
+ *
+ */
+static size_t selectSurvivors(DirectedUpdate *updates, size_t length, EdgePairList *removals)
+{
+    size_t survivors = 0;
+    size_t groupStart = 0;
+
+    while (groupStart < length)
+    {
+        size_t groupEnd = groupStart + 1;
+        size_t firstSurvivor = groupStart;
+
+        if (updates[groupStart].removal)
+        {
+            firstSurvivor = groupStart + 1;
+        }
+
+        while
+        (
+            groupEnd < length &&
+            updates[groupEnd].from == updates[groupStart].from &&
+            updates[groupEnd].to == updates[groupStart].to
+        )
+        {
+            if (updates[groupEnd].removal)
+            {
+                firstSurvivor = groupEnd + 1;
+            }
+
+            groupEnd++;
+        }
+
+        if (firstSurvivor > groupStart)
+        {
+            appendEdgePair(removals, updates[groupStart].from, updates[groupStart].to);
+        }
+
+        for (size_t index = firstSurvivor; index < groupEnd; index++)
+        {
+            updates[survivors++] = updates[index];
+        }
+
+        groupStart = groupEnd;
+    }
+
+    return survivors;
+}
+
+/*
+ * @brief Append an edge to a pair list
+ *
+ * @param EdgePairList (pointer*)
+ * @param VertexId (from)
+ * @param VertexId (to)
+ * @return void
+ *
+ */
+static void appendEdgePair(EdgePairList *list, VertexId from, VertexId to)
+{
+    if (list->length == list->capacity)
+    {
+        list->capacity = list->capacity == 0 ? INITIAL_BATCH_CAPACITY : list->capacity * 2;
+        list->sources = (VertexId *)realloc(list->sources, list->capacity * sizeof(VertexId));
+        list->targets = (VertexId *)realloc(list->targets, list->capacity * sizeof(VertexId));
+
+        if (list->sources == NULL || list->targets == NULL)
+        {
+            perror("Failed to allocate memory\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    list->sources[list->length] = from;
+    list->targets[list->length] = to;
+    list->length++;
+}
+
+/*
+ * @brief Free a pair list
+ *
+ * @param EdgePairList (pointer*)
+ * @return void
+ *
+ */
+static void freeEdgePairList(EdgePairList *list)
+{
+    free(list->sources);
+    free(list->targets);
+}
+
+/*
+ * @brief Merge settled updates into the adjacency
+ *
+ * Writes the new rows into a fresh arena in one
+ * pass and releases the old one. Untouched rows are
+ * copied whole, removed edges are dropped and
+ * inserted edges are appended to their row in the
+ * order they were queued, as if they came last in
+ * the graph file
+ *
+ * @param Graph (pointer*)
+ * @param DirectedUpdate pointer [array] (insertions, sorted by row and sequence)
+ * @param size_t (number of insertions)
+ * @param EdgePairList (pointer*) => removals, sorted by edge
+ * @param EdgePairList (pointer*) => receives every edge dropped, NULL if not needed
+ * @return void
+ *
+ * @note The incoming arrays are dropped and
+ *       rebuilt on the next traversal that needs them
+ *
+ */
+static void mergeRows
+(
+    Graph *graph,
+    const DirectedUpdate *insertions,
+    size_t noOfInsertions,
+    const EdgePairList *removals,
+    EdgePairList *removedEdges
+)
+{
+    unsigned int noOfNodes = graph->noOfNodes;
+    VertexId *removalStamps = (VertexId *)malloc(((size_t)noOfNodes + 1) * sizeof(VertexId));
+
+    if (removalStamps == NULL)
+    {
+        perror("Failed to allocate memory\n");
+        exit(EXIT_FAILURE);
+    }
+
+    for (VertexId vertex = 0; vertex < noOfNodes; vertex++)
+    {
+        removalStamps[vertex] = INVALID_VERTEX;
+    }
+
+    // removed edges can only shrink the adjacency
+    size_t capacity = graph->noOfEdges + noOfInsertions;
+
+    Arena arena;
+    initArena(&arena);
+
+    size_t *edgeOffsets = (size_t *)arenaAllocate(&arena, ((size_t)noOfNodes + 1) * sizeof(size_t));
+    VertexId *adjacentNodes = (VertexId *)arenaAllocate(&arena, (capacity + 1) * sizeof(VertexId));
+    unsigned int *edgeWeights = (unsigned int *)arenaAllocate(&arena, (capacity + 1) * sizeof(unsigned int));
+
+    uint64_t insertedWeight = 0, removedWeight = 0;
+    size_t edge = 0, nextInsertion = 0, nextRemoval = 0;
+
+    for (VertexId vertex = 0; vertex < noOfNodes; vertex++)
+    {
+        size_t rowStart = graph->edgeOffsets[vertex];
+        size_t rowEnd = graph->edgeOffsets[vertex + 1];
+        bool rowHasRemovals = false;
+
+        edgeOffsets[vertex] = edge;
+
+        while (nextRemoval < removals->length && removals->sources[nextRemoval] == vertex)
+        {
+            removalStamps[removals->targets[nextRemoval++]] = vertex;
+            rowHasRemovals = true;
+        }
+
+        if (!rowHasRemovals)
+        {
+            memcpy(adjacentNodes + edge, graph->adjacentNodes + rowStart, (rowEnd - rowStart) * sizeof(VertexId));
+            memcpy(edgeWeights + edge, graph->edgeWeights + rowStart, (rowEnd - rowStart) * sizeof(unsigned int));
+            edge += rowEnd - rowStart;
+        }
+        else
+        {
+            for (size_t oldEdge = rowStart; oldEdge < rowEnd; oldEdge++)
+            {
+                VertexId adjacentNode = graph->adjacentNodes[oldEdge];
+
+                if (removalStamps[adjacentNode] == vertex)
+                {
+                    removedWeight += graph->edgeWeights[oldEdge];
+
+                    if (removedEdges != NULL)
+                    {
+                        appendEdgePair(removedEdges, vertex, adjacentNode);
+                    }
+
+                    continue;
+                }
+
+                adjacentNodes[edge] = adjacentNode;
+                edgeWeights[edge] = graph->edgeWeights[oldEdge];
+                edge++;
+            }
+        }
+
+        while (nextInsertion < noOfInsertions && insertions[nextInsertion].from == vertex)
+        {
+            adjacentNodes[edge] = insertions[nextInsertion].to;
+            edgeWeights[edge] = insertions[nextInsertion].weight;
+            insertedWeight += insertions[nextInsertion].weight;
+            edge++;
+            nextInsertion++;
+        }
+    }
+
+    edgeOffsets[noOfNodes] = edge;
+
+    // both directions of an undirected edge count once in the total weight
+    if (!graph->directed)
+    {
+        insertedWeight /= 2;
+        removedWeight /= 2;
+    }
+
+    replaceGraphArena(graph, &arena);
+
+    graph->noOfEdges = edge;
+    graph->totalWeight += (unsigned int)insertedWeight - (unsigned int)removedWeight;
+    graph->edgeOffsets = edgeOffsets;
+    graph->adjacentNodes = adjacentNodes;
+    graph->edgeWeights = edgeWeights;
+
+    // inserted edges land at the end of their rows
+    graph->sortedRows = graph->sortedRows && noOfInsertions == 0;
+
+    free(removalStamps);
+}
+
+/*
+ * @brief Apply the queued updates of a batch
+ *
+ * Updates take effect in the order they were
+ * queued. The batch is left empty for reuse, and
+ * the distances of an incremental bfs are repaired
+ * for the vertices the batch can affect
+ *
+ * @param Graph (pointer*)
+ * @param UpdateBatch (pointer*)
+ * @param IncrementalBfs (pointer*) => distances to keep up to date, NULL for none
+ * @return void
+ *
+ * @note Every vertex of the batch must exist in the graph
+ *
+ */
+void applyUpdateBatch(Graph *graph, UpdateBatch *batch, IncrementalBfs *bfs)
+{
+    if (bfs != NULL)
+    {
+        bfs->distancesChanged = 0;
+        bfs->verticesExamined = 0;
+    }
+
+    if (batch->length == 0)
+    {
+        return;
+    }
+
+    size_t noOfUpdates;
+    DirectedUpdate *updates = expandUpdates(graph, batch, &noOfUpdates);
+    EdgePairList removals = { NULL, NULL, 0, 0 };
+    EdgePairList removedEdges = { NULL, NULL, 0, 0 };
+
+    qsort(updates, noOfUpdates, sizeof(DirectedUpdate), compareByEdge);
+    size_t noOfInsertions = selectSurvivors(updates, noOfUpdates, &removals);
+    qsort(updates, noOfInsertions, sizeof(DirectedUpdate), compareBySequence);
+
+    mergeRows(graph, updates, noOfInsertions, &removals, bfs != NULL ? &removedEdges : NULL);
+
+    if (bfs != NULL)
+    {
+        repairDistances(graph, bfs, &removedEdges, updates, noOfInsertions);
+    }
+
+    batch->length = 0;
+
+    freeEdgePairList(&removals);
+    freeEdgePairList(&removedEdges);
+    free(updates);
+}
+
+/*
+ * @brief Push a vertex onto a distance heap
+ *
+ * @param DistanceHeap (pointer*)
+ * @param unsigned int (distance)
+ * @param VertexId (vertex)
+ * @return void
+ *
+ */
+static void pushDistance(DistanceHeap *heap, unsigned int distance, VertexId vertex)
+{
+    if (heap->length == heap->capacity)
+    {
+        heap->capacity = heap->capacity == 0 ? INITIAL_BATCH_CAPACITY : heap->capacity * 2;
+        heap->keys = (uint64_t *)realloc(heap->keys, heap->capacity * sizeof(uint64_t));
+
+        if (heap->keys == NULL)
+        {
+            perror("Failed to allocate memory\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    uint64_t key = (uint64_t)distance << 32 | vertex;
+    size_t index = heap->length++;
+
+    while (index > 0 && heap->keys[(index - 1) / 2] > key)
+    {
+        heap->keys[index] = heap->keys[(index - 1) / 2];
+        index = (index - 1) / 2;
+    }
+
+    heap->keys[index] = key;
+}
+
+/*
+ * @brief Pop the closest vertex off a distance heap
+ *
+ * @param DistanceHeap (pointer*) => must not be empty
+ * @return uint64_t (distance << 32 | vertex)
+ *
+ */
+static uint64_t popDistance(DistanceHeap *heap)
+{
+    uint64_t top = heap->keys[0];
+    uint64_t last = heap->keys[--heap->length];
+    size_t index = 0;
+
+    while (2 * index + 1 < heap->length)
+    {
+        size_t child = 2 * index + 1;
+
+        if (child + 1 < heap->length && heap->keys[child + 1] < heap->keys[child])
+        {
+            child++;
+        }
+
+        if (heap->keys[child] >= last)
+        {
+            break;
+        }
+
+        heap->keys[index] = heap->keys[child];
+        index = child;
+    }
+
+    heap->keys[index] = last;
+
+    return top;
+}
+
+/*
+ * @brief Log the distance of a vertex before it changes
+ *
+ * Only the first change of a vertex is logged
+ *
+ * @param RepairLog (pointer*)
+ * @param IncrementalBfs (pointer*)
+ * @param VertexId (vertex)
+ * @return void
+ *
+ */
+static void recordDistance(RepairLog *log, const IncrementalBfs *bfs, VertexId vertex)
+{
+    if (testBit(&log->recorded, vertex))
+    {
+        return;
+    }
+
+    if (log->length == log->capacity)
+    {
+        log->capacity = log->capacity == 0 ? INITIAL_BATCH_CAPACITY : log->capacity * 2;
+        log->vertices = (VertexId *)realloc(log->vertices, log->capacity * sizeof(VertexId));
+        log->previousDistances = (unsigned int *)realloc
+        (
+            log->previousDistances, log->capacity * sizeof(unsigned int)
+        );
+
+        if (log->vertices == NULL || log->previousDistances == NULL)
+        {
+            perror("Failed to allocate memory\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    setBit(&log->recorded, vertex);
+    log->vertices[log->length] = vertex;
+    log->previousDistances[log->length] = bfs->distances[vertex];
+    log->length++;
+}
+
+/*
+ * @brief Check that a vertex still has a parent one hop closer
+ *
+ * @param IncrementalBfs (pointer*)
+ * @param Bitmap (pointer*) => vertices whose distance no longer holds
+ * @param size_t pointer [array] (backward offsets) => incoming rows, or outgoing ones if undirected
+ * @param VertexId pointer [array] (backward nodes)
+ * @param VertexId (vertex)
+ * @return bool
+ *
+ */
+static bool hasSupport
+(
+    const IncrementalBfs *bfs,
+    const Bitmap *invalidated,
+    const size_t *backwardOffsets,
+    const VertexId *backwardNodes,
+    VertexId vertex
+)
+{
+    unsigned int distance = bfs->distances[vertex];
+
+    for (size_t edge = backwardOffsets[vertex]; edge < backwardOffsets[vertex + 1]; edge++)
+    {
+        VertexId parent = backwardNodes[edge];
+
+        if (bfs->distances[parent] + 1 == distance && !testBit(invalidated, parent))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*
+ * @brief Repair bfs distances after a batch
+ *
+ * Works in three steps, each confined to the
+ * region the batch affects
+ *   1. Vertices that lost the edge to their parent
+ *      look for another parent one hop closer. Those
+ *      without one are invalidated, which in turn
+ *      sends their children looking, closest first
+ *   2. Invalidated vertices take the best distance
+ *      their remaining parents offer, and inserted
+ *      edges offer shorter distances to their targets
+ *   3. Improved vertices relax their neighbours,
+ *      closest first, until no distance improves
+ *
+ * @param Graph (pointer*) => graph after the batch
+ * @param IncrementalBfs (pointer*)
+ * @param EdgePairList (pointer*) => edges the batch removed
+ * @param DirectedUpdate pointer [array] (insertions) => edges the batch inserted
+ * @param size_t (number of insertions)
+ * @return void
+ *
+ */
+static void repairDistances
+(
+    Graph *graph,
+    IncrementalBfs *bfs,
+    const EdgePairList *removedEdges,
+    const DirectedUpdate *insertions,
+    size_t noOfInsertions
+)
+{
+    unsigned int *distances = bfs->distances;
+    const size_t *backwardOffsets = graph->edgeOffsets;
+    const VertexId *backwardNodes = graph->adjacentNodes;
+
+    if (graph->directed)
+    {
+        buildIncomingArrays(graph);
+        backwardOffsets = graph->incomingOffsets;
+        backwardNodes = graph->incomingNodes;
+    }
+
+    Bitmap invalidated;
+    initBitmap(&invalidated, graph->noOfNodes);
+
+    RepairLog log = { { NULL, 0, 0 }, NULL, NULL, 0, 0 };
+    initBitmap(&log.recorded, graph->noOfNodes);
+
+    DistanceHeap heap = { NULL, 0, 0 };
+    VertexId *invalidList = NULL;
+    size_t noOfInvalid = 0, invalidCapacity = 0;
+
+    // 1. find the vertices left without a parent
+    for (size_t index = 0; index < removedEdges->length; index++)
+    {
+        VertexId from = removedEdges->sources[index];
+        VertexId to = removedEdges->targets[index];
+
+        if (distances[from] != UNREACHED_DISTANCE && distances[to] == distances[from] + 1)
+        {
+            pushDistance(&heap, distances[to], to);
+        }
+    }
+
+    while (heap.length > 0)
+    {
+        uint64_t key = popDistance(&heap);
+        VertexId vertex = (VertexId)key;
+        unsigned int distance = (unsigned int)(key >> 32);
+
+        if (testBit(&invalidated, vertex))
+        {
+            continue;
+        }
+
+        bfs->verticesExamined++;
+
+        if (hasSupport(bfs, &invalidated, backwardOffsets, backwardNodes, vertex))
+        {
+            continue;
+        }
+
+        setBit(&invalidated, vertex);
+
+        if (noOfInvalid == invalidCapacity)
+        {
+            invalidCapacity = invalidCapacity == 0 ? INITIAL_BATCH_CAPACITY : invalidCapacity * 2;
+            invalidList = (VertexId *)realloc(invalidList, invalidCapacity * sizeof(VertexId));
+
+            if (invalidList == NULL)
+            {
+                perror("Failed to allocate memory\n");
+                exit(EXIT_FAILURE);
+            }
+        }
+
+        invalidList[noOfInvalid++] = vertex;
+
+        for (size_t edge = graph->edgeOffsets[vertex]; edge < graph->edgeOffsets[vertex + 1]; edge++)
+        {
+            VertexId adjacentNode = graph->adjacentNodes[edge];
+
+            if (distances[adjacentNode] == distance + 1 && !testBit(&invalidated, adjacentNode))
+            {
+                pushDistance(&heap, distance + 1, adjacentNode);
+            }
+        }
+    }
+
+    // 2. seed the search with what the remaining parents and new edges offer
+    for (size_t index = 0; index < noOfInvalid; index++)
+    {
+        recordDistance(&log, bfs, invalidList[index]);
+        distances[invalidList[index]] = UNREACHED_DISTANCE;
+    }
+
+    for (size_t index = 0; index < noOfInvalid; index++)
+    {
+        VertexId vertex = invalidList[index];
+
+        for (size_t edge = backwardOffsets[vertex]; edge < backwardOffsets[vertex + 1]; edge++)
+        {
+            VertexId parent = backwardNodes[edge];
+
+            if (distances[parent] != UNREACHED_DISTANCE && distances[parent] + 1 < distances[vertex])
+            {
+                distances[vertex] = distances[parent] + 1;
+            }
+        }
+
+        if (distances[vertex] != UNREACHED_DISTANCE)
+        {
+            pushDistance(&heap, distances[vertex], vertex);
+        }
+    }
+
+    for (size_t index = 0; index < noOfInsertions; index++)
+    {
+        VertexId from = insertions[index].from;
+        VertexId to = insertions[index].to;
+
+        if (distances[from] != UNREACHED_DISTANCE && distances[from] + 1 < distances[to])
+        {
+            recordDistance(&log, bfs, to);
+            distances[to] = distances[from] + 1;
+            pushDistance(&heap, distances[to], to);
+        }
+    }
+
+    // 3. spread the improvements
+    while (heap.length > 0)
+    {
+        uint64_t key = popDistance(&heap);
+        VertexId vertex = (VertexId)key;
+        unsigned int distance = (unsigned int)(key >> 32);
+
+        if (distance != distances[vertex])
+        {
+            continue; // improved again after this push
+        }
+
+        bfs->verticesExamined++;
+
+        for (size_t edge = graph->edgeOffsets[vertex]; edge < graph->edgeOffsets[vertex + 1]; edge++)
+        {
+            VertexId adjacentNode = graph->adjacentNodes[edge];
+
+            if (distance + 1 < distances[adjacentNode])
+            {
+                recordDistance(&log, bfs, adjacentNode);
+                distances[adjacentNode] = distance + 1;
+                pushDistance(&heap, distance + 1, adjacentNode);
+            }
+        }
+    }
+
+    for (size_t index = 0; index < log.length; index++)
+    {
+        VertexId vertex = log.vertices[index];
+        unsigned int previousDistance = log.previousDistances[index];
+
+        if (previousDistance == distances[vertex])
+        {
+            continue;
+        }
+
+        bfs->distancesChanged++;
+
+        if (previousDistance == UNREACHED_DISTANCE)
+        {
+            bfs->traversalLength++;
+        }
+        else if (distances[vertex] == UNREACHED_DISTANCE)
+        {
+            bfs->traversalLength--;
+        }
+    }
+
+    freeBitmap(&invalidated);
+    freeBitmap(&log.recorded);
+    free(log.vertices);
+    free(log.previousDistances);
+    free(heap.keys);
+    free(invalidList);
+}
+
+/*
+ * @brief Start tracking bfs distances from a source
+ *
+ * Runs one full bfs, later batches only repair it
+ *
+ * @param IncrementalBfs (pointer*)
+ * @param Graph (pointer*)
+ * @param VertexId (source)
+ * @return void
+ *
+ */
+void initIncrementalBfs(IncrementalBfs *bfs, Graph *graph, VertexId source)
+{
+    BfsTree tree;
+    computeBfsTree(graph, source, &tree);
+
+    bfs->source = source;
+    bfs->distances = tree.distances;
+    bfs->traversalLength = tree.traversalLength;
+    bfs->distancesChanged = 0;
+    bfs->verticesExamined = tree.traversalLength;
+
+    free(tree.parents);
+}
+
+/*
+ * @brief Free an incremental bfs
+ *
+ * @param IncrementalBfs (pointer*)
+ * @return void
+ *
+ */
+void freeIncrementalBfs(IncrementalBfs *bfs)
+{
+    free(bfs->distances);
+    bfs->distances = NULL;
+}
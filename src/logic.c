@@ -1,8 +1,46 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <string.h>
 #include "types.h"
 #include "logic.h"
+#include "bitmap.h"
+#include "bfsVisitor.h"
+#include "compressedGraph.h"
+#include "connectedComponents.h"
+#include "directionOptimizing.h"
+#include "distributedBfs.h"
+#include "externalBfs.h"
+#include "multiSourceBfs.h"
+#include "numaBfs.h"
+#include "parallelBfs.h"
+#include "reorder.h"
+#include "shortestPath.h"
+#include "graphSnapshot.h"
+#include "traversalContext.h"
+#include "vertexDictionary.h"
+#include "weightedPaths.h"
+
+/*
+ * @brief Path printer data structure
+ *
+ * PathPrinter struct is the context of the visitor
+ * that prints a traversal while it runs
+ * 
+ * @member VertexDictionary (pointer*) => names of the vertices
+ * @member unsigned int (total weight) => printed between the path and the unreachable nodes
+ * @member unsigned int (number of printed nodes) => path nodes printed so far
+ * @member unsigned int (number of unreachable nodes) => unreachable nodes printed so far
+ * @member bool (path finished) => path line and total weight have been printed
+ *
+ */
+typedef struct PathPrinter {
+    const VertexDictionary *dictionary;
+    unsigned int totalWeight;
+    unsigned int noOfPrintedNodes;
+    unsigned int noOfUnreachableNodes;
+    bool pathFinished;
+} PathPrinter;
 
 /*
  * @brief declarations for internal functions
@@ -12,327 +50,571 @@
  * 
  * @note all internal functions are static
  */
-static void initQueue(unsigned int noOfNodes);
-static void initVisitedArray(unsigned int noOfNodes);
 static void initTraversalStats(TraversalStats *traversalStats);
-static void enqueue(char value);
-static char dequeue();
-static bool isVisited(char value);
-static void trackTraversalPath(TraversalStats *traversalStats, char value);
-static void getUnreachableNodes(TraversalStats *traversalStats, unsigned int noOfNodes);
-static TraversalStats bfsAlgorithm(Graph *graph);
-static void freeTraversalStats(TraversalStats *traversalStats);
-static void printTraversalPath(char *traversalPath, unsigned int traversalLength);
+static VertexId *allocateTraversalPath(unsigned int noOfNodes);
+static unsigned int collectUnreachableNodes(const TraversalContext *context, const Graph *graph);
+static unsigned int topDownTraversal
+(
+    const Graph *graph,
+    const TraversalOptions *options,
+    TraversalContext *context,
+    size_t *edgesExamined
+);
+static unsigned int compressedTopDownTraversal
+(
+    const Graph *graph,
+    const TraversalOptions *options,
+    TraversalContext *context,
+    size_t *edgesExamined
+);
+static unsigned int runTraversalKernel
+(
+    Graph *graph,
+    const TraversalOptions *options,
+    TraversalContext *context,
+    size_t *edgesExamined
+);
+static void printDiscoveredNode(VertexId vertex, unsigned int level, void *context);
+static void finishPrintedPath(PathPrinter *printer);
+static void printUnreachableNode(VertexId vertex, void *context);
+static void displayProfiledTraversal(Graph *graph, const TraversalOptions *options);
+static VertexId findNamedVertex(const Graph *graph, const char *name);
+static void printTraversalPath
+(
+    const VertexDictionary *dictionary,
+    VertexId *traversalPath,
+    unsigned int traversalLength
+);
 static void printTotalWeight(unsigned int totalWeight);
-static void printUnReachableNodes(char *unReachableNodes, unsigned int unReachableLength);
+static void printEdgesExamined(size_t edgesExamined);
+static void printNumaBalance(const NumaBalance *balance);
+static void writeTraversalProfile
+(
+    const Graph *graph,
+    const TraversalOptions *options,
+    const TraversalProfile *profile
+);
+static void printUnReachableNodes
+(
+    const VertexDictionary *dictionary,
+    VertexId *unReachableNodes,
+    unsigned int unReachableLength
+);
 
 /*
- * @brief Queue data structure (array)
- *
- * Keeps track of nodes that needs to be 
- * visited when traversing the graph
+ * @brief Initializes TraversalStats struct
  * 
- * @note This variable has global scope
+ * @param TraversalStats (pointer*)
+ * @return void
  * 
  */
-char *queue;
+static void initTraversalStats(TraversalStats *traversalStats)
+{
+    traversalStats->traversalLength = 0;
+    traversalStats->unReachableLength = 0;
+    traversalStats->traversalPath = NULL;
+    traversalStats->unReachableNodes = NULL;
+    traversalStats->edgesExamined = 0;
+}
 
 /*
- * @brief Visited data structure (array)
- *
- * Keeps track of nodes that have been
- * visited when traversing the graph by
- * setting the relavant index to true/false
+ * @brief Initializes TraversalOptions struct
  * 
- * @note This variable has global scope
- * 
- */
-bool *visited;
-
-/*
- * @brief Front and Rear pointers for Queue
- *
- * Track the front and rear of the queue
+ * Defaults to the top-down traversal with
+ * the usual direction optimizing thresholds
  * 
- * @note These variables have global scope
- * @note Value -1 indicates empty queue
- * @warning front > rear results in queue being full
+ * @param TraversalOptions (pointer*)
+ * @return void
  * 
  */
-int front = -1, rear = -1;
+void initTraversalOptions(TraversalOptions *options)
+{
+    options->mode = TOP_DOWN_TRAVERSAL;
+    options->alpha = 15;
+    options->beta = 18;
+    options->noOfThreads = 0;
+    options->deterministic = false;
+    options->delta = 0;
+    options->verbose = false;
+    options->statsFileName = NULL;
+    options->hardwareCounters = false;
+    options->profile = NULL;
+    options->visitor = NULL;
+    options->numaBalance = NULL;
+}
 
 /*
- * @brief Initializes Queue Data Structure
+ * @brief Allocate a traversal path
+ * 
+ * The path is sized for every node up front
+ * so kernels never grow it
  * 
  * @param unsigned int (number of nodes)
- * @return void
+ * @return VertexId pointer [array]
  * 
  */
-static void initQueue(unsigned int noOfNodes)
+static VertexId *allocateTraversalPath(unsigned int noOfNodes)
 {
-    queue = (char *)malloc(noOfNodes * sizeof(char));
+    VertexId *traversalPath = (VertexId *)malloc(((size_t)noOfNodes + 1) * sizeof(VertexId));
 
-    if (queue == NULL)
+    if (traversalPath == NULL)
     {
         perror("Failed to allocate memory\n");
         exit(EXIT_FAILURE);
     }
+
+    return traversalPath;
 }
 
 /*
- * @brief Initializes Visited Data Structure
+ * @brief Collect unreachable nodes
  * 
- * @param unsigned int (number of nodes)
- * @return void
+ * Vertices the top-down kernel did not stamp
+ * with the current epoch are unreachable. The
+ * visited bitmap of the other kernels is scanned
+ * with collectClearBits. A reordered graph is
+ * walked in node list order instead
+ * 
+ * @param TraversalContext (pointer*) => right after a traversal
+ * @param Graph (pointer*)
+ * @return unsigned int (number of unreachable nodes)
  * 
  */
-static void initVisitedArray(unsigned int noOfNodes)
+static unsigned int collectUnreachableNodes(const TraversalContext *context, const Graph *graph)
 {
-    visited = (bool *)malloc(noOfNodes * sizeof(char));
+    unsigned int noOfNodes = graph->noOfNodes;
+    unsigned int unReachableLength = 0;
+    VertexId *unReachableNodes = context->unReachableNodes;
 
-    if (visited == NULL)
+    if (!context->bitmapInUse || graph->vertexOrder != NULL)
     {
-        perror("Failed to allocate memory\n");
-        exit(EXIT_FAILURE);
-    }
+        for (VertexId position = 0; position < noOfNodes; position++)
+        {
+            VertexId vertex = getListedVertex(graph, position);
+            bool visited = context->bitmapInUse ?
+                testBit(&context->visited, vertex) : context->visitMarks[vertex] == context->epoch;
 
-    for (size_t index = 0; index < noOfNodes; index++)
-    {
-        visited[index] = false;
+            if (!visited)
+            {
+                unReachableNodes[unReachableLength++] = vertex;
+            }
+        }
+
+        return unReachableLength;
     }
-}
 
-/*
- * @brief Initializes TraversalStats struct
- * 
- * @param TraversalStats (pointer*)
- * @return void
- * 
- */
-static void initTraversalStats(TraversalStats *traversalStats)
-{
-    traversalStats->traversalLength = 0;
-    traversalStats->unReachableLength = 0;
-    traversalStats->traversalPath = NULL;
-    traversalStats->unReachableNodes = NULL;
+    return (unsigned int)collectClearBits(&context->visited, unReachableNodes);
 }
 
 /*
- * @brief Enqueue function
+ * @brief Top-down traversal
  * 
- * Adds a value to the rear of
- * the queue array
+ * Classic queue based bfs. Traverses the
+ * graph and keeps track of relavant data.
+ * The queue lives in the traversal path and
+ * vertices are marked with the context's epoch
  * 
- * @param char (value)
- * @return void
+ * @param Graph (pointer*)
+ * @param TraversalOptions (pointer*)
+ * @param TraversalContext (pointer*)
+ * @param size_t (pointer*) => receives number of edges examined
+ * @return unsigned int (traversal length)
  * 
  */
-static void enqueue(char value)
+static unsigned int topDownTraversal
+(
+    const Graph *graph,
+    const TraversalOptions *options,
+    TraversalContext *context,
+    size_t *edgesExamined
+)
 {
-    if (front == -1)
+    *edgesExamined = 0;
+
+    if (graph->noOfNodes == 0)
+    {
+        return 0;
+    }
+
+    VertexId *queue = context->traversalPath;
+    unsigned char *visitMarks = context->visitMarks;
+    unsigned char epoch = context->epoch;
+    unsigned int front = 0, rear = 0;
+
+    // traversal starts from the first node in the node list
+    VertexId source = getListedVertex(graph, 0);
+    queue[rear++] = source;
+    visitMarks[source] = epoch;
+
+    unsigned int levelStart = 0, levelEnd = 1, level = 0;
+
+    while (front < rear)
     {
-        front = 0;
+        PROFILE_QUEUE_LEVEL(options->profile, front, rear, *edgesExamined);
+
+        // the front reaching the end of a level means the next one is complete
+        if (front == levelEnd)
+        {
+            visitLevel(options->visitor, queue, levelStart, levelEnd, level++);
+            levelStart = levelEnd;
+            levelEnd = rear;
+        }
+
+        VertexId visitedNode = queue[front++];
+
+        size_t rowStart = graph->edgeOffsets[visitedNode];
+        size_t rowEnd = graph->edgeOffsets[visitedNode + 1];
+
+        *edgesExamined += rowEnd - rowStart;
+
+        // neighbours of a vertex sit next to each other in memory
+        for (size_t edge = rowStart; edge < rowEnd; edge++)
+        {
+            VertexId adjacentNode = graph->adjacentNodes[edge];
+
+            if (visitMarks[adjacentNode] != epoch)
+            {
+                visitMarks[adjacentNode] = epoch;
+                queue[rear++] = adjacentNode;
+            }
+        }
     }
-    rear++;
 
-    queue[rear] = value;
+    visitLevel(options->visitor, queue, levelStart, levelEnd, level);
+
+    PROFILE_FINISH(options->profile, *edgesExamined, rear);
 
+    return rear;
 }
 
 /*
- * @brief Dequeue function
+ * @brief Top-down traversal of a compressed graph
  * 
- * Removes a value from the front of
- * the queue array and returns it
+ * Same queue and epoch marks as the top-down
+ * traversal, but every row is decoded from its
+ * varint gaps while it is scanned. Rows are sorted,
+ * so neighbours are visited in ascending id order
+ * within each row and the path can differ from the
+ * one the uncompressed rows give
  * 
- * @param char (value)
- * @return char 
+ * @param Graph (pointer*) => compressed
+ * @param TraversalOptions (pointer*)
+ * @param TraversalContext (pointer*)
+ * @param size_t (pointer*) => receives number of edges examined
+ * @return unsigned int (traversal length)
  * 
  */
-static char dequeue()
+static unsigned int compressedTopDownTraversal
+(
+    const Graph *graph,
+    const TraversalOptions *options,
+    TraversalContext *context,
+    size_t *edgesExamined
+)
 {
-    if (front == -1 || front > rear)
+    *edgesExamined = 0;
+
+    if (graph->noOfNodes == 0)
     {
-        perror("Queue is empty");
-        exit(EXIT_FAILURE);
+        return 0;
+    }
+
+    const size_t *rowOffsets = graph->compressed->rowOffsets;
+    const uint8_t *rows = graph->compressed->rows;
+    VertexId *queue = context->traversalPath;
+    unsigned char *visitMarks = context->visitMarks;
+    unsigned char epoch = context->epoch;
+    unsigned int front = 0, rear = 0;
+
+    VertexId source = getListedVertex(graph, 0);
+    queue[rear++] = source;
+    visitMarks[source] = epoch;
+
+    unsigned int levelStart = 0, levelEnd = 1, level = 0;
+
+    while (front < rear)
+    {
+        PROFILE_QUEUE_LEVEL(options->profile, front, rear, *edgesExamined);
+
+        if (front == levelEnd)
+        {
+            visitLevel(options->visitor, queue, levelStart, levelEnd, level++);
+            levelStart = levelEnd;
+            levelEnd = rear;
+        }
+
+        VertexId visitedNode = queue[front++];
+
+        const uint8_t *bytes = rows + rowOffsets[visitedNode];
+        const uint8_t *rowEnd = rows + rowOffsets[visitedNode + 1];
+        uint64_t value;
+
+        if (bytes == rowEnd)
+        {
+            continue;
+        }
+
+        // the first varint is relative to the vertex, every later one to the previous neighbour
+        bytes = readVarint(bytes, &value);
+        VertexId adjacentNode = decodeFirstNeighbour(visitedNode, value);
+
+        while (true)
+        {
+            (*edgesExamined)++;
+
+            if (visitMarks[adjacentNode] != epoch)
+            {
+                visitMarks[adjacentNode] = epoch;
+                queue[rear++] = adjacentNode;
+            }
+
+            if (bytes == rowEnd)
+            {
+                break;
+            }
+
+            bytes = readVarint(bytes, &value);
+            adjacentNode += (VertexId)value;
+        }
     }
 
-    char removedValue = queue[front];
-    front++;
+    visitLevel(options->visitor, queue, levelStart, levelEnd, level);
+
+    PROFILE_FINISH(options->profile, *edgesExamined, rear);
 
-    return removedValue;
+    return rear;
 }
 
 /*
- * @brief Check if a node is visited
+ * @brief Run the selected traversal kernel
  * 
- * @param char (value)
- * @return bool
+ * Compressed graphs only have a top-down kernel
+ * 
+ * @param Graph (pointer*)
+ * @param TraversalOptions (pointer*)
+ * @param TraversalContext (pointer*) => reset
+ * @param size_t (pointer*) => receives number of edges examined
+ * @return unsigned int (traversal length)
  * 
  */
-static bool isVisited(char value)
+static unsigned int runTraversalKernel
+(
+    Graph *graph,
+    const TraversalOptions *options,
+    TraversalContext *context,
+    size_t *edgesExamined
+)
 {
-    return visited[value - 'A'];
+    if (graph->compressed != NULL)
+    {
+        return compressedTopDownTraversal(graph, options, context, edgesExamined);
+    }
+
+    switch (options->mode)
+    {
+        case PARALLEL_TRAVERSAL:
+            context->bitmapInUse = true;
+            return parallelTraversal(graph, options, &context->visited, context->traversalPath, edgesExamined);
+        case NUMA_TRAVERSAL:
+            context->bitmapInUse = true;
+            return numaTraversal(graph, options, &context->visited, context->traversalPath, edgesExamined);
+        case DIRECTION_OPTIMIZING_TRAVERSAL:
+            context->bitmapInUse = true;
+            return directionOptimizingTraversal
+            (
+                graph, options, &context->visited, context->traversalPath, edgesExamined
+            );
+        default:
+            return topDownTraversal(graph, options, context, edgesExamined);
+    }
 }
 
 /*
- * @brief Track path of bfs traversal
+ * @brief Breadth First Search on a reusable context
  * 
- * Keeps track of nodes that are visited
- * during bfs and adds these node names to
- * a dynamic char array
+ * Resets the context, runs the selected bfs
+ * kernel and collects the nodes it could not
+ * reach. A visitor in the options gets every level
+ * as soon as it is complete, then the unreachable
+ * nodes. Nothing is allocated
  * 
- * @param TraversalStats (pointer*)
- * @param char (value)
+ * @param TraversalContext (pointer*) => sized for the graph
+ * @param Graph (pointer*)
+ * @param TraversalOptions (pointer*)
+ * @param TraversalStats (pointer*) => arrays point into the context and stay
+ *                                     valid until its next traversal
  * @return void
  * 
+ * @note Threads may traverse one graph at once, each with a context of its own
+ * 
  */
-static void trackTraversalPath(TraversalStats *traversalStats, char value)
+void runTraversal
+(
+    TraversalContext *context,
+    Graph *graph,
+    const TraversalOptions *options,
+    TraversalStats *traversalStats
+)
 {
-    if (traversalStats->traversalPath == NULL)
-    {
-        char *newTraversalPath = (char *)malloc(sizeof(char));
+    resetTraversalContext(context);
 
-        if (newTraversalPath == NULL)
-        {
-            perror("Failed to allocate memory\n");
-            exit(EXIT_FAILURE);
-        }
+    initTraversalStats(traversalStats);
 
-        *newTraversalPath = value;
-        traversalStats->traversalPath = newTraversalPath;
-    }
-    else
-    {
-        char *updatedTraversalPath = (char *)realloc
-        (
-            traversalStats->traversalPath, (traversalStats->traversalLength+1) * sizeof(char)
-        );
+    traversalStats->traversalPath = context->traversalPath;
+    traversalStats->traversalLength = runTraversalKernel
+    (
+        graph, options, context, &traversalStats->edgesExamined
+    );
+    context->traversalLength = traversalStats->traversalLength;
+
+    traversalStats->unReachableNodes = context->unReachableNodes;
+    traversalStats->unReachableLength = collectUnreachableNodes(context, graph);
 
-        if (updatedTraversalPath == NULL)
+    const BfsVisitor *visitor = options->visitor;
+
+    if (visitor != NULL && visitor->onUnreachable != NULL)
+    {
+        for (unsigned int index = 0; index < traversalStats->unReachableLength; index++)
         {
-            perror("Failed to allocate memory");
-            exit(EXIT_FAILURE);
+            visitor->onUnreachable(traversalStats->unReachableNodes[index], visitor->context);
         }
-
-        updatedTraversalPath[traversalStats->traversalLength] = value;
-        traversalStats->traversalPath = updatedTraversalPath;
     }
-    traversalStats->traversalLength++; // increment count of nodes traversed
 }
 
 /*
- * @brief Get unreachable node names
+ * @brief Breadth First Search Algorithm
  * 
- * Get the names of nodes that are
- * unreachable and adds these to a
- * dynamic char array
+ * Runs the selected bfs kernel and collects
+ * the nodes it could not reach
  * 
- * @param TraversalStats (pointer*)
- * @param unsigned int (number of nodes)
- * @return void
+ * @param Graph (pointer*)
+ * @param TraversalOptions (pointer*)
+ * @return TraversalStats
+ * 
+ * @note Sets up a context for this one call, callers
+ *       traversing often should keep one and use runTraversal
  * 
  */
-static void getUnreachableNodes(TraversalStats *traversalStats, unsigned int noOfNodes)
+TraversalStats bfsAlgorithm(Graph *graph, const TraversalOptions *options)
 {
-    char *unreachableNodes = NULL;
-    
-    for (size_t index = 0; index < noOfNodes; index++)
-    {
-        if (!visited[index])
-        {
-            if (unreachableNodes == NULL)
-            {
-                unreachableNodes = (char *)malloc(sizeof(char));
-
-                if (unreachableNodes == NULL)
-                {
-                    perror("Failed to allocate memory\n");
-                    exit(EXIT_FAILURE);
-                }
+    TraversalContext context;
+    TraversalStats traversalStats;
 
-                *unreachableNodes = (char)(index + 'A');
-            }
-            else
-            {
-                unreachableNodes = (char *)realloc
-                (
-                    unreachableNodes,
-                    (traversalStats->unReachableLength + 1) * sizeof(char)
-                );
-
-                if (unreachableNodes == NULL)
-                {
-                    perror("Failed to allocate memory\n");
-                    exit(EXIT_FAILURE);
-                }
-
-                unreachableNodes[traversalStats->unReachableLength] = (char)(index + 'A');
-            }
+    initTraversalContext(&context, graph->noOfNodes);
 
+    runTraversal(&context, graph, options, &traversalStats);
 
-            traversalStats->unReachableLength++;
-        }
-    }
+    // the stats keep the path and unreachable arrays
+    context.traversalPath = NULL;
+    context.unReachableNodes = NULL;
+    freeTraversalContext(&context);
 
-    traversalStats->unReachableNodes = unreachableNodes; // attach dynamic array to struct
+    return traversalStats;
 }
 
 /*
- * @brief Breadth First Search Algorithm
+ * @brief Breadth First Search with a visitor
  * 
- * Contains logic of bfs algorithm
- * Traverses the graph and keeps track of
- * relavant data
+ * Runs the selected bfs kernel and streams every
+ * level to the visitor as soon as it is complete,
+ * then the nodes it could not reach. Nothing is
+ * kept once the call returns
  * 
  * @param Graph (pointer*)
- * @return TraversalStats
+ * @param TraversalOptions (pointer*)
+ * @param BfsVisitor (pointer*)
+ * @return size_t (edges examined)
+ * 
+ * @note Callbacks run on the calling thread
  * 
  */
-static TraversalStats bfsAlgorithm(Graph *graph)
+size_t visitTraversal(Graph *graph, const TraversalOptions *options, const BfsVisitor *visitor)
 {
-    TraversalStats traversalStats;
+    TraversalOptions visitedOptions = *options;
+    visitedOptions.visitor = visitor;
 
-    initTraversalStats(&traversalStats);
+    TraversalContext context;
+    TraversalStats traversalStats;
 
-    initQueue(graph->noOfNodes);
-    initVisitedArray(graph->noOfNodes);
+    initTraversalContext(&context, graph->noOfNodes);
 
-    char startNodeName = graph->nodeList[0];
-    enqueue(startNodeName);
+    runTraversal(&context, graph, &visitedOptions, &traversalStats);
 
-    while (front <= rear)
-    {
-        char visitedNodeName = dequeue();
+    freeTraversalContext(&context);
 
-        if (!isVisited(visitedNodeName))
-        {
-            visited[visitedNodeName - 'A'] = true;
-            trackTraversalPath(&traversalStats, visitedNodeName);
-        }
+    return traversalStats.edgesExamined;
+}
 
-        GraphNode *currentNode = graph->adjacentLists[visitedNodeName - 'A'];
+/*
+ * @brief Print a discovered node
+ * 
+ * @param VertexId (vertex)
+ * @param unsigned int (level)
+ * @param void pointer (PathPrinter)
+ * @return void
+ * 
+ */
+static void printDiscoveredNode(VertexId vertex, unsigned int level, void *context)
+{
+    PathPrinter *printer = (PathPrinter *)context;
+    (void)level;
 
-        while (currentNode != NULL)
-        {
-            if (!isVisited(currentNode->nodeName))
-            {
-                enqueue(currentNode->nodeName);
-                visited[currentNode->nodeName - 'A'] = true;
-                trackTraversalPath(&traversalStats, currentNode->nodeName);
-            }
+    if (printer->noOfPrintedNodes++ == 0)
+    {
+        printf("BFS Traversal Path: %s", getVertexName(printer->dictionary, vertex));
+    }
+    else
+    {
+        printf(" -> %s", getVertexName(printer->dictionary, vertex));
+    }
+}
 
-            currentNode = currentNode->next;
-        }
+/*
+ * @brief Finish the printed path
+ * 
+ * Ends the path line, prints the total weight
+ * and starts the unreachable nodes line
+ * 
+ * @param PathPrinter (pointer*)
+ * @return void
+ * 
+ */
+static void finishPrintedPath(PathPrinter *printer)
+{
+    if (printer->noOfPrintedNodes == 0)
+    {
+        printf("BFS Traversal Path: None");
     }
 
-    getUnreachableNodes(&traversalStats, graph->noOfNodes);
+    printf("\n");
+    printTotalWeight(printer->totalWeight);
+    printf("Unreachable Nodes: ");
+
+    printer->pathFinished = true;
+}
 
-    // free dynamically allocated structures
-    free(queue);
-    free(visited);
+/*
+ * @brief Print an unreachable node
+ * 
+ * @param VertexId (vertex)
+ * @param void pointer (PathPrinter)
+ * @return void
+ * 
+ */
+static void printUnreachableNode(VertexId vertex, void *context)
+{
+    PathPrinter *printer = (PathPrinter *)context;
 
-    return traversalStats;
+    if (!printer->pathFinished)
+    {
+        finishPrintedPath(printer);
+    }
+
+    printf
+    (
+        "%s%s", printer->noOfUnreachableNodes++ == 0 ? "" : ", ",
+        getVertexName(printer->dictionary, vertex)
+    );
 }
 
 /*
@@ -341,17 +623,23 @@ static TraversalStats bfsAlgorithm(Graph *graph)
  * Displays traversal path in the below format
  * Node Name 1 -> Node Name 2
  * 
- * @param char pointer [array]
+ * @param VertexDictionary (pointer*)
+ * @param VertexId pointer [array]
  * @param unsigned int (traversed path count)
  * @return void
  * 
  */
-static void printTraversalPath(char *traversalPath, unsigned int traversalLength)
+static void printTraversalPath
+(
+    const VertexDictionary *dictionary,
+    VertexId *traversalPath,
+    unsigned int traversalLength
+)
 {
     printf("BFS Traversal Path: ");
     for (size_t index = 0; index < traversalLength; index++)
     {
-        printf("%c", traversalPath[index]);
+        printf("%s", getVertexName(dictionary, traversalPath[index]));
         if (index + 1 != traversalLength)
         {
             printf(" -> ");
@@ -378,23 +666,136 @@ static void printTotalWeight(unsigned int totalWeight)
     printf("Total weight: %u\n", totalWeight);
 }
 
+/*
+ * @brief Display number of edges examined
+ * 
+ * @param size_t (edges examined)
+ * @return void
+ * 
+ */
+static void printEdgesExamined(size_t edgesExamined)
+{
+    printf("Edges examined: %zu\n", edgesExamined);
+}
+
+/*
+ * @brief Display how a numa traversal spread its work
+ * 
+ * Displays the below lines, nothing if the
+ * traversal did not run on the numa kernel
+ * NUMA nodes: 2, pages moved
+ * Node 0: 4 threads, 512 vertices from 0, 300 expanded, 2000 edges examined, 40 handed off, 35 received
+ * 
+ * @param NumaBalance (pointer*)
+ * @return void
+ * 
+ */
+static void printNumaBalance(const NumaBalance *balance)
+{
+    if (balance->noOfNodes == 0)
+    {
+        return;
+    }
+
+    printf("NUMA nodes: %u, pages %s\n", balance->noOfNodes, balance->pagesPlaced ? "moved" : "left in place");
+
+    for (unsigned int index = 0; index < balance->noOfNodes; index++)
+    {
+        const NumaNodeWork *node = &balance->nodes[index];
+
+        printf
+        (
+            "Node %u: %u threads, %u vertices from %u, %zu expanded, %zu edges examined, %zu handed off, %zu received\n",
+            node->node, node->noOfThreads, node->lastVertex - node->firstVertex, node->firstVertex,
+            node->verticesExpanded, node->edgesExamined, node->verticesSent, node->verticesReceived
+        );
+    }
+}
+
+/*
+ * @brief Name of a traversal mode
+ * 
+ * @param TraversalMode (mode)
+ * @return char pointer [array]
+ * 
+ */
+const char *getTraversalModeName(TraversalMode mode)
+{
+    switch (mode)
+    {
+        case DIRECTION_OPTIMIZING_TRAVERSAL:
+            return "direction-optimizing";
+        case PARALLEL_TRAVERSAL:
+            return "parallel";
+        case NUMA_TRAVERSAL:
+            return "numa";
+        default:
+            return "top-down";
+    }
+}
+
+/*
+ * @brief Write per level statistics
+ * 
+ * Writes the profile as JSON to the stats file,
+ * or after the normal output for "-"
+ * 
+ * @param Graph (pointer*)
+ * @param TraversalOptions (pointer*)
+ * @param TraversalProfile (pointer*)
+ * @return void
+ * 
+ */
+static void writeTraversalProfile
+(
+    const Graph *graph,
+    const TraversalOptions *options,
+    const TraversalProfile *profile
+)
+{
+    bool toStdout = strcmp(options->statsFileName, "-") == 0;
+    FILE *output = toStdout ? stdout : fopen(options->statsFileName, "w");
+
+    if (output == NULL)
+    {
+        perror("Error in file\n");
+        exit(EXIT_FAILURE);
+    }
+
+    writeProfileJson
+    (
+        profile, output, getTraversalModeName(options->mode), graph->noOfNodes, graph->noOfEdges
+    );
+
+    if (!toStdout)
+    {
+        fclose(output);
+    }
+}
+
 /*
  * @brief Display unreachable nodes
  * 
  * Displays unreachabble nodes in the below format
  * Node Name 1, Node Name 2
  * 
- * @param char pointer [array]
+ * @param VertexDictionary (pointer*)
+ * @param VertexId pointer [array]
  * @param unsigned int (unreachable nodes count)
  * @return void
  * 
  */
-static void printUnReachableNodes(char *unReachableNodes, unsigned int unReachableLength)
+static void printUnReachableNodes
+(
+    const VertexDictionary *dictionary,
+    VertexId *unReachableNodes,
+    unsigned int unReachableLength
+)
 {
     printf("Unreachable Nodes: ");
     for (size_t index = 0; index < unReachableLength; index++)
     {
-        printf("%c", unReachableNodes[index]);
+        printf("%s", getVertexName(dictionary, unReachableNodes[index]));
         if (index + 1 != unReachableLength)
         {
             printf(", ");
@@ -419,29 +820,599 @@ static void printUnReachableNodes(char *unReachableNodes, unsigned int unReachab
  * @return void
  * 
  */
-static void freeTraversalStats(TraversalStats *traversalStats)
+void freeTraversalStats(TraversalStats *traversalStats)
 {
     free(traversalStats->traversalPath);
     free(traversalStats->unReachableNodes);
 }
 
 /*
- * @brief Run and display all data from traversing graph
+ * @brief Run and display a profiled traversal
+ * 
+ * The result is materialized and printed after
+ * the traversal so printing does not show up in
+ * the level timings
  * 
  * @param Graph (pointer*)
+ * @param TraversalOptions (pointer*)
  * @return void
  * 
- * @note Runs the bfs algorithm and formulates data
- * @note Also frees dynamically allocated structures
- * 
  */
-void displayDataFromTraversingGraph(Graph *graph)
+static void displayProfiledTraversal(Graph *graph, const TraversalOptions *options)
 {
-    TraversalStats traversalStats = bfsAlgorithm(graph);
+    TraversalOptions profiledOptions = *options;
+    TraversalProfile profile;
+
+    startProfile(&profile, options->hardwareCounters);
+    profiledOptions.profile = &profile;
 
-    printTraversalPath(traversalStats.traversalPath, traversalStats.traversalLength);
+    TraversalStats traversalStats = bfsAlgorithm(graph, &profiledOptions);
+
+    // names are only looked up here, never during the traversal
+    printTraversalPath
+    (
+        &graph->dictionary, traversalStats.traversalPath, traversalStats.traversalLength
+    );
     printTotalWeight(graph->totalWeight);
-    printUnReachableNodes(traversalStats.unReachableNodes, traversalStats.unReachableLength);
+    printUnReachableNodes
+    (
+        &graph->dictionary, traversalStats.unReachableNodes, traversalStats.unReachableLength
+    );
 
-    freeTraversalStats(&traversalStats);
-}
\ No newline at end of file
+    if (options->verbose)
+    {
+        printEdgesExamined(traversalStats.edgesExamined);
+    }
+
+    writeTraversalProfile(graph, options, &profile);
+    freeProfile(&profile);
+
+    freeTraversalStats(&traversalStats);
+}
+
+/*
+ * @brief Run and display all data from traversing graph
+ * 
+ * @param Graph (pointer*)
+ * @param TraversalOptions (pointer*)
+ * @return void
+ * 
+ * @note The path is printed level by level through a
+ *       visitor and never stored, unless stats are wanted
+ * 
+ */
+void displayDataFromTraversingGraph(Graph *graph, const TraversalOptions *options)
+{
+    if (options->statsFileName != NULL)
+    {
+        displayProfiledTraversal(graph, options);
+        return;
+    }
+
+    PathPrinter printer = { &graph->dictionary, graph->totalWeight, 0, 0, false };
+    BfsVisitor visitor = { printDiscoveredNode, NULL, printUnreachableNode, &printer };
+    TraversalOptions traversalOptions = *options;
+    NumaBalance balance = { 0, false, NULL };
+
+    if (options->verbose && options->mode == NUMA_TRAVERSAL)
+    {
+        traversalOptions.numaBalance = &balance;
+    }
+
+    size_t edgesExamined = visitTraversal(graph, &traversalOptions, &visitor);
+
+    if (!printer.pathFinished)
+    {
+        finishPrintedPath(&printer);
+    }
+
+    if (printer.noOfUnreachableNodes == 0)
+    {
+        printf("None");
+    }
+
+    printf("\n");
+
+    if (options->verbose)
+    {
+        printEdgesExamined(edgesExamined);
+        printNumaBalance(&balance);
+    }
+
+    freeNumaBalance(&balance);
+}
+
+/*
+ * @brief Look up a node named on the command line
+ * 
+ * @param Graph (pointer*)
+ * @param char pointer [array] (name)
+ * @return VertexId
+ * 
+ * @note Exits if the node is not in the graph
+ * 
+ */
+static VertexId findNamedVertex(const Graph *graph, const char *name)
+{
+    VertexId vertex = findVertexId(&graph->dictionary, name, strlen(name));
+
+    if (vertex == INVALID_VERTEX)
+    {
+        fprintf(stderr, "Unknown node: %s\n", name);
+        exit(EXIT_FAILURE);
+    }
+
+    return vertex;
+}
+
+/*
+ * @brief Display the bfs tree
+ * 
+ * Displays the parent and hop distance of every
+ * node in the below format, in node list order
+ * Node Name 1: root
+ * Node Name 2: parent Node Name 1, distance 1
+ * Node Name 3: unreachable
+ * 
+ * @param Graph (pointer*)
+ * @return void
+ * 
+ * @note The tree is the one the top-down traversal walks
+ *       from the first node in the node list
+ * 
+ */
+void displayBfsTree(const Graph *graph)
+{
+    if (graph->noOfNodes == 0)
+    {
+        return;
+    }
+
+    BfsTree tree;
+    computeBfsTree(graph, getListedVertex(graph, 0), &tree);
+
+    for (VertexId position = 0; position < graph->noOfNodes; position++)
+    {
+        VertexId vertex = getListedVertex(graph, position);
+        const char *name = getVertexName(&graph->dictionary, vertex);
+
+        if (vertex == tree.source)
+        {
+            printf("%s: root\n", name);
+        }
+        else if (tree.parents[vertex] == INVALID_VERTEX)
+        {
+            printf("%s: unreachable\n", name);
+        }
+        else
+        {
+            printf
+            (
+                "%s: parent %s, distance %u\n", name,
+                getVertexName(&graph->dictionary, tree.parents[vertex]), tree.distances[vertex]
+            );
+        }
+    }
+
+    freeBfsTree(&tree);
+}
+
+/*
+ * @brief Display the connected components
+ * 
+ * Displays the number of components and their sizes,
+ * numbered by their first node, in the below format
+ * Components: 2
+ * Component Sizes: 4, 1
+ * 
+ * The label file gets one line per node in node list order
+ * Node Name 1 0
+ * 
+ * @param Graph (pointer*)
+ * @param char pointer [array] (label file name, NULL for none)
+ * @param TraversalOptions (pointer*)
+ * @return void
+ * 
+ * @note Directed graphs get their weakly connected components
+ * 
+ */
+void displayConnectedComponents
+(
+    Graph *graph,
+    const char *labelsFileName,
+    const TraversalOptions *options
+)
+{
+    Components components;
+    findConnectedComponents(graph, options->noOfThreads, &components);
+
+    printf("Components: %u\n", components.noOfComponents);
+    printf("Component Sizes: ");
+    for (unsigned int index = 0; index < components.noOfComponents; index++)
+    {
+        printf("%s%u", index == 0 ? "" : ", ", components.sizes[index]);
+    }
+
+    printf("%s\n", components.noOfComponents == 0 ? "None" : "");
+
+    if (options->verbose)
+    {
+        printEdgesExamined(components.edgesExamined);
+    }
+
+    if (labelsFileName != NULL)
+    {
+        FILE *output = fopen(labelsFileName, "w");
+
+        if (output == NULL)
+        {
+            perror("Error in file\n");
+            exit(EXIT_FAILURE);
+        }
+
+        for (VertexId position = 0; position < graph->noOfNodes; position++)
+        {
+            VertexId vertex = getListedVertex(graph, position);
+            fprintf(output, "%s %u\n", getVertexName(&graph->dictionary, vertex), components.labels[vertex]);
+        }
+
+        fclose(output);
+    }
+
+    freeComponents(&components);
+}
+
+/*
+ * @brief Display weighted shortest paths from the first node
+ * 
+ * Displays distances and predecessors of the reached
+ * nodes in node list order, in the below format
+ * Distances: Node Name 1: 0, Node Name 2: 4
+ * Predecessors: Node Name 2: Node Name 1
+ * Unreachable Nodes: Node Name 3
+ * 
+ * @param Graph (pointer*)
+ * @param TraversalOptions (pointer*)
+ * @return void
+ * 
+ * @note One thread runs Dijkstra, more run delta stepping,
+ *       both give the same output
+ * 
+ */
+void displayWeightedShortestPaths(const Graph *graph, const TraversalOptions *options)
+{
+    if (graph->noOfNodes == 0)
+    {
+        return;
+    }
+
+    WeightedPaths paths;
+
+    if (resolveThreadCount(options->noOfThreads) == 1)
+    {
+        dijkstraShortestPaths(graph, getListedVertex(graph, 0), &paths);
+    }
+    else
+    {
+        deltaSteppingShortestPaths(graph, getListedVertex(graph, 0), options->noOfThreads, options->delta, &paths);
+    }
+
+    VertexId *unReachableNodes = (VertexId *)malloc(graph->noOfNodes * sizeof(VertexId));
+
+    if (unReachableNodes == NULL)
+    {
+        perror("Failed to allocate memory\n");
+        exit(EXIT_FAILURE);
+    }
+
+    unsigned int unReachableLength = 0;
+    bool first = true;
+
+    printf("Distances: ");
+    for (VertexId position = 0; position < graph->noOfNodes; position++)
+    {
+        VertexId vertex = getListedVertex(graph, position);
+
+        if (paths.distances[vertex] == INFINITE_DISTANCE)
+        {
+            unReachableNodes[unReachableLength++] = vertex;
+            continue;
+        }
+
+        printf
+        (
+            "%s%s: %llu", first ? "" : ", ", getVertexName(&graph->dictionary, vertex),
+            (unsigned long long)paths.distances[vertex]
+        );
+        first = false;
+    }
+
+    first = true;
+
+    printf("\nPredecessors: ");
+    for (VertexId position = 0; position < graph->noOfNodes; position++)
+    {
+        VertexId vertex = getListedVertex(graph, position);
+
+        if (vertex == paths.source || paths.predecessors[vertex] == INVALID_VERTEX)
+        {
+            continue;
+        }
+
+        printf
+        (
+            "%s%s: %s", first ? "" : ", ", getVertexName(&graph->dictionary, vertex),
+            getVertexName(&graph->dictionary, paths.predecessors[vertex])
+        );
+        first = false;
+    }
+
+    printf("%s\n", first ? "None" : "");
+
+    printUnReachableNodes(&graph->dictionary, unReachableNodes, unReachableLength);
+
+    if (options->verbose)
+    {
+        printEdgesExamined(paths.edgesExamined);
+    }
+
+    free(unReachableNodes);
+    freeWeightedPaths(&paths);
+}
+
+/*
+ * @brief Display the shortest hop path between two nodes
+ * 
+ * Displays the path in the below format
+ * Shortest Path: Node Name 1 -> Node Name 2
+ * Hops: 1
+ * 
+ * @param Graph (pointer*)
+ * @param char pointer [array] (start node name)
+ * @param char pointer [array] (goal node name)
+ * @param TraversalOptions (pointer*)
+ * @return void
+ * 
+ * @note Exits if either node is not in the graph
+ * 
+ */
+void displayShortestPath
+(
+    Graph *graph,
+    const char *startName,
+    const char *goalName,
+    const TraversalOptions *options
+)
+{
+    VertexId start = findNamedVertex(graph, startName);
+    VertexId goal = findNamedVertex(graph, goalName);
+
+    PathSearch search;
+    initPathSearch(&search, graph);
+
+    VertexId *path = allocateTraversalPath(graph->noOfNodes);
+    unsigned int pathLength = findShortestPath(&search, start, goal, path);
+
+    printf("Shortest Path: ");
+    for (unsigned int index = 0; index < pathLength; index++)
+    {
+        printf("%s%s", index == 0 ? "" : " -> ", getVertexName(&graph->dictionary, path[index]));
+    }
+
+    if (pathLength == 0)
+    {
+        printf("None\n");
+    }
+    else
+    {
+        printf("\nHops: %u\n", pathLength - 1);
+    }
+
+    if (options->verbose)
+    {
+        printf("Vertices visited: %zu\n", search.verticesVisited);
+        printEdgesExamined(search.edgesExamined);
+    }
+
+    free(path);
+    freePathSearch(&search);
+}
+
+/*
+ * @brief Run and display all data from a bfs per source
+ * 
+ * Sources are traversed together in groups of one
+ * batch per thread, and each group is printed and
+ * freed before the next one starts
+ * 
+ * @param Graph (pointer*)
+ * @param VertexId pointer [array] (sources)
+ * @param unsigned int (number of sources)
+ * @param TraversalOptions (pointer*)
+ * @return void
+ * 
+ * @note Every block matches what a bfs from that source prints
+ * 
+ */
+void displayDataFromMultiSourceTraversal
+(
+    Graph *graph,
+    const VertexId *sources,
+    unsigned int noOfSources,
+    const TraversalOptions *options
+)
+{
+    unsigned int groupSize = resolveThreadCount(options->noOfThreads) * MULTI_SOURCE_BATCH;
+    TraversalStats *results = (TraversalStats *)malloc(groupSize * sizeof(TraversalStats));
+
+    if (results == NULL)
+    {
+        perror("Failed to allocate memory\n");
+        exit(EXIT_FAILURE);
+    }
+
+    size_t edgesExamined = 0;
+
+    for (unsigned int first = 0; first < noOfSources; first += groupSize)
+    {
+        unsigned int noOfGroupSources = noOfSources - first < groupSize ? noOfSources - first : groupSize;
+
+        edgesExamined += multiSourceTraversal
+        (
+            graph, &sources[first], noOfGroupSources, options->noOfThreads, results
+        );
+
+        for (unsigned int index = 0; index < noOfGroupSources; index++)
+        {
+            printf("Source: %s\n", getVertexName(&graph->dictionary, sources[first + index]));
+            printTraversalPath
+            (
+                &graph->dictionary, results[index].traversalPath, results[index].traversalLength
+            );
+            printTotalWeight(graph->totalWeight);
+            printUnReachableNodes
+            (
+                &graph->dictionary, results[index].unReachableNodes, results[index].unReachableLength
+            );
+
+            freeTraversalStats(&results[index]);
+        }
+    }
+
+    if (options->verbose)
+    {
+        printEdgesExamined(edgesExamined);
+    }
+
+    free(results);
+}
+
+/*
+ * @brief Run and display a semi-external bfs of a snapshot
+ * 
+ * Prints what displayDataFromTraversingGraph
+ * prints for the same snapshot, followed by the
+ * adjacency bytes read for every level
+ * 
+ * @param char pointer [array] (file name) => snapshot written by --save
+ * @param TraversalOptions (pointer*)
+ * @return void
+ * 
+ */
+void displayDataFromExternalTraversal(const char *fileName, const TraversalOptions *options)
+{
+    ExternalGraph graph;
+    openExternalGraph(&graph, fileName);
+
+    PathPrinter printer = { &graph.dictionary, graph.totalWeight, 0, 0, false };
+    BfsVisitor visitor = { printDiscoveredNode, NULL, printUnreachableNode, &printer };
+    ExternalTraversalStats stats;
+
+    runExternalTraversal(&graph, &visitor, &stats);
+
+    if (!printer.pathFinished)
+    {
+        finishPrintedPath(&printer);
+    }
+
+    if (printer.noOfUnreachableNodes == 0)
+    {
+        printf("None");
+    }
+
+    printf("\n");
+
+    if (options->verbose)
+    {
+        printEdgesExamined(stats.edgesExamined);
+    }
+
+    size_t totalBytesRead = graph.offsetBytesRead;
+
+    for (unsigned int level = 0; level < stats.noOfLevels; level++)
+    {
+        printf
+        (
+            "Level %u: %u vertices, %zu bytes read\n",
+            level, stats.levelSizes[level], stats.levelBytesRead[level]
+        );
+        totalBytesRead += stats.levelBytesRead[level];
+    }
+
+    printf("Bytes read: %zu (%zu for the edge offsets)\n", totalBytesRead, graph.offsetBytesRead);
+
+    freeExternalTraversalStats(&stats);
+    closeExternalGraph(&graph);
+}
+
+/*
+ * @brief Run and display a bfs over worker processes
+ * 
+ * Prints what displayDataFromTraversingGraph
+ * prints, with the vertices of each level in
+ * worker order, followed by what the workers
+ * sent each other for every level
+ * 
+ * @param Graph (pointer*)
+ * @param unsigned int (number of processes)
+ * @param TraversalOptions (pointer*)
+ * @return void
+ * 
+ */
+void displayDataFromDistributedTraversal
+(
+    const Graph *graph,
+    unsigned int noOfProcesses,
+    const TraversalOptions *options
+)
+{
+    PathPrinter printer = { &graph->dictionary, graph->totalWeight, 0, 0, false };
+    BfsVisitor visitor = { printDiscoveredNode, NULL, printUnreachableNode, &printer };
+    DistributedTraversalStats stats;
+
+    runDistributedTraversal(graph, noOfProcesses, &visitor, &stats);
+
+    if (!printer.pathFinished)
+    {
+        finishPrintedPath(&printer);
+    }
+
+    if (printer.noOfUnreachableNodes == 0)
+    {
+        printf("None");
+    }
+
+    printf("\n");
+
+    if (options->verbose)
+    {
+        printEdgesExamined(stats.edgesExamined);
+    }
+
+    LevelTraffic total = { 0, 0, 0, 0, 0 };
+
+    for (unsigned int level = 0; level < stats.noOfLevels; level++)
+    {
+        const LevelTraffic *traffic = &stats.levels[level];
+
+        printf
+        (
+            "Level %u: %u vertices, %zu sent in %zu batches, %zu bytes, %zu duplicates dropped\n",
+            level, traffic->levelSize, traffic->verticesSent, traffic->batches,
+            traffic->bytesSent, traffic->duplicatesDropped
+        );
+        total.verticesSent += traffic->verticesSent;
+        total.batches += traffic->batches;
+        total.bytesSent += traffic->bytesSent;
+        total.duplicatesDropped += traffic->duplicatesDropped;
+    }
+
+    printf
+    (
+        "Processes: %u, %zu sent in %zu batches, %zu bytes (%zu more to the coordinator), %zu duplicates dropped\n",
+        stats.noOfProcesses, total.verticesSent, total.batches, total.bytesSent,
+        stats.reportBytes, total.duplicatesDropped
+    );
+
+    freeDistributedTraversalStats(&stats);
+}
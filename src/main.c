@@ -1,14 +1,110 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include "types.h"
+#include "compressedGraph.h"
 #include "decipherFile.h"
+#include "graphSnapshot.h"
 #include "logic.h"
+#include "options.h"
+#include "queryServer.h"
+#include "reorder.h"
+#include "simplifyGraph.h"
 
-int main()
+int main(int argc, char *argv[])
 {
-    Graph *graph = createGraphFromFile();
+    Options options;
+    parseOptions(argc, argv, &options);
 
-    displayDataFromTraversingGraph(graph);
+    // the adjacency of an external graph never enters memory
+    if (options.external)
+    {
+        displayDataFromExternalTraversal(options.fileName, &options.traversal);
+        return 0;
+    }
+
+    Graph *graph = createGraphFromFile(options.fileName, options.traversal.noOfThreads, NULL);
+    reorderGraph(graph, options.reorder);
+
+    // relabelling leaves rows unsorted, so simplify afterwards
+    bool simplify = options.multiEdgePolicy != KEEP_MULTI_EDGES || options.dropSelfLoops;
+    SimplifyStats simplifyStats;
+
+    if (simplify)
+    {
+        simplifyGraph(graph, options.multiEdgePolicy, options.dropSelfLoops, &simplifyStats);
+    }
+
+    size_t plainBytes = getAdjacencyBytes(graph);
+
+    if (options.compress)
+    {
+        compressGraph(graph);
+    }
+
+    if (options.snapshotFileName != NULL)
+    {
+        saveGraphSnapshot(graph, options.snapshotFileName);
+        printf("Graph snapshot saved to %s\n", options.snapshotFileName);
+    }
+    else if (options.socketPath != NULL)
+    {
+        serveUnixSocket(graph, options.socketPath);
+    }
+    else if (options.serve)
+    {
+        serveQueries(graph, stdin, stdout);
+    }
+    else if (options.pathStart != NULL)
+    {
+        displayShortestPath(graph, options.pathStart, options.pathGoal, &options.traversal);
+    }
+    else if (options.components)
+    {
+        displayConnectedComponents(graph, options.labelsFileName, &options.traversal);
+    }
+    else if (options.weighted)
+    {
+        displayWeightedShortestPaths(graph, &options.traversal);
+    }
+    else if (options.tree)
+    {
+        displayBfsTree(graph);
+    }
+    else if (options.sourcesFileName != NULL)
+    {
+        unsigned int noOfSources;
+        VertexId *sources = readSourceList(graph, options.sourcesFileName, &noOfSources);
+
+        displayDataFromMultiSourceTraversal(graph, sources, noOfSources, &options.traversal);
+
+        free(sources);
+    }
+    else if (options.noOfProcesses > 0)
+    {
+        displayDataFromDistributedTraversal(graph, options.noOfProcesses, &options.traversal);
+    }
+    else
+    {
+        displayDataFromTraversingGraph(graph, &options.traversal);
+    }
+
+    if (simplify)
+    {
+        printf
+        (
+            "Edges removed: %zu duplicates, %zu self-loops\n",
+            simplifyStats.duplicatesRemoved, simplifyStats.selfLoopsRemoved
+        );
+    }
+
+    if (options.compress && graph->noOfEdges > 0)
+    {
+        printf
+        (
+            "Adjacency bytes per edge: %.2f (%.2f uncompressed)\n",
+            (double)getAdjacencyBytes(graph) / graph->noOfEdges, (double)plainBytes / graph->noOfEdges
+        );
+    }
     
     freeGraph(graph);
     
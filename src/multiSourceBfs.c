@@ -0,0 +1,682 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <pthread.h>
+#include "multiSourceBfs.h"
+#include "graphBuilder.h"
+#include "parallelBfs.h"
+#include "workerThreads.h"
+#include "reorder.h"
+#include "types.h"
+#include "logic.h"
+
+/*
+ * @brief Unset discovery key
+ *
+ * Marks a source whose discovering edge
+ * has not been found yet
+ *
+ */
+#define UNSET_KEY UINT64_MAX
+
+/*
+ * @brief Level entry data structure
+ *
+ * LevelEntry struct holds a vertex reached by one
+ * source in the current level, keyed by the edge the
+ * top-down bfs from that source would discover it through
+ *
+ * @member uint64_t (key) => parent rank in the high half, row position in the low half
+ * @member VertexId (vertex) => vertex reached
+ *
+ */
+typedef struct LevelEntry {
+    uint64_t key;
+    VertexId vertex;
+} LevelEntry;
+
+/*
+ * @brief Batch scratch data structure
+ *
+ * BatchScratch struct holds everything one thread
+ * needs to run a batch. Bit i of a mask word belongs
+ * to source i of the batch
+ *
+ * @member uint64_t pointer [array] (seen) => sources that reached each vertex
+ * @member uint64_t pointer [array] (visit) => sources with each vertex in their frontier
+ * @member uint64_t pointer [array] (next) => sources reaching each vertex this level
+ * @member VertexId pointer [array] (ranks) => path index of a vertex, MULTI_SOURCE_BATCH per vertex
+ * @member VertexId pointer [array] (frontier) => vertices with any visit bit set
+ * @member size_t (frontier length) => number of vertices in the frontier
+ * @member VertexId pointer [array] (candidates) => vertices with any next bit set
+ * @member size_t (candidates length) => number of candidates
+ * @member LevelEntry pointer [array] (entries) => level entries grouped by source
+ * @member size_t (entries capacity) => entries that fit before growing
+ * @member size_t (edges examined) => edges scanned by the thread
+ *
+ */
+typedef struct BatchScratch {
+    uint64_t *seen;
+    uint64_t *visit;
+    uint64_t *next;
+    VertexId *ranks;
+    VertexId *frontier;
+    size_t frontierLength;
+    VertexId *candidates;
+    size_t candidatesLength;
+    LevelEntry *entries;
+    size_t entriesCapacity;
+    size_t edgesExamined;
+} BatchScratch;
+
+/*
+ * @brief Multi source state data structure
+ *
+ * MultiSourceState struct is shared by every thread.
+ * Threads claim whole batches from it
+ *
+ * @member Graph (pointer*) => graph being traversed
+ * @member VertexId pointer [array] (sources) => source of every traversal
+ * @member unsigned int (number of sources) => number of traversals
+ * @member TraversalStats pointer [array] (results) => one per source
+ * @member unsigned int (number of batches) => batches of MULTI_SOURCE_BATCH sources
+ * @member unsigned int (next batch) => next batch to hand out
+ *
+ */
+typedef struct MultiSourceState {
+    const Graph *graph;
+    const VertexId *sources;
+    unsigned int noOfSources;
+    TraversalStats *results;
+    unsigned int noOfBatches;
+    unsigned int nextBatch;
+} MultiSourceState;
+
+/*
+ * @brief Multi source worker data structure
+ *
+ * @member MultiSourceState (pointer*) => shared state
+ * @member BatchScratch (scratch) => private to the thread
+ *
+ */
+typedef struct MultiSourceWorker {
+    MultiSourceState *state;
+    BatchScratch scratch;
+} MultiSourceWorker;
+
+/*
+ * @brief declarations for internal functions
+ *
+ * List of static functions local to this file
+ * Meant to be used in this file only
+ *
+ * @note all internal functions are static
+ */
+static void initBatchScratch(BatchScratch *scratch, unsigned int noOfNodes);
+static void freeBatchScratch(BatchScratch *scratch);
+static void startBatch
+(
+    MultiSourceState *state,
+    BatchScratch *scratch,
+    unsigned int firstSource,
+    unsigned int batchSize
+);
+static void expandFrontier(const Graph *graph, BatchScratch *scratch);
+static int compareLevelEntries(const void *first, const void *second);
+static void orderNextLevel
+(
+    MultiSourceState *state,
+    BatchScratch *scratch,
+    unsigned int firstSource,
+    unsigned int batchSize
+);
+static void advanceLevel(BatchScratch *scratch);
+static void collectUnreachable
+(
+    MultiSourceState *state,
+    BatchScratch *scratch,
+    unsigned int firstSource,
+    unsigned int batchSize
+);
+static void traverseBatch(MultiSourceState *state, BatchScratch *scratch, unsigned int batch);
+static void *multiSourceWorker(void *argument);
+
+/*
+ * @brief Initialize batch scratch
+ *
+ * @param BatchScratch (pointer*)
+ * @param unsigned int (number of nodes)
+ * @return void
+ *
+ */
+static void initBatchScratch(BatchScratch *scratch, unsigned int noOfNodes)
+{
+    scratch->seen = (uint64_t *)calloc(noOfNodes + 1, sizeof(uint64_t));
+    scratch->visit = (uint64_t *)calloc(noOfNodes + 1, sizeof(uint64_t));
+    scratch->next = (uint64_t *)calloc(noOfNodes + 1, sizeof(uint64_t));
+    scratch->ranks = (VertexId *)malloc
+    (
+        ((size_t)noOfNodes + 1) * MULTI_SOURCE_BATCH * sizeof(VertexId)
+    );
+    scratch->frontier = (VertexId *)malloc((noOfNodes + 1) * sizeof(VertexId));
+    scratch->candidates = (VertexId *)malloc((noOfNodes + 1) * sizeof(VertexId));
+
+    if
+    (
+        scratch->seen == NULL || scratch->visit == NULL || scratch->next == NULL ||
+        scratch->ranks == NULL || scratch->frontier == NULL || scratch->candidates == NULL
+    )
+    {
+        perror("Failed to allocate memory\n");
+        exit(EXIT_FAILURE);
+    }
+
+    scratch->frontierLength = 0;
+    scratch->candidatesLength = 0;
+    scratch->entries = NULL;
+    scratch->entriesCapacity = 0;
+    scratch->edgesExamined = 0;
+}
+
+/*
+ * @brief Free batch scratch
+ *
+ * @param BatchScratch (pointer*)
+ * @return void
+ *
+ */
+static void freeBatchScratch(BatchScratch *scratch)
+{
+    free(scratch->seen);
+    free(scratch->visit);
+    free(scratch->next);
+    free(scratch->ranks);
+    free(scratch->frontier);
+    free(scratch->candidates);
+    free(scratch->entries);
+}
+
+/*
+ * @brief Start the traversals of a batch
+ *
+ * Gives every source of the batch its own
+ * path and its own bit in the mask words
+ *
+ * @param MultiSourceState (pointer*)
+ * @param BatchScratch (pointer*)
+ * @param unsigned int (index of the first source)
+ * @param unsigned int (batch size)
+ * @return void
+ *
+ * @note A source listed twice simply gets two bits
+ *
+ */
+static void startBatch
+(
+    MultiSourceState *state,
+    BatchScratch *scratch,
+    unsigned int firstSource,
+    unsigned int batchSize
+)
+{
+    for (unsigned int index = 0; index < batchSize; index++)
+    {
+        VertexId source = state->sources[firstSource + index];
+        TraversalStats *result = &state->results[firstSource + index];
+        uint64_t bit = (uint64_t)1 << index;
+
+        result->traversalPath = (VertexId *)malloc
+        (
+            (state->graph->noOfNodes + 1) * sizeof(VertexId)
+        );
+
+        if (result->traversalPath == NULL)
+        {
+            perror("Failed to allocate memory\n");
+            exit(EXIT_FAILURE);
+        }
+
+        result->traversalPath[0] = source;
+        result->traversalLength = 1;
+
+        if (scratch->visit[source] == 0)
+        {
+            scratch->frontier[scratch->frontierLength++] = source;
+        }
+
+        scratch->visit[source] |= bit;
+        scratch->seen[source] |= bit;
+        scratch->ranks[(size_t)source * MULTI_SOURCE_BATCH + index] = 0;
+    }
+}
+
+/*
+ * @brief Expand the frontier of every source at once
+ *
+ * Scans each frontier vertex's row a single time and
+ * hands its visit mask to every neighbour, dropping the
+ * sources that already reached the neighbour
+ *
+ * @param Graph (pointer*)
+ * @param BatchScratch (pointer*)
+ * @return void
+ *
+ */
+static void expandFrontier(const Graph *graph, BatchScratch *scratch)
+{
+    for (size_t index = 0; index < scratch->frontierLength; index++)
+    {
+        VertexId vertex = scratch->frontier[index];
+        uint64_t visitMask = scratch->visit[vertex];
+        size_t rowEnd = graph->edgeOffsets[vertex + 1];
+
+        scratch->edgesExamined += rowEnd - graph->edgeOffsets[vertex];
+
+        for (size_t edge = graph->edgeOffsets[vertex]; edge < rowEnd; edge++)
+        {
+            VertexId adjacentNode = graph->adjacentNodes[edge];
+            uint64_t newBits = visitMask & ~scratch->seen[adjacentNode];
+
+            if (newBits == 0)
+            {
+                continue;
+            }
+
+            if (scratch->next[adjacentNode] == 0)
+            {
+                scratch->candidates[scratch->candidatesLength++] = adjacentNode;
+            }
+
+            scratch->next[adjacentNode] |= newBits;
+        }
+    }
+}
+
+/*
+ * @brief Compare level entries by key
+ *
+ * @param void pointer (first LevelEntry)
+ * @param void pointer (second LevelEntry)
+ * @return int
+ *
+ */
+static int compareLevelEntries(const void *first, const void *second)
+{
+    uint64_t firstKey = ((const LevelEntry *)first)->key;
+    uint64_t secondKey = ((const LevelEntry *)second)->key;
+
+    return (firstKey > secondKey) - (firstKey < secondKey);
+}
+
+/*
+ * @brief Append the next level to every path
+ *
+ * The top-down bfs from a source adds a vertex through
+ * the earliest parent in its path, and within that parent
+ * through the earliest row position. One scan of a
+ * candidate's incoming row finds that edge for every
+ * source reaching it, then each source sorts its share
+ *
+ * @param MultiSourceState (pointer*)
+ * @param BatchScratch (pointer*)
+ * @param unsigned int (index of the first source)
+ * @param unsigned int (batch size)
+ * @return void
+ *
+ */
+static void orderNextLevel
+(
+    MultiSourceState *state,
+    BatchScratch *scratch,
+    unsigned int firstSource,
+    unsigned int batchSize
+)
+{
+    const Graph *graph = state->graph;
+    size_t counts[MULTI_SOURCE_BATCH] = { 0 };
+    size_t starts[MULTI_SOURCE_BATCH];
+    size_t noOfEntries = 0;
+
+    for (size_t index = 0; index < scratch->candidatesLength; index++)
+    {
+        uint64_t bits = scratch->next[scratch->candidates[index]];
+
+        while (bits != 0)
+        {
+            counts[__builtin_ctzll(bits)]++;
+            bits &= bits - 1;
+        }
+    }
+
+    for (unsigned int source = 0; source < batchSize; source++)
+    {
+        starts[source] = noOfEntries;
+        noOfEntries += counts[source];
+    }
+
+    if (noOfEntries > scratch->entriesCapacity)
+    {
+        LevelEntry *newEntries = (LevelEntry *)realloc
+        (
+            scratch->entries, noOfEntries * sizeof(LevelEntry)
+        );
+
+        if (newEntries == NULL)
+        {
+            perror("Failed to allocate memory\n");
+            exit(EXIT_FAILURE);
+        }
+
+        scratch->entries = newEntries;
+        scratch->entriesCapacity = noOfEntries;
+    }
+
+    size_t fill[MULTI_SOURCE_BATCH];
+    for (unsigned int source = 0; source < batchSize; source++)
+    {
+        fill[source] = starts[source];
+    }
+
+    for (size_t index = 0; index < scratch->candidatesLength; index++)
+    {
+        VertexId vertex = scratch->candidates[index];
+        uint64_t reachedBits = scratch->next[vertex];
+        uint64_t keys[MULTI_SOURCE_BATCH];
+
+        for (uint64_t bits = reachedBits; bits != 0; bits &= bits - 1)
+        {
+            keys[__builtin_ctzll(bits)] = UNSET_KEY;
+        }
+
+        size_t rowEnd = graph->incomingOffsets[vertex + 1];
+
+        scratch->edgesExamined += rowEnd - graph->incomingOffsets[vertex];
+
+        for (size_t edge = graph->incomingOffsets[vertex]; edge < rowEnd; edge++)
+        {
+            VertexId parent = graph->incomingNodes[edge];
+            const VertexId *parentRanks = &scratch->ranks[(size_t)parent * MULTI_SOURCE_BATCH];
+
+            for (uint64_t bits = scratch->visit[parent] & reachedBits; bits != 0; bits &= bits - 1)
+            {
+                unsigned int source = (unsigned int)__builtin_ctzll(bits);
+                uint64_t key = ((uint64_t)parentRanks[source] << 32) | graph->incomingPositions[edge];
+
+                if (key < keys[source])
+                {
+                    keys[source] = key;
+                }
+            }
+        }
+
+        for (uint64_t bits = reachedBits; bits != 0; bits &= bits - 1)
+        {
+            unsigned int source = (unsigned int)__builtin_ctzll(bits);
+            LevelEntry *entry = &scratch->entries[fill[source]++];
+
+            entry->key = keys[source];
+            entry->vertex = vertex;
+        }
+    }
+
+    for (unsigned int source = 0; source < batchSize; source++)
+    {
+        TraversalStats *result = &state->results[firstSource + source];
+
+        qsort(&scratch->entries[starts[source]], counts[source], sizeof(LevelEntry), compareLevelEntries);
+
+        for (size_t index = starts[source]; index < starts[source] + counts[source]; index++)
+        {
+            VertexId vertex = scratch->entries[index].vertex;
+
+            scratch->ranks[(size_t)vertex * MULTI_SOURCE_BATCH + source] = result->traversalLength;
+            result->traversalPath[result->traversalLength++] = vertex;
+        }
+    }
+}
+
+/*
+ * @brief Advance every traversal by one level
+ *
+ * @param BatchScratch (pointer*)
+ * @return void
+ *
+ */
+static void advanceLevel(BatchScratch *scratch)
+{
+    for (size_t index = 0; index < scratch->frontierLength; index++)
+    {
+        scratch->visit[scratch->frontier[index]] = 0;
+    }
+
+    for (size_t index = 0; index < scratch->candidatesLength; index++)
+    {
+        VertexId vertex = scratch->candidates[index];
+
+        scratch->seen[vertex] |= scratch->next[vertex];
+        scratch->visit[vertex] = scratch->next[vertex];
+        scratch->next[vertex] = 0;
+    }
+
+    VertexId *frontier = scratch->frontier;
+    scratch->frontier = scratch->candidates;
+    scratch->frontierLength = scratch->candidatesLength;
+    scratch->candidates = frontier;
+    scratch->candidatesLength = 0;
+}
+
+/*
+ * @brief Collect unreachable nodes of a batch
+ *
+ * Lists the vertices every source missed in
+ * node list order and clears the seen masks
+ * for the next batch
+ *
+ * @param MultiSourceState (pointer*)
+ * @param BatchScratch (pointer*)
+ * @param unsigned int (index of the first source)
+ * @param unsigned int (batch size)
+ * @return void
+ *
+ */
+static void collectUnreachable
+(
+    MultiSourceState *state,
+    BatchScratch *scratch,
+    unsigned int firstSource,
+    unsigned int batchSize
+)
+{
+    unsigned int noOfNodes = state->graph->noOfNodes;
+    uint64_t batchMask = batchSize == MULTI_SOURCE_BATCH ? UINT64_MAX : ((uint64_t)1 << batchSize) - 1;
+
+    for (unsigned int source = 0; source < batchSize; source++)
+    {
+        TraversalStats *result = &state->results[firstSource + source];
+        size_t unReachableLength = noOfNodes - result->traversalLength;
+
+        if (unReachableLength == 0)
+        {
+            continue;
+        }
+
+        result->unReachableNodes = (VertexId *)malloc(unReachableLength * sizeof(VertexId));
+
+        if (result->unReachableNodes == NULL)
+        {
+            perror("Failed to allocate memory\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    for (VertexId position = 0; position < noOfNodes; position++)
+    {
+        VertexId vertex = getListedVertex(state->graph, position);
+
+        for (uint64_t bits = batchMask & ~scratch->seen[vertex]; bits != 0; bits &= bits - 1)
+        {
+            TraversalStats *result = &state->results[firstSource + __builtin_ctzll(bits)];
+
+            result->unReachableNodes[result->unReachableLength++] = vertex;
+        }
+
+        scratch->seen[vertex] = 0;
+    }
+}
+
+/*
+ * @brief Traverse one batch of sources
+ *
+ * @param MultiSourceState (pointer*)
+ * @param BatchScratch (pointer*)
+ * @param unsigned int (batch index)
+ * @return void
+ *
+ */
+static void traverseBatch(MultiSourceState *state, BatchScratch *scratch, unsigned int batch)
+{
+    unsigned int firstSource = batch * MULTI_SOURCE_BATCH;
+    unsigned int batchSize = state->noOfSources - firstSource;
+
+    if (batchSize > MULTI_SOURCE_BATCH)
+    {
+        batchSize = MULTI_SOURCE_BATCH;
+    }
+
+    startBatch(state, scratch, firstSource, batchSize);
+
+    while (scratch->frontierLength > 0)
+    {
+        expandFrontier(state->graph, scratch);
+        orderNextLevel(state, scratch, firstSource, batchSize);
+        advanceLevel(scratch);
+    }
+
+    collectUnreachable(state, scratch, firstSource, batchSize);
+}
+
+/*
+ * @brief Multi source bfs thread
+ *
+ * Claims batches until none are left
+ *
+ * @param void pointer (MultiSourceWorker)
+ * @return void pointer (NULL)
+ *
+ */
+static void *multiSourceWorker(void *argument)
+{
+    MultiSourceWorker *worker = (MultiSourceWorker *)argument;
+    MultiSourceState *state = worker->state;
+
+    while (true)
+    {
+        unsigned int batch = __atomic_fetch_add(&state->nextBatch, 1, __ATOMIC_RELAXED);
+
+        if (batch >= state->noOfBatches)
+        {
+            break;
+        }
+
+        traverseBatch(state, &worker->scratch, batch);
+    }
+
+    return NULL;
+}
+
+/*
+ * @brief Multi source bfs
+ *
+ * Runs one bfs per source, MULTI_SOURCE_BATCH sources
+ * at a time, so every batch shares a single scan of
+ * each adjacency row per level. Batches are spread
+ * over the threads. Every result holds the same path
+ * and unreachable nodes the top-down bfs would give
+ *
+ * @param Graph (pointer*)
+ * @param VertexId pointer [array] (sources)
+ * @param unsigned int (number of sources)
+ * @param unsigned int (number of threads, 0 for every online core)
+ * @param TraversalStats pointer [array] (results, one per source)
+ * @return size_t (edges examined by all batches)
+ *
+ * @note Builds the incoming arrays of the graph if missing
+ * @note Each thread keeps MULTI_SOURCE_BATCH path indexes per vertex
+ *
+ */
+size_t multiSourceTraversal
+(
+    Graph *graph,
+    const VertexId *sources,
+    unsigned int noOfSources,
+    unsigned int noOfThreads,
+    TraversalStats *results
+)
+{
+    for (unsigned int source = 0; source < noOfSources; source++)
+    {
+        results[source].traversalPath = NULL;
+        results[source].traversalLength = 0;
+        results[source].unReachableNodes = NULL;
+        results[source].unReachableLength = 0;
+        results[source].edgesExamined = 0;
+    }
+
+    if (noOfSources == 0)
+    {
+        return 0;
+    }
+
+    buildIncomingArrays(graph);
+
+    MultiSourceState state;
+    state.graph = graph;
+    state.sources = sources;
+    state.noOfSources = noOfSources;
+    state.results = results;
+    state.noOfBatches = (noOfSources + MULTI_SOURCE_BATCH - 1) / MULTI_SOURCE_BATCH;
+    state.nextBatch = 0;
+
+    noOfThreads = resolveThreadCount(noOfThreads);
+
+    if (noOfThreads > state.noOfBatches)
+    {
+        noOfThreads = state.noOfBatches;
+    }
+
+    MultiSourceWorker *workers = (MultiSourceWorker *)malloc(noOfThreads * sizeof(MultiSourceWorker));
+    pthread_t *threads = (pthread_t *)malloc(noOfThreads * sizeof(pthread_t));
+
+    if (workers == NULL || threads == NULL)
+    {
+        perror("Failed to allocate memory\n");
+        exit(EXIT_FAILURE);
+    }
+
+    // the calling thread works as thread 0
+    for (unsigned int thread = 0; thread < noOfThreads; thread++)
+    {
+        workers[thread].state = &state;
+        initBatchScratch(&workers[thread].scratch, graph->noOfNodes);
+    }
+
+    // batches are claimed independently, so the workers need no launch gate
+    WorkerLaunch launch;
+    startWorkers(&launch, threads, noOfThreads, multiSourceWorker, workers, sizeof(MultiSourceWorker));
+    multiSourceWorker(&workers[0]);
+    joinWorkers(&launch, threads, noOfThreads);
+
+    size_t edgesExamined = 0;
+
+    for (unsigned int thread = 0; thread < noOfThreads; thread++)
+    {
+        edgesExamined += workers[thread].scratch.edgesExamined;
+        freeBatchScratch(&workers[thread].scratch);
+    }
+
+    free(workers);
+    free(threads);
+
+    return edgesExamined;
+}
@@ -0,0 +1,937 @@
+// cpu_set_t and thread affinity are GNU extensions
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/mempolicy.h>
+#include "numaBfs.h"
+#include "bitmap.h"
+#include "graphBuilder.h"
+#include "types.h"
+#include "logic.h"
+#include "parallelBfs.h"
+#include "workerThreads.h"
+#include "reorder.h"
+#include "traversalProfile.h"
+#include "bfsVisitor.h"
+
+/*
+ * @brief Highest numa node id looked for
+ */
+#define MAX_NUMA_NODES 64
+
+/*
+ * @brief Frontier indexes handed to a thread at a time
+ */
+#define FRONTIER_CHUNK 64
+
+/*
+ * @brief Vertex buffer data structure
+ *
+ * @member VertexId pointer [array] (vertices)
+ * @member size_t (length) => vertices in the buffer
+ * @member size_t (capacity) => vertices that fit before growing
+ *
+ */
+typedef struct VertexBuffer {
+    VertexId *vertices;
+    size_t length;
+    size_t capacity;
+} VertexBuffer;
+
+/*
+ * @brief Numa partition data structure
+ *
+ * NumaPartition struct is one numa node taking
+ * part in a traversal. It owns a range of vertex
+ * ids, holding about its share of the edges, and
+ * only its own workers expand or claim them
+ *
+ * @member unsigned int (node) => operating system id of the node
+ * @member cpu_set_t (cpus) => cpus of the node the workers are pinned to
+ * @member unsigned int (first worker) => index of the node's first worker
+ * @member unsigned int (number of workers)
+ * @member VertexId (first vertex) => first vertex owned
+ * @member VertexId (last vertex) => one past the last vertex owned
+ * @member unsigned int (frontier start) => start of the node's part of the level in the path
+ * @member unsigned int (frontier end) => end of the node's part of the level in the path
+ * @member unsigned int (next chunk) => next frontier offset to hand out
+ * @member unsigned int (next batch) => next worker whose hand off to receive
+ *
+ */
+typedef struct NumaPartition {
+    unsigned int node;
+    cpu_set_t cpus;
+    unsigned int firstWorker;
+    unsigned int noOfWorkers;
+    VertexId firstVertex;
+    VertexId lastVertex;
+    unsigned int frontierStart;
+    unsigned int frontierEnd;
+    unsigned int nextChunk;
+    unsigned int nextBatch;
+} NumaPartition;
+
+/*
+ * @brief Numa worker data structure
+ *
+ * NumaWorker struct is the private state of one
+ * thread. Neighbours owned by other nodes are
+ * collected per node and handed off once the
+ * level is expanded, instead of touching the
+ * other node's memory edge by edge
+ *
+ * @member unsigned int (partition index) => node the worker is pinned to
+ * @member VertexBuffer (next) => vertices the worker claimed for the next level
+ * @member VertexBuffer pointer [array] (hand offs) => neighbours to hand each node
+ * @member unsigned int (path offset) => where next is copied in the path
+ * @member size_t (vertices expanded)
+ * @member size_t (edges examined)
+ * @member size_t (vertices sent)
+ * @member size_t (vertices received)
+ *
+ */
+typedef struct NumaWorker {
+    unsigned int partitionIndex;
+    VertexBuffer next;
+    VertexBuffer *handOffs;
+    unsigned int pathOffset;
+    size_t verticesExpanded;
+    size_t edgesExamined;
+    size_t verticesSent;
+    size_t verticesReceived;
+} NumaWorker;
+
+/*
+ * @brief Numa traversal state data structure
+ *
+ * NumaState struct is shared by every worker.
+ * Each level is laid out in the path node by node,
+ * so every node finds its frontier in one slice
+ *
+ * @member Graph (pointer*) => graph being traversed
+ * @member Bitmap (pointer*) => visited, claimed with an atomic or on its word
+ * @member VertexId pointer [array] (traversal path) => path, doubling as the queue
+ * @member NumaPartition pointer [array] (partitions) => one per node
+ * @member unsigned int (number of partitions)
+ * @member NumaWorker pointer [array] (workers) => one per thread
+ * @member unsigned int (number of workers)
+ * @member unsigned int (level start) => start of the level in the path
+ * @member unsigned int (level end) => end of the level in the path
+ * @member bool (finished) => set once a level discovers nothing
+ * @member TraversalProfile (pointer*) => receives per level statistics, may be NULL
+ * @member BfsVisitor (pointer*) => receives each finished level, may be NULL
+ * @member unsigned int (level) => distance of the current level from the source
+ * @member pthread_barrier_t (barrier) => separates the phases of a level
+ * @member WorkerLaunch (launch) => holds the workers until all are created
+ *
+ */
+typedef struct NumaState {
+    const Graph *graph;
+    Bitmap *visited;
+    VertexId *traversalPath;
+    NumaPartition *partitions;
+    unsigned int noOfPartitions;
+    NumaWorker *workers;
+    unsigned int noOfWorkers;
+    unsigned int levelStart;
+    unsigned int levelEnd;
+    bool finished;
+    TraversalProfile *profile;
+    const BfsVisitor *visitor;
+    unsigned int level;
+    pthread_barrier_t barrier;
+    WorkerLaunch launch;
+} NumaState;
+
+/*
+ * @brief Worker argument data structure
+ *
+ * @member NumaState (pointer*) => shared state
+ * @member unsigned int (worker index)
+ *
+ */
+typedef struct WorkerArgument {
+    NumaState *state;
+    unsigned int workerIndex;
+} WorkerArgument;
+
+/*
+ * @brief declarations for internal functions
+ *
+ * List of static functions local to this file
+ * Meant to be used in this file only
+ *
+ * @note all internal functions are static
+ */
+static void parseCpuList(const char *text, cpu_set_t *cpus);
+static unsigned int readTopology(NumaPartition *partitions);
+static unsigned int assignWorkers(NumaPartition *partitions, unsigned int noOfPartitions, unsigned int noOfWorkers);
+static void partitionVertices(const Graph *graph, NumaPartition *partitions, unsigned int noOfPartitions);
+static bool placeRange(const void *start, size_t length, unsigned int node);
+static bool placePartitions(const NumaState *state);
+static void pushVertex(VertexBuffer *buffer, VertexId vertex);
+static unsigned int findOwner(const NumaState *state, unsigned int partitionIndex, VertexId vertex);
+static void expandPartition(NumaState *state, NumaWorker *worker);
+static void receiveHandOffs(NumaState *state, NumaWorker *worker);
+static void layoutLevel(NumaState *state);
+static void copyNext(NumaState *state, NumaWorker *worker);
+#ifdef BFS_INSTRUMENTATION
+static size_t sumEdgesExamined(const NumaState *state);
+#endif
+static void *numaWorker(void *argument);
+static void reportBalance(const NumaState *state, bool pagesPlaced, NumaBalance *balance);
+
+/*
+ * @brief Parse a sysfs cpu list
+ *
+ * Lists look like 0-3,8-11
+ *
+ * @param char pointer [array] (text)
+ * @param cpu_set_t (pointer*) => receives the cpus
+ * @return void
+ *
+ */
+static void parseCpuList(const char *text, cpu_set_t *cpus)
+{
+    CPU_ZERO(cpus);
+
+    while (*text >= '0' && *text <= '9')
+    {
+        char *end;
+        unsigned long first = strtoul(text, &end, 10);
+        unsigned long last = first;
+
+        if (*end == '-')
+        {
+            last = strtoul(end + 1, &end, 10);
+        }
+
+        for (unsigned long cpu = first; cpu <= last && cpu < CPU_SETSIZE; cpu++)
+        {
+            CPU_SET(cpu, cpus);
+        }
+
+        text = *end == ',' ? end + 1 : end;
+    }
+}
+
+/*
+ * @brief Find the numa nodes the process may run on
+ *
+ * Reads the cpus of every node from sysfs and
+ * keeps the nodes that share cpus with the affinity
+ * mask. Without sysfs, or without any match, the
+ * whole mask counts as node 0
+ *
+ * @param NumaPartition pointer [array] (partitions) => room for MAX_NUMA_NODES
+ * @return unsigned int (number of nodes found)
+ *
+ */
+static unsigned int readTopology(NumaPartition *partitions)
+{
+    cpu_set_t allowed;
+
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0)
+    {
+        CPU_ZERO(&allowed);
+
+        for (long cpu = 0; cpu < sysconf(_SC_NPROCESSORS_ONLN) && cpu < CPU_SETSIZE; cpu++)
+        {
+            CPU_SET(cpu, &allowed);
+        }
+    }
+
+    unsigned int noOfPartitions = 0;
+
+    for (unsigned int node = 0; node < MAX_NUMA_NODES; node++)
+    {
+        char fileName[64];
+        char text[4096];
+
+        snprintf(fileName, sizeof(fileName), "/sys/devices/system/node/node%u/cpulist", node);
+        FILE *file = fopen(fileName, "r");
+
+        if (file == NULL)
+        {
+            continue;
+        }
+
+        bool listed = fgets(text, sizeof(text), file) != NULL;
+        fclose(file);
+
+        cpu_set_t cpus;
+        parseCpuList(listed ? text : "", &cpus);
+        CPU_AND(&cpus, &cpus, &allowed);
+
+        // memory only nodes and nodes outside the mask get no workers
+        if (CPU_COUNT(&cpus) > 0)
+        {
+            partitions[noOfPartitions].node = node;
+            partitions[noOfPartitions].cpus = cpus;
+            noOfPartitions++;
+        }
+    }
+
+    if (noOfPartitions == 0)
+    {
+        partitions[0].node = 0;
+        partitions[0].cpus = allowed;
+        noOfPartitions = 1;
+    }
+
+    return noOfPartitions;
+}
+
+/*
+ * @brief Spread the workers over the nodes
+ *
+ * Nodes past the number of workers are left out
+ *
+ * @param NumaPartition pointer [array] (partitions)
+ * @param unsigned int (number of partitions found)
+ * @param unsigned int (number of workers)
+ * @return unsigned int (number of partitions used)
+ *
+ */
+static unsigned int assignWorkers(NumaPartition *partitions, unsigned int noOfPartitions, unsigned int noOfWorkers)
+{
+    if (noOfPartitions > noOfWorkers)
+    {
+        noOfPartitions = noOfWorkers;
+    }
+
+    unsigned int firstWorker = 0;
+
+    for (unsigned int index = 0; index < noOfPartitions; index++)
+    {
+        partitions[index].firstWorker = firstWorker;
+        partitions[index].noOfWorkers = noOfWorkers / noOfPartitions + (index < noOfWorkers % noOfPartitions);
+        firstWorker += partitions[index].noOfWorkers;
+    }
+
+    return noOfPartitions;
+}
+
+/*
+ * @brief Split the vertices into one range per node
+ *
+ * Each node gets a share of the edges in
+ * proportion to its workers, since expanding
+ * rows is most of the work
+ *
+ * @param Graph (pointer*)
+ * @param NumaPartition pointer [array] (partitions) => workers assigned
+ * @param unsigned int (number of partitions)
+ * @return void
+ *
+ */
+static void partitionVertices(const Graph *graph, NumaPartition *partitions, unsigned int noOfPartitions)
+{
+    unsigned int noOfWorkers = partitions[noOfPartitions - 1].firstWorker + partitions[noOfPartitions - 1].noOfWorkers;
+
+    for (unsigned int index = 0; index < noOfPartitions; index++)
+    {
+        size_t workersBefore = partitions[index].firstWorker;
+
+        partitions[index].firstVertex = graph->noOfEdges > 0
+            ? findEdgeBoundary(graph, graph->noOfEdges * workersBefore / noOfWorkers)
+            : (VertexId)((size_t)graph->noOfNodes * workersBefore / noOfWorkers);
+    }
+
+    for (unsigned int index = 0; index < noOfPartitions; index++)
+    {
+        partitions[index].lastVertex = index + 1 < noOfPartitions
+            ? partitions[index + 1].firstVertex : graph->noOfNodes;
+    }
+}
+
+/*
+ * @brief Move the pages of a range to a node
+ *
+ * @param void pointer (start)
+ * @param size_t (length in bytes)
+ * @param unsigned int (node)
+ * @return bool (false if the kernel refused)
+ *
+ */
+static bool placeRange(const void *start, size_t length, unsigned int node)
+{
+    if (length == 0)
+    {
+        return true;
+    }
+
+    uintptr_t pageSize = (uintptr_t)sysconf(_SC_PAGESIZE);
+    uintptr_t first = (uintptr_t)start & ~(pageSize - 1);
+    uintptr_t last = ((uintptr_t)start + length + pageSize - 1) & ~(pageSize - 1);
+    unsigned long nodeMask[MAX_NUMA_NODES / (8 * sizeof(unsigned long)) + 1] = { 0 };
+
+    nodeMask[node / (8 * sizeof(unsigned long))] = 1UL << (node % (8 * sizeof(unsigned long)));
+
+    return syscall
+    (
+        SYS_mbind, (void *)first, last - first, MPOL_PREFERRED, nodeMask, MAX_NUMA_NODES + 1, MPOL_MF_MOVE
+    ) == 0;
+}
+
+/*
+ * @brief Move every node's part of the graph to it
+ *
+ * The edge offsets, rows and visited bits of a
+ * node's vertices are moved to that node. Pages
+ * already in place stay put, so only the first
+ * traversal pays for the move
+ *
+ * @param NumaState (pointer*)
+ * @return bool (true if every range was moved)
+ *
+ * @note Nothing moves with a single node
+ *
+ */
+static bool placePartitions(const NumaState *state)
+{
+    if (state->noOfPartitions == 1)
+    {
+        return false;
+    }
+
+    const Graph *graph = state->graph;
+    bool placed = true;
+
+    for (unsigned int index = 0; index < state->noOfPartitions; index++)
+    {
+        const NumaPartition *partition = &state->partitions[index];
+        size_t firstEdge = graph->edgeOffsets[partition->firstVertex];
+        size_t lastEdge = graph->edgeOffsets[partition->lastVertex];
+        size_t firstWord = partition->firstVertex / BITMAP_WORD_BITS;
+        size_t lastWord = (partition->lastVertex + BITMAP_WORD_BITS - 1) / BITMAP_WORD_BITS;
+
+        placed &= placeRange
+        (
+            graph->edgeOffsets + partition->firstVertex,
+            (size_t)(partition->lastVertex - partition->firstVertex + 1) * sizeof(size_t),
+            partition->node
+        );
+        placed &= placeRange
+        (
+            graph->adjacentNodes + firstEdge, (lastEdge - firstEdge) * sizeof(VertexId), partition->node
+        );
+        placed &= placeRange
+        (
+            state->visited->words + firstWord, (lastWord - firstWord) * sizeof(uint64_t), partition->node
+        );
+    }
+
+    return placed;
+}
+
+/*
+ * @brief Push a vertex to a buffer
+ *
+ * @param VertexBuffer (pointer*)
+ * @param VertexId (vertex)
+ * @return void
+ *
+ */
+static void pushVertex(VertexBuffer *buffer, VertexId vertex)
+{
+    if (buffer->length == buffer->capacity)
+    {
+        size_t newCapacity = buffer->capacity == 0 ? 256 : buffer->capacity * 2;
+        VertexId *newVertices = (VertexId *)realloc(buffer->vertices, newCapacity * sizeof(VertexId));
+
+        if (newVertices == NULL)
+        {
+            perror("Failed to allocate memory\n");
+            exit(EXIT_FAILURE);
+        }
+
+        buffer->vertices = newVertices;
+        buffer->capacity = newCapacity;
+    }
+
+    buffer->vertices[buffer->length++] = vertex;
+}
+
+/*
+ * @brief Find the node that owns a vertex
+ *
+ * @param NumaState (pointer*)
+ * @param unsigned int (partition index) => checked first
+ * @param VertexId (vertex)
+ * @return unsigned int (partition index)
+ *
+ */
+static unsigned int findOwner(const NumaState *state, unsigned int partitionIndex, VertexId vertex)
+{
+    const NumaPartition *partitions = state->partitions;
+
+    if (vertex >= partitions[partitionIndex].firstVertex && vertex < partitions[partitionIndex].lastVertex)
+    {
+        return partitionIndex;
+    }
+
+    unsigned int owner = 0;
+
+    while (vertex >= partitions[owner].lastVertex)
+    {
+        owner++;
+    }
+
+    return owner;
+}
+
+/*
+ * @brief Expand a node's part of the frontier
+ *
+ * Takes chunks of the node's frontier until none
+ * are left. Neighbours the node owns are claimed
+ * right away, the others are kept for their owner
+ *
+ * @param NumaState (pointer*)
+ * @param NumaWorker (pointer*)
+ * @return void
+ *
+ */
+static void expandPartition(NumaState *state, NumaWorker *worker)
+{
+    const Graph *graph = state->graph;
+    NumaPartition *partition = &state->partitions[worker->partitionIndex];
+    unsigned int frontierSize = partition->frontierEnd - partition->frontierStart;
+    unsigned int chunkStart;
+
+    while
+    (
+        (chunkStart = __atomic_fetch_add(&partition->nextChunk, FRONTIER_CHUNK, __ATOMIC_RELAXED))
+        < frontierSize
+    )
+    {
+        unsigned int chunkEnd = chunkStart + FRONTIER_CHUNK < frontierSize ? chunkStart + FRONTIER_CHUNK : frontierSize;
+
+        for (unsigned int index = partition->frontierStart + chunkStart; index < partition->frontierStart + chunkEnd; index++)
+        {
+            VertexId frontierNode = state->traversalPath[index];
+            size_t rowStart = graph->edgeOffsets[frontierNode];
+            size_t rowEnd = graph->edgeOffsets[frontierNode + 1];
+
+            worker->verticesExpanded++;
+            worker->edgesExamined += rowEnd - rowStart;
+
+            for (size_t edge = rowStart; edge < rowEnd; edge++)
+            {
+                VertexId adjacentNode = graph->adjacentNodes[edge];
+                unsigned int owner = findOwner(state, worker->partitionIndex, adjacentNode);
+
+                if (owner != worker->partitionIndex)
+                {
+                    pushVertex(&worker->handOffs[owner], adjacentNode);
+                    worker->verticesSent++;
+                }
+                else if (setBitAtomic(state->visited, adjacentNode))
+                {
+                    pushVertex(&worker->next, adjacentNode);
+                }
+            }
+        }
+    }
+}
+
+/*
+ * @brief Claim the neighbours other nodes handed off
+ *
+ * The workers of a node share out the hand
+ * offs addressed to it, one sender at a time
+ *
+ * @param NumaState (pointer*)
+ * @param NumaWorker (pointer*)
+ * @return void
+ *
+ */
+static void receiveHandOffs(NumaState *state, NumaWorker *worker)
+{
+    NumaPartition *partition = &state->partitions[worker->partitionIndex];
+    unsigned int sender;
+
+    while ((sender = __atomic_fetch_add(&partition->nextBatch, 1, __ATOMIC_RELAXED)) < state->noOfWorkers)
+    {
+        const VertexBuffer *handOff = &state->workers[sender].handOffs[worker->partitionIndex];
+
+        worker->verticesReceived += handOff->length;
+
+        for (size_t index = 0; index < handOff->length; index++)
+        {
+            if (setBitAtomic(state->visited, handOff->vertices[index]))
+            {
+                pushVertex(&worker->next, handOff->vertices[index]);
+            }
+        }
+    }
+}
+
+/*
+ * @brief Lay out the next level in the path
+ *
+ * Run by a single thread between barriers. The
+ * vertices of each node follow each other, so
+ * the next frontier of a node is one slice
+ *
+ * @param NumaState (pointer*)
+ * @return void
+ *
+ */
+static void layoutLevel(NumaState *state)
+{
+    unsigned int offset = state->levelEnd;
+
+    for (unsigned int index = 0; index < state->noOfPartitions; index++)
+    {
+        NumaPartition *partition = &state->partitions[index];
+
+        partition->frontierStart = offset;
+
+        for (unsigned int worker = partition->firstWorker; worker < partition->firstWorker + partition->noOfWorkers; worker++)
+        {
+            state->workers[worker].pathOffset = offset;
+            offset += (unsigned int)state->workers[worker].next.length;
+        }
+
+        partition->frontierEnd = offset;
+        partition->nextChunk = 0;
+        partition->nextBatch = 0;
+    }
+
+    if (offset > state->levelEnd)
+    {
+        PROFILE_LEVEL(state->profile, offset - state->levelEnd, sumEdgesExamined(state), offset, false);
+    }
+
+    state->levelStart = state->levelEnd;
+    state->levelEnd = offset;
+    state->finished = state->levelStart == state->levelEnd;
+}
+
+/*
+ * @brief Copy a worker's claimed vertices into the path
+ *
+ * Also empties its buffers for the next level
+ *
+ * @param NumaState (pointer*)
+ * @param NumaWorker (pointer*)
+ * @return void
+ *
+ */
+static void copyNext(NumaState *state, NumaWorker *worker)
+{
+    if (worker->next.length > 0)
+    {
+        memcpy
+        (
+            state->traversalPath + worker->pathOffset, worker->next.vertices, worker->next.length * sizeof(VertexId)
+        );
+    }
+
+    worker->next.length = 0;
+
+    for (unsigned int index = 0; index < state->noOfPartitions; index++)
+    {
+        worker->handOffs[index].length = 0;
+    }
+}
+
+#ifdef BFS_INSTRUMENTATION
+/*
+ * @brief Sum edges examined by every worker so far
+ *
+ * @param NumaState (pointer*)
+ * @return size_t
+ *
+ * @note Only valid while the workers wait at a barrier
+ *
+ */
+static size_t sumEdgesExamined(const NumaState *state)
+{
+    size_t edgesExamined = 0;
+
+    for (unsigned int worker = 0; worker < state->noOfWorkers; worker++)
+    {
+        edgesExamined += state->workers[worker].edgesExamined;
+    }
+
+    return edgesExamined;
+}
+#endif
+
+/*
+ * @brief Worker thread body
+ *
+ * Pins itself to its node and runs every
+ * level together with the other workers
+ *
+ * @param void pointer (WorkerArgument)
+ * @return void pointer (NULL)
+ *
+ */
+static void *numaWorker(void *argument)
+{
+    WorkerArgument *workerArgument = (WorkerArgument *)argument;
+    NumaState *state = workerArgument->state;
+    unsigned int workerIndex = workerArgument->workerIndex;
+    NumaWorker *worker = &state->workers[workerIndex];
+
+    if (!enterWorker(&state->launch))
+    {
+        return NULL;
+    }
+
+    // a cpu outside the mask only costs the placement, never correctness
+    pthread_setaffinity_np
+    (
+        pthread_self(), sizeof(cpu_set_t), &state->partitions[worker->partitionIndex].cpus
+    );
+
+    while (!state->finished)
+    {
+        expandPartition(state, worker);
+
+        pthread_barrier_wait(&state->barrier);
+
+        receiveHandOffs(state, worker);
+
+        pthread_barrier_wait(&state->barrier);
+
+        if (workerIndex == 0)
+        {
+            layoutLevel(state);
+        }
+
+        pthread_barrier_wait(&state->barrier);
+
+        copyNext(state, worker);
+
+        pthread_barrier_wait(&state->barrier);
+
+        // the level stays untouched until the next copy, two barriers on
+        if (workerIndex == 0 && !state->finished)
+        {
+            visitLevel(state->visitor, state->traversalPath, state->levelStart, state->levelEnd, ++state->level);
+        }
+    }
+
+    return NULL;
+}
+
+/*
+ * @brief Fill in the per node work of a traversal
+ *
+ * @param NumaState (pointer*)
+ * @param bool (pages placed)
+ * @param NumaBalance (pointer*)
+ * @return void
+ *
+ */
+static void reportBalance(const NumaState *state, bool pagesPlaced, NumaBalance *balance)
+{
+    balance->noOfNodes = state->noOfPartitions;
+    balance->pagesPlaced = pagesPlaced;
+    balance->nodes = (NumaNodeWork *)calloc(state->noOfPartitions, sizeof(NumaNodeWork));
+
+    if (balance->nodes == NULL)
+    {
+        perror("Failed to allocate memory\n");
+        exit(EXIT_FAILURE);
+    }
+
+    for (unsigned int index = 0; index < state->noOfPartitions; index++)
+    {
+        const NumaPartition *partition = &state->partitions[index];
+        NumaNodeWork *nodeWork = &balance->nodes[index];
+
+        nodeWork->node = partition->node;
+        nodeWork->noOfThreads = partition->noOfWorkers;
+        nodeWork->firstVertex = partition->firstVertex;
+        nodeWork->lastVertex = partition->lastVertex;
+
+        for (unsigned int worker = partition->firstWorker; worker < partition->firstWorker + partition->noOfWorkers; worker++)
+        {
+            nodeWork->verticesExpanded += state->workers[worker].verticesExpanded;
+            nodeWork->edgesExamined += state->workers[worker].edgesExamined;
+            nodeWork->verticesSent += state->workers[worker].verticesSent;
+            nodeWork->verticesReceived += state->workers[worker].verticesReceived;
+        }
+    }
+}
+
+/*
+ * @brief Numa aware level synchronous bfs
+ *
+ * Every numa node owns a range of vertices and
+ * its pages of the adjacency and visited bits. Its
+ * workers, pinned to its cpus, expand only the
+ * frontier vertices it owns and claim only its own
+ * vertices. Neighbours owned elsewhere are handed
+ * off in one batch per node and level. On a single
+ * node machine this is a plain parallel bfs
+ *
+ * @param Graph (pointer*)
+ * @param TraversalOptions (pointer*) => per node work goes to numaBalance if set
+ * @param Bitmap (pointer*) => visited, all clear on entry
+ * @param VertexId pointer [array] (traversal path, room for every node)
+ * @param size_t (pointer*) => receives number of edges examined
+ * @return unsigned int (traversal length)
+ *
+ * @note Each level lists the vertices of one node after
+ *       the other, in no fixed order within a node
+ *
+ */
+unsigned int numaTraversal
+(
+    const Graph *graph,
+    const TraversalOptions *options,
+    Bitmap *visited,
+    VertexId *traversalPath,
+    size_t *edgesExamined
+)
+{
+    *edgesExamined = 0;
+
+    if (graph->noOfNodes == 0)
+    {
+        return 0;
+    }
+
+    NumaState state;
+    state.graph = graph;
+    state.visited = visited;
+    state.traversalPath = traversalPath;
+    state.noOfWorkers = resolveThreadCount(options->noOfThreads);
+    state.finished = false;
+    state.profile = options->profile;
+    state.visitor = options->visitor;
+    state.level = 0;
+
+    state.partitions = (NumaPartition *)calloc(MAX_NUMA_NODES, sizeof(NumaPartition));
+    state.workers = (NumaWorker *)calloc(state.noOfWorkers, sizeof(NumaWorker));
+    pthread_t *threads = (pthread_t *)malloc(state.noOfWorkers * sizeof(pthread_t));
+    WorkerArgument *workerArguments = (WorkerArgument *)malloc(state.noOfWorkers * sizeof(WorkerArgument));
+
+    if (state.partitions == NULL || state.workers == NULL || threads == NULL || workerArguments == NULL)
+    {
+        perror("Failed to allocate memory\n");
+        exit(EXIT_FAILURE);
+    }
+
+    state.noOfPartitions = assignWorkers(state.partitions, readTopology(state.partitions), state.noOfWorkers);
+    partitionVertices(graph, state.partitions, state.noOfPartitions);
+
+    bool pagesPlaced = placePartitions(&state);
+
+    for (unsigned int index = 0; index < state.noOfPartitions; index++)
+    {
+        const NumaPartition *partition = &state.partitions[index];
+
+        for (unsigned int worker = partition->firstWorker; worker < partition->firstWorker + partition->noOfWorkers; worker++)
+        {
+            state.workers[worker].partitionIndex = index;
+            state.workers[worker].handOffs = (VertexBuffer *)calloc(state.noOfPartitions, sizeof(VertexBuffer));
+
+            if (state.workers[worker].handOffs == NULL)
+            {
+                perror("Failed to allocate memory\n");
+                exit(EXIT_FAILURE);
+            }
+        }
+    }
+
+    // traversal starts from the first node in the node list, expanded by its owner
+    VertexId source = getListedVertex(graph, 0);
+    unsigned int sourceOwner = findOwner(&state, 0, source);
+
+    traversalPath[0] = source;
+    setBit(visited, source);
+    state.levelStart = 0;
+    state.levelEnd = 1;
+
+    for (unsigned int index = 0; index < state.noOfPartitions; index++)
+    {
+        state.partitions[index].frontierStart = index == sourceOwner ? 0 : 1;
+        state.partitions[index].frontierEnd = 1;
+    }
+
+    pthread_barrier_init(&state.barrier, NULL, state.noOfWorkers);
+
+    // the calling thread works as worker 0 and gets its own affinity back afterwards
+    cpu_set_t callerCpus;
+    bool restoreCpus = pthread_getaffinity_np(pthread_self(), sizeof(callerCpus), &callerCpus) == 0;
+
+    for (unsigned int worker = 0; worker < state.noOfWorkers; worker++)
+    {
+        workerArguments[worker].state = &state;
+        workerArguments[worker].workerIndex = worker;
+    }
+
+    startWorkers(&state.launch, threads, state.noOfWorkers, numaWorker, workerArguments, sizeof(WorkerArgument));
+
+    // written once every worker exists, so a failed launch prints nothing
+    PROFILE_LEVEL(state.profile, 1, 0, 1, false);
+    visitLevel(state.visitor, traversalPath, 0, 1, 0);
+
+    numaWorker(&workerArguments[0]);
+    joinWorkers(&state.launch, threads, state.noOfWorkers);
+
+    if (restoreCpus)
+    {
+        pthread_setaffinity_np(pthread_self(), sizeof(callerCpus), &callerCpus);
+    }
+
+    pthread_barrier_destroy(&state.barrier);
+
+    if (options->numaBalance != NULL)
+    {
+        reportBalance(&state, pagesPlaced, options->numaBalance);
+    }
+
+    for (unsigned int worker = 0; worker < state.noOfWorkers; worker++)
+    {
+        *edgesExamined += state.workers[worker].edgesExamined;
+        free(state.workers[worker].next.vertices);
+
+        for (unsigned int index = 0; index < state.noOfPartitions; index++)
+        {
+            free(state.workers[worker].handOffs[index].vertices);
+        }
+
+        free(state.workers[worker].handOffs);
+    }
+
+    PROFILE_FINISH(state.profile, *edgesExamined, state.levelEnd);
+
+    free(state.partitions);
+    free(state.workers);
+    free(threads);
+    free(workerArguments);
+
+    return state.levelEnd;
+}
+
+/*
+ * @brief Free numa balance struct
+ *
+ * @param NumaBalance (pointer*)
+ * @return void
+ *
+ */
+void freeNumaBalance(NumaBalance *balance)
+{
+    free(balance->nodes);
+
+    balance->nodes = NULL;
+    balance->noOfNodes = 0;
+}
@@ -0,0 +1,424 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+#include "options.h"
+#include "distributedBfs.h"
+#include "logic.h"
+
+/*
+ * @brief declarations for internal functions
+ *
+ * List of static functions local to this file
+ * Meant to be used in this file only
+ * 
+ * @note all internal functions are static
+ */
+static void printUsage(const char *programName);
+
+/*
+ * @brief Display usage
+ * 
+ * @param char pointer [array] (program name)
+ * @return void
+ * 
+ */
+static void printUsage(const char *programName)
+{
+    printf("Usage: %s [options]\n", programName);
+    printf("  -f, --file PATH    graph data file or snapshot (default data/graph.txt)\n");
+    printf("  -s, --save PATH    save the graph as a binary snapshot instead of traversing\n");
+    printf("      --sources PATH run a bfs from every node named in PATH, batched together\n");
+    printf("      --serve        load the graph once and answer requests on stdin\n");
+    printf("      --socket PATH  load the graph once and answer requests on a unix socket\n");
+    printf("      --tree         print the parent and hop distance of every node\n");
+    printf("      --from NODE    with --to, print the shortest hop path between two nodes\n");
+    printf("      --to NODE      found with a bidirectional bfs\n");
+    printf("      --components   print the number and sizes of the connected components\n");
+    printf("      --labels PATH  with --components, write the component of every node to PATH\n");
+    printf("      --weighted     print weighted shortest paths from the first node, with\n");
+    printf("                     Dijkstra on one thread and delta stepping on more\n");
+    printf("      --delta N      delta stepping bucket width (default: average edge weight)\n");
+    printf("      --reorder ORDER\n");
+    printf("                     relabel vertices for locality first: rcm, degree, bfs,\n");
+    printf("                     none (default)\n");
+    printf("      --dedup POLICY sort every row and merge repeated edges, keeping the first,\n");
+    printf("                     the min weight or the sum of the weights: first, min, sum\n");
+    printf("      --drop-self-loops\n");
+    printf("                     remove edges from a node to itself\n");
+    printf("      --external     bfs a snapshot without loading it, reading the adjacency\n");
+    printf("                     from disk level by level; prints the bytes read per level\n");
+    printf("      --processes N  split the graph over N worker processes (at most 16) that\n");
+    printf("                     swap frontier batches over unix sockets; prints the\n");
+    printf("                     traffic per level\n");
+    printf("      --compress     keep the adjacency as varint gaps and report the bytes per\n");
+    printf("                     edge, top-down traversal only\n");
+    printf("  -m, --mode MODE    traversal kernel: top-down (default), direction-optimizing,\n");
+    printf("                     parallel, numa\n");
+    printf("      --alpha N      bottom-up switch threshold (default 15)\n");
+    printf("      --beta N       top-down switch threshold (default 18)\n");
+    printf("  -t, --threads N    threads for loading and the parallel and numa kernels\n");
+    printf("                     (default: every core, at most four per core)\n");
+    printf("  -d, --deterministic\n");
+    printf("                     parallel kernel keeps the top-down path order\n");
+    printf("      --stats PATH   write per level statistics as JSON to PATH (- for stdout),\n");
+    printf("                     needs a build made with INSTRUMENT=1\n");
+    printf("      --counters     also record cache and branch misses with --stats\n");
+    printf("  -v, --verbose      also print the number of edges examined, and the work of\n");
+    printf("                     every node with --mode numa\n");
+    printf("  -h, --help         show this message\n");
+}
+
+/*
+ * @brief Parse a positive integer option value
+ * 
+ * @param char pointer [array] (text)
+ * @param char pointer [array] (option name used in errors)
+ * @return unsigned int
+ * 
+ */
+unsigned int parsePositive(const char *text, const char *optionName)
+{
+    char *end;
+    unsigned long value = strtoul(text, &end, 10);
+
+    if (*text == '\0' || *end != '\0' || value == 0 || value > 0xFFFFFFFFUL)
+    {
+        fprintf(stderr, "Invalid value for %s: %s\n", optionName, text);
+        exit(EXIT_FAILURE);
+    }
+
+    return (unsigned int)value;
+}
+
+/*
+ * @brief Parse a traversal mode name
+ * 
+ * @param char pointer [array] (text)
+ * @return TraversalMode
+ * 
+ * @note Exits on an unknown name
+ * 
+ */
+TraversalMode parseTraversalMode(const char *text)
+{
+    if (strcmp(text, "top-down") == 0)
+    {
+        return TOP_DOWN_TRAVERSAL;
+    }
+    else if (strcmp(text, "direction-optimizing") == 0)
+    {
+        return DIRECTION_OPTIMIZING_TRAVERSAL;
+    }
+    else if (strcmp(text, "parallel") == 0)
+    {
+        return PARALLEL_TRAVERSAL;
+    }
+    else if (strcmp(text, "numa") == 0)
+    {
+        return NUMA_TRAVERSAL;
+    }
+
+    fprintf(stderr, "Unknown traversal mode: %s\n", text);
+    exit(EXIT_FAILURE);
+}
+
+/*
+ * @brief Parse a reorder method name
+ * 
+ * @param char pointer [array] (text)
+ * @return ReorderMethod
+ * 
+ * @note Exits on an unknown name
+ * 
+ */
+ReorderMethod parseReorderMethod(const char *text)
+{
+    if (strcmp(text, "none") == 0)
+    {
+        return NO_REORDER;
+    }
+    else if (strcmp(text, "rcm") == 0)
+    {
+        return RCM_REORDER;
+    }
+    else if (strcmp(text, "degree") == 0)
+    {
+        return DEGREE_REORDER;
+    }
+    else if (strcmp(text, "bfs") == 0)
+    {
+        return BFS_REORDER;
+    }
+
+    fprintf(stderr, "Unknown reorder method: %s\n", text);
+    exit(EXIT_FAILURE);
+}
+
+/*
+ * @brief Parse a multi-edge policy name
+ * 
+ * @param char pointer [array] (text)
+ * @return MultiEdgePolicy
+ * 
+ * @note Exits on an unknown name
+ * 
+ */
+MultiEdgePolicy parseMultiEdgePolicy(const char *text)
+{
+    if (strcmp(text, "first") == 0)
+    {
+        return KEEP_FIRST_EDGE;
+    }
+    else if (strcmp(text, "min") == 0)
+    {
+        return KEEP_MIN_WEIGHT;
+    }
+    else if (strcmp(text, "sum") == 0)
+    {
+        return SUM_WEIGHTS;
+    }
+
+    fprintf(stderr, "Unknown multi-edge policy: %s\n", text);
+    exit(EXIT_FAILURE);
+}
+
+/*
+ * @brief Parse command line options
+ * 
+ * Fills the options struct from the command
+ * line, leaving defaults for anything not given
+ * 
+ * @param int (argument count)
+ * @param char pointer [2d array] (argument values)
+ * @param Options (pointer*)
+ * @return void
+ * 
+ * @note Exits on invalid input or after printing help
+ * 
+ */
+void parseOptions(int argc, char *argv[], Options *options)
+{
+    enum
+    {
+        ALPHA_OPTION = 256, BETA_OPTION, SOURCES_OPTION, SERVE_OPTION, SOCKET_OPTION,
+        STATS_OPTION, COUNTERS_OPTION, TREE_OPTION, FROM_OPTION, TO_OPTION, WEIGHTED_OPTION,
+        DELTA_OPTION, COMPONENTS_OPTION, LABELS_OPTION, REORDER_OPTION,
+        COMPRESS_OPTION, EXTERNAL_OPTION, PROCESSES_OPTION, DEDUP_OPTION, DROP_SELF_LOOPS_OPTION
+    };
+
+    static const struct option longOptions[] = {
+        { "file", required_argument, NULL, 'f' },
+        { "save", required_argument, NULL, 's' },
+        { "sources", required_argument, NULL, SOURCES_OPTION },
+        { "serve", no_argument, NULL, SERVE_OPTION },
+        { "socket", required_argument, NULL, SOCKET_OPTION },
+        { "tree", no_argument, NULL, TREE_OPTION },
+        { "from", required_argument, NULL, FROM_OPTION },
+        { "to", required_argument, NULL, TO_OPTION },
+        { "components", no_argument, NULL, COMPONENTS_OPTION },
+        { "labels", required_argument, NULL, LABELS_OPTION },
+        { "weighted", no_argument, NULL, WEIGHTED_OPTION },
+        { "delta", required_argument, NULL, DELTA_OPTION },
+        { "reorder", required_argument, NULL, REORDER_OPTION },
+        { "dedup", required_argument, NULL, DEDUP_OPTION },
+        { "drop-self-loops", no_argument, NULL, DROP_SELF_LOOPS_OPTION },
+        { "compress", no_argument, NULL, COMPRESS_OPTION },
+        { "external", no_argument, NULL, EXTERNAL_OPTION },
+        { "processes", required_argument, NULL, PROCESSES_OPTION },
+        { "mode", required_argument, NULL, 'm' },
+        { "alpha", required_argument, NULL, ALPHA_OPTION },
+        { "beta", required_argument, NULL, BETA_OPTION },
+        { "threads", required_argument, NULL, 't' },
+        { "deterministic", no_argument, NULL, 'd' },
+        { "stats", required_argument, NULL, STATS_OPTION },
+        { "counters", no_argument, NULL, COUNTERS_OPTION },
+        { "verbose", no_argument, NULL, 'v' },
+        { "help", no_argument, NULL, 'h' },
+        { NULL, 0, NULL, 0 }
+    };
+
+    options->fileName = "data/graph.txt";
+    options->snapshotFileName = NULL;
+    options->sourcesFileName = NULL;
+    options->serve = false;
+    options->socketPath = NULL;
+    options->tree = false;
+    options->pathStart = NULL;
+    options->pathGoal = NULL;
+    options->components = false;
+    options->labelsFileName = NULL;
+    options->weighted = false;
+    options->reorder = NO_REORDER;
+    options->multiEdgePolicy = KEEP_MULTI_EDGES;
+    options->dropSelfLoops = false;
+    options->compress = false;
+    options->external = false;
+    options->noOfProcesses = 0;
+    initTraversalOptions(&options->traversal);
+
+    int option;
+    while ((option = getopt_long(argc, argv, "f:s:m:t:dvh", longOptions, NULL)) != -1)
+    {
+        switch (option)
+        {
+            case 'f':
+                options->fileName = optarg;
+                break;
+            case 's':
+                options->snapshotFileName = optarg;
+                break;
+            case SOURCES_OPTION:
+                options->sourcesFileName = optarg;
+                break;
+            case SERVE_OPTION:
+                options->serve = true;
+                break;
+            case SOCKET_OPTION:
+                options->socketPath = optarg;
+                break;
+            case TREE_OPTION:
+                options->tree = true;
+                break;
+            case FROM_OPTION:
+                options->pathStart = optarg;
+                break;
+            case TO_OPTION:
+                options->pathGoal = optarg;
+                break;
+            case COMPONENTS_OPTION:
+                options->components = true;
+                break;
+            case LABELS_OPTION:
+                options->labelsFileName = optarg;
+                break;
+            case WEIGHTED_OPTION:
+                options->weighted = true;
+                break;
+            case DELTA_OPTION:
+                options->traversal.delta = parsePositive(optarg, "--delta");
+                break;
+            case REORDER_OPTION:
+                options->reorder = parseReorderMethod(optarg);
+                break;
+            case DEDUP_OPTION:
+                options->multiEdgePolicy = parseMultiEdgePolicy(optarg);
+                break;
+            case DROP_SELF_LOOPS_OPTION:
+                options->dropSelfLoops = true;
+                break;
+            case COMPRESS_OPTION:
+                options->compress = true;
+                break;
+            case EXTERNAL_OPTION:
+                options->external = true;
+                break;
+            case PROCESSES_OPTION:
+                options->noOfProcesses = parsePositive(optarg, "--processes");
+                break;
+            case 'm':
+                options->traversal.mode = parseTraversalMode(optarg);
+                break;
+            case ALPHA_OPTION:
+                options->traversal.alpha = parsePositive(optarg, "--alpha");
+                break;
+            case BETA_OPTION:
+                options->traversal.beta = parsePositive(optarg, "--beta");
+                break;
+            case 't':
+                options->traversal.noOfThreads = parsePositive(optarg, "--threads");
+                break;
+            case 'd':
+                options->traversal.deterministic = true;
+                break;
+            case STATS_OPTION:
+#ifndef BFS_INSTRUMENTATION
+                fprintf(stderr, "--stats needs a build made with INSTRUMENT=1\n");
+                exit(EXIT_FAILURE);
+#endif
+                options->traversal.statsFileName = optarg;
+                break;
+            case COUNTERS_OPTION:
+                options->traversal.hardwareCounters = true;
+                break;
+            case 'v':
+                options->traversal.verbose = true;
+                break;
+            case 'h':
+                printUsage(argv[0]);
+                exit(EXIT_SUCCESS);
+            default:
+                printUsage(argv[0]);
+                exit(EXIT_FAILURE);
+        }
+    }
+
+    if (optind < argc)
+    {
+        fprintf(stderr, "Unexpected argument: %s\n", argv[optind]);
+        exit(EXIT_FAILURE);
+    }
+
+    // a snapshot has no room for the node list order
+    if (options->reorder != NO_REORDER && options->snapshotFileName != NULL)
+    {
+        fprintf(stderr, "--reorder cannot be combined with --save\n");
+        exit(EXIT_FAILURE);
+    }
+
+    if (options->labelsFileName != NULL && !options->components)
+    {
+        fprintf(stderr, "--labels needs --components\n");
+        exit(EXIT_FAILURE);
+    }
+
+    if ((options->pathStart == NULL) != (options->pathGoal == NULL))
+    {
+        fprintf(stderr, "--from and --to must be given together\n");
+        exit(EXIT_FAILURE);
+    }
+
+    // every other feature reads the plain edge arrays
+    bool plainOnly = options->snapshotFileName != NULL || options->sourcesFileName != NULL
+        || options->serve || options->socketPath != NULL || options->tree || options->pathStart != NULL
+        || options->components || options->weighted;
+
+    if
+    (
+        options->external &&
+        (
+            plainOnly || options->compress || options->reorder != NO_REORDER ||
+            options->multiEdgePolicy != KEEP_MULTI_EDGES || options->dropSelfLoops ||
+            options->traversal.mode != TOP_DOWN_TRAVERSAL || options->traversal.statsFileName != NULL
+        )
+    )
+    {
+        fprintf(stderr, "--external only works with the plain top-down traversal\n");
+        exit(EXIT_FAILURE);
+    }
+
+    if (options->noOfProcesses > MAX_BFS_PROCESSES)
+    {
+        fprintf(stderr, "--processes takes at most %d worker processes\n", MAX_BFS_PROCESSES);
+        exit(EXIT_FAILURE);
+    }
+
+    if
+    (
+        options->noOfProcesses > 0 &&
+        (
+            plainOnly || options->compress || options->external ||
+            options->traversal.mode != TOP_DOWN_TRAVERSAL || options->traversal.statsFileName != NULL
+        )
+    )
+    {
+        fprintf(stderr, "--processes only works with the plain top-down traversal\n");
+        exit(EXIT_FAILURE);
+    }
+
+    if (options->compress && (plainOnly || options->traversal.mode != TOP_DOWN_TRAVERSAL))
+    {
+        fprintf(stderr, "--compress only works with the top-down traversal\n");
+        exit(EXIT_FAILURE);
+    }
+}
@@ -0,0 +1,743 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <pthread.h>
+#include "parallelBfs.h"
+#include "bitmap.h"
+#include "types.h"
+#include "logic.h"
+#include "reorder.h"
+#include "traversalProfile.h"
+#include "bfsVisitor.h"
+#include "workerThreads.h"
+
+/*
+ * @brief Frontier indexes handed to a thread at a time
+ *
+ * Small enough to balance levels where a few
+ * hubs own most of the edges
+ *
+ */
+#define FRONTIER_CHUNK 64
+
+/*
+ * @brief Unset discovery key
+ *
+ * Marks a vertex not discovered in the
+ * current level (deterministic mode only)
+ *
+ */
+#define UNSET_KEY UINT64_MAX
+
+/*
+ * @brief Local frontier data structure
+ *
+ * LocalFrontier struct is the private next
+ * frontier buffer of a single thread
+ * 
+ * @member VertexId pointer [array] (vertices) => vertices claimed by the thread
+ * @member size_t (length) => number of vertices claimed this level
+ * @member size_t (capacity) => number of vertices that fit before growing
+ * @member size_t (edges examined) => edges scanned by the thread
+ *
+ */
+typedef struct LocalFrontier {
+    VertexId *vertices;
+    size_t length;
+    size_t capacity;
+    size_t edgesExamined;
+} LocalFrontier;
+
+/*
+ * @brief Parallel traversal state data structure
+ *
+ * ParallelState struct is shared by every thread of
+ * a traversal. Levels are contiguous slices of the
+ * path and threads meet at a barrier between phases
+ * 
+ * @member Graph (pointer*) => graph being traversed
+ * @member Bitmap (pointer*) => visited, claimed with an atomic or on its word
+ * @member VertexId pointer [array] (traversal path) => path, doubling as the queue
+ * @member uint64_t pointer [array] (discovery keys) => earliest discovering edge per vertex
+ * @member LocalFrontier pointer [array] (local frontiers) => one buffer per thread
+ * @member unsigned int (number of threads) => threads taking part
+ * @member bool (deterministic) => order each level as the top-down bfs would
+ * @member unsigned int (level start) => start of the frontier in the path
+ * @member unsigned int (level end) => end of the frontier in the path
+ * @member unsigned int (next chunk) => next frontier offset to hand out
+ * @member bool (finished) => set once a level discovers nothing
+ * @member TraversalProfile (pointer*) => receives per level statistics, may be NULL
+ * @member BfsVisitor (pointer*) => receives each finished level, may be NULL
+ * @member unsigned int (level) => distance of the current frontier from the source
+ * @member pthread_barrier_t (barrier) => separates the phases of a level
+ * @member WorkerLaunch (launch) => holds the workers until all are created
+ *
+ */
+typedef struct ParallelState {
+    const Graph *graph;
+    Bitmap *visited;
+    VertexId *traversalPath;
+    uint64_t *discoveryKeys;
+    LocalFrontier *localFrontiers;
+    unsigned int noOfThreads;
+    bool deterministic;
+    unsigned int levelStart;
+    unsigned int levelEnd;
+    unsigned int nextChunk;
+    bool finished;
+    TraversalProfile *profile;
+    const BfsVisitor *visitor;
+    unsigned int level;
+    pthread_barrier_t barrier;
+    WorkerLaunch launch;
+} ParallelState;
+
+/*
+ * @brief Worker argument data structure
+ *
+ * @member ParallelState (pointer*) => shared state
+ * @member unsigned int (thread index) => index of this thread's local frontier
+ *
+ */
+typedef struct WorkerArgument {
+    ParallelState *state;
+    unsigned int threadIndex;
+} WorkerArgument;
+
+/*
+ * @brief declarations for internal functions
+ *
+ * List of static functions local to this file
+ * Meant to be used in this file only
+ * 
+ * @note all internal functions are static
+ */
+static void pushLocalFrontier(LocalFrontier *localFrontier, VertexId vertex);
+static bool lowerDiscoveryKey(uint64_t *discoveryKeys, VertexId vertex, uint64_t key);
+static void expandFrontier(ParallelState *state, LocalFrontier *localFrontier);
+static void sortLocalFrontier(const ParallelState *state, LocalFrontier *localFrontier);
+static void copyLocalFrontier(ParallelState *state, unsigned int threadIndex);
+static uint64_t getHeadKey(const ParallelState *state, const size_t *heads, unsigned int thread);
+static void siftMergeHeap
+(
+    const ParallelState *state,
+    unsigned int *heap,
+    const size_t *heads,
+    unsigned int heapSize,
+    unsigned int position
+);
+static unsigned int mergeLocalFrontiers(ParallelState *state);
+static void advanceLevel(ParallelState *state);
+#ifdef BFS_INSTRUMENTATION
+static size_t sumEdgesExamined(const ParallelState *state);
+#endif
+static void *bfsWorker(void *argument);
+
+/*
+ * @brief Push a vertex to a local frontier
+ * 
+ * @param LocalFrontier (pointer*)
+ * @param VertexId (vertex)
+ * @return void
+ * 
+ */
+static void pushLocalFrontier(LocalFrontier *localFrontier, VertexId vertex)
+{
+    if (localFrontier->length == localFrontier->capacity)
+    {
+        size_t newCapacity = localFrontier->capacity == 0 ? 256 : localFrontier->capacity * 2;
+
+        VertexId *newVertices = (VertexId *)realloc
+        (
+            localFrontier->vertices, newCapacity * sizeof(VertexId)
+        );
+
+        if (newVertices == NULL)
+        {
+            perror("Failed to allocate memory\n");
+            exit(EXIT_FAILURE);
+        }
+
+        localFrontier->vertices = newVertices;
+        localFrontier->capacity = newCapacity;
+    }
+
+    localFrontier->vertices[localFrontier->length++] = vertex;
+}
+
+/*
+ * @brief Lower the discovery key of a vertex
+ * 
+ * Atomic minimum over the keys of every edge
+ * reaching the vertex during a level
+ * 
+ * @param uint64_t pointer [array] (discovery keys)
+ * @param VertexId (vertex)
+ * @param uint64_t (key of the discovering edge)
+ * @return bool (true if this call discovered the vertex first)
+ * 
+ */
+static bool lowerDiscoveryKey(uint64_t *discoveryKeys, VertexId vertex, uint64_t key)
+{
+    uint64_t currentKey = __atomic_load_n(&discoveryKeys[vertex], __ATOMIC_RELAXED);
+
+    while (key < currentKey)
+    {
+        if
+        (
+            __atomic_compare_exchange_n
+            (
+                &discoveryKeys[vertex], &currentKey, key, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED
+            )
+        )
+        {
+            return currentKey == UNSET_KEY;
+        }
+    }
+
+    return false;
+}
+
+/*
+ * @brief Expand the frontier
+ * 
+ * Takes chunks of the frontier until none are
+ * left and scans the outgoing rows of each vertex.
+ * Discovered vertices go to the thread's local frontier
+ * 
+ * @param ParallelState (pointer*)
+ * @param LocalFrontier (pointer*)
+ * @return void
+ * 
+ * @note The deterministic mode keys each edge by the
+ *       path index of its source and its row position,
+ *       which is the order a top-down bfs meets it in
+ * 
+ */
+static void expandFrontier(ParallelState *state, LocalFrontier *localFrontier)
+{
+    const Graph *graph = state->graph;
+    unsigned int frontierSize = state->levelEnd - state->levelStart;
+    unsigned int chunkStart;
+
+    while
+    (
+        (chunkStart = __atomic_fetch_add(&state->nextChunk, FRONTIER_CHUNK, __ATOMIC_RELAXED))
+        < frontierSize
+    )
+    {
+        unsigned int chunkEnd = chunkStart + FRONTIER_CHUNK;
+        if (chunkEnd > frontierSize)
+        {
+            chunkEnd = frontierSize;
+        }
+
+        for (unsigned int index = state->levelStart + chunkStart; index < state->levelStart + chunkEnd; index++)
+        {
+            VertexId frontierNode = state->traversalPath[index];
+            size_t rowStart = graph->edgeOffsets[frontierNode];
+            size_t rowEnd = graph->edgeOffsets[frontierNode + 1];
+
+            localFrontier->edgesExamined += rowEnd - rowStart;
+
+            for (size_t edge = rowStart; edge < rowEnd; edge++)
+            {
+                VertexId adjacentNode = graph->adjacentNodes[edge];
+
+                if (state->deterministic)
+                {
+                    // visited only changes between levels in this mode
+                    if (testBit(state->visited, adjacentNode))
+                    {
+                        continue;
+                    }
+
+                    uint64_t key = ((uint64_t)index << 32) | (uint64_t)(edge - rowStart);
+
+                    if (lowerDiscoveryKey(state->discoveryKeys, adjacentNode, key))
+                    {
+                        pushLocalFrontier(localFrontier, adjacentNode);
+                    }
+                }
+                else if (setBitAtomic(state->visited, adjacentNode))
+                {
+                    pushLocalFrontier(localFrontier, adjacentNode);
+                }
+            }
+        }
+    }
+}
+
+/*
+ * @brief Sort a local frontier by discovery key
+ * 
+ * Bottom-up merge sort of the vertices a
+ * thread claimed during the level
+ * 
+ * @param ParallelState (pointer*)
+ * @param LocalFrontier (pointer*)
+ * @return void
+ * 
+ */
+static void sortLocalFrontier(const ParallelState *state, LocalFrontier *localFrontier)
+{
+    const uint64_t *keys = state->discoveryKeys;
+    VertexId *vertices = localFrontier->vertices;
+    size_t length = localFrontier->length;
+
+    if (length < 2)
+    {
+        return;
+    }
+
+    VertexId *buffer = (VertexId *)malloc(length * sizeof(VertexId));
+
+    if (buffer == NULL)
+    {
+        perror("Failed to allocate memory\n");
+        exit(EXIT_FAILURE);
+    }
+
+    VertexId *source = vertices;
+    VertexId *target = buffer;
+
+    for (size_t width = 1; width < length; width *= 2)
+    {
+        for (size_t left = 0; left < length; left += 2 * width)
+        {
+            size_t middle = left + width < length ? left + width : length;
+            size_t right = left + 2 * width < length ? left + 2 * width : length;
+            size_t first = left, second = middle, output = left;
+
+            while (first < middle && second < right)
+            {
+                if (keys[source[second]] < keys[source[first]])
+                {
+                    target[output++] = source[second++];
+                }
+                else
+                {
+                    target[output++] = source[first++];
+                }
+            }
+            while (first < middle)
+            {
+                target[output++] = source[first++];
+            }
+            while (second < right)
+            {
+                target[output++] = source[second++];
+            }
+        }
+
+        VertexId *swap = source;
+        source = target;
+        target = swap;
+    }
+
+    if (source != vertices)
+    {
+        for (size_t index = 0; index < length; index++)
+        {
+            vertices[index] = source[index];
+        }
+    }
+
+    free(buffer);
+}
+
+/*
+ * @brief Copy a local frontier into the path
+ * 
+ * Each thread writes its own buffer after the
+ * buffers of the threads before it
+ * 
+ * @param ParallelState (pointer*)
+ * @param unsigned int (thread index)
+ * @return void
+ * 
+ */
+static void copyLocalFrontier(ParallelState *state, unsigned int threadIndex)
+{
+    size_t offset = state->levelEnd;
+
+    for (unsigned int thread = 0; thread < threadIndex; thread++)
+    {
+        offset += state->localFrontiers[thread].length;
+    }
+
+    LocalFrontier *localFrontier = &state->localFrontiers[threadIndex];
+
+    for (size_t index = 0; index < localFrontier->length; index++)
+    {
+        state->traversalPath[offset + index] = localFrontier->vertices[index];
+    }
+}
+
+/*
+ * @brief Get the discovery key at the head of a local frontier
+ * 
+ * @param ParallelState (pointer*)
+ * @param size_t pointer [array] (head of each local frontier)
+ * @param unsigned int (thread index)
+ * @return uint64_t
+ * 
+ */
+static uint64_t getHeadKey(const ParallelState *state, const size_t *heads, unsigned int thread)
+{
+    return state->discoveryKeys[state->localFrontiers[thread].vertices[heads[thread]]];
+}
+
+/*
+ * @brief Restore the merge heap below a position
+ * 
+ * The heap holds thread indexes ordered by the
+ * discovery key at the head of their local frontier
+ * 
+ * @param ParallelState (pointer*)
+ * @param unsigned int pointer [array] (heap of thread indexes)
+ * @param size_t pointer [array] (head of each local frontier)
+ * @param unsigned int (heap size)
+ * @param unsigned int (position to sift down from)
+ * @return void
+ * 
+ */
+static void siftMergeHeap
+(
+    const ParallelState *state,
+    unsigned int *heap,
+    const size_t *heads,
+    unsigned int heapSize,
+    unsigned int position
+)
+{
+    for (;;)
+    {
+        unsigned int smallest = position;
+        unsigned int left = 2 * position + 1;
+        unsigned int right = left + 1;
+
+        if (left < heapSize && getHeadKey(state, heads, heap[left]) < getHeadKey(state, heads, heap[smallest]))
+        {
+            smallest = left;
+        }
+        if (right < heapSize && getHeadKey(state, heads, heap[right]) < getHeadKey(state, heads, heap[smallest]))
+        {
+            smallest = right;
+        }
+
+        if (smallest == position)
+        {
+            return;
+        }
+
+        unsigned int swap = heap[position];
+        heap[position] = heap[smallest];
+        heap[smallest] = swap;
+        position = smallest;
+    }
+}
+
+/*
+ * @brief Merge sorted local frontiers into the path
+ * 
+ * K-way heap merge by discovery key. Also marks
+ * the merged vertices visited and clears their keys
+ * 
+ * @param ParallelState (pointer*)
+ * @return unsigned int (end of next frontier in path)
+ * 
+ */
+static unsigned int mergeLocalFrontiers(ParallelState *state)
+{
+    unsigned int noOfThreads = state->noOfThreads;
+    size_t *heads = (size_t *)calloc(noOfThreads, sizeof(size_t));
+    unsigned int *heap = (unsigned int *)malloc(noOfThreads * sizeof(unsigned int));
+
+    if (heads == NULL || heap == NULL)
+    {
+        perror("Failed to allocate memory\n");
+        exit(EXIT_FAILURE);
+    }
+
+    unsigned int heapSize = 0;
+
+    for (unsigned int thread = 0; thread < noOfThreads; thread++)
+    {
+        if (state->localFrontiers[thread].length > 0)
+        {
+            heap[heapSize++] = thread;
+        }
+    }
+
+    for (unsigned int position = heapSize / 2; position-- > 0; )
+    {
+        siftMergeHeap(state, heap, heads, heapSize, position);
+    }
+
+    unsigned int pathLength = state->levelEnd;
+
+    while (heapSize > 0)
+    {
+        unsigned int thread = heap[0];
+        VertexId vertex = state->localFrontiers[thread].vertices[heads[thread]++];
+
+        state->traversalPath[pathLength++] = vertex;
+        setBit(state->visited, vertex);
+
+        // drop exhausted buffers from the heap
+        if (heads[thread] == state->localFrontiers[thread].length)
+        {
+            heap[0] = heap[--heapSize];
+        }
+
+        siftMergeHeap(state, heap, heads, heapSize, 0);
+    }
+
+    for (unsigned int index = state->levelEnd; index < pathLength; index++)
+    {
+        state->discoveryKeys[state->traversalPath[index]] = UNSET_KEY;
+    }
+
+    free(heads);
+    free(heap);
+
+    return pathLength;
+}
+
+/*
+ * @brief Advance to the next level
+ * 
+ * Run by a single thread between barriers
+ * 
+ * @param ParallelState (pointer*)
+ * @return void
+ * 
+ */
+static void advanceLevel(ParallelState *state)
+{
+    unsigned int nextEnd;
+
+    if (state->deterministic)
+    {
+        nextEnd = mergeLocalFrontiers(state);
+    }
+    else
+    {
+        nextEnd = state->levelEnd;
+        for (unsigned int thread = 0; thread < state->noOfThreads; thread++)
+        {
+            nextEnd += (unsigned int)state->localFrontiers[thread].length;
+        }
+    }
+
+    for (unsigned int thread = 0; thread < state->noOfThreads; thread++)
+    {
+        state->localFrontiers[thread].length = 0;
+    }
+
+    if (nextEnd > state->levelEnd)
+    {
+        PROFILE_LEVEL
+        (
+            state->profile, nextEnd - state->levelEnd, sumEdgesExamined(state), nextEnd, false
+        );
+        visitLevel(state->visitor, state->traversalPath, state->levelEnd, nextEnd, ++state->level);
+    }
+
+    state->levelStart = state->levelEnd;
+    state->levelEnd = nextEnd;
+    state->nextChunk = 0;
+    state->finished = state->levelStart == state->levelEnd;
+}
+
+#ifdef BFS_INSTRUMENTATION
+/*
+ * @brief Sum edges examined by every thread so far
+ * 
+ * @param ParallelState (pointer*)
+ * @return size_t
+ * 
+ * @note Only valid while the threads wait at a barrier
+ * 
+ */
+static size_t sumEdgesExamined(const ParallelState *state)
+{
+    size_t edgesExamined = 0;
+
+    for (unsigned int thread = 0; thread < state->noOfThreads; thread++)
+    {
+        edgesExamined += state->localFrontiers[thread].edgesExamined;
+    }
+
+    return edgesExamined;
+}
+#endif
+
+/*
+ * @brief Worker thread body
+ * 
+ * Runs every level of the traversal together
+ * with the other workers
+ * 
+ * @param void pointer (WorkerArgument)
+ * @return void pointer (NULL)
+ * 
+ */
+static void *bfsWorker(void *argument)
+{
+    WorkerArgument *workerArgument = (WorkerArgument *)argument;
+    ParallelState *state = workerArgument->state;
+    unsigned int threadIndex = workerArgument->threadIndex;
+    LocalFrontier *localFrontier = &state->localFrontiers[threadIndex];
+
+    if (!enterWorker(&state->launch))
+    {
+        return NULL;
+    }
+
+    while (!state->finished)
+    {
+        expandFrontier(state, localFrontier);
+
+        pthread_barrier_wait(&state->barrier);
+
+        if (state->deterministic)
+        {
+            sortLocalFrontier(state, localFrontier);
+        }
+        else
+        {
+            copyLocalFrontier(state, threadIndex);
+        }
+
+        pthread_barrier_wait(&state->barrier);
+
+        if (threadIndex == 0)
+        {
+            advanceLevel(state);
+        }
+
+        pthread_barrier_wait(&state->barrier);
+    }
+
+    return NULL;
+}
+
+/*
+ * @brief Multithreaded level synchronous bfs
+ * 
+ * Every level is expanded by all threads. Vertices
+ * are claimed with an atomic or on their word of the
+ * visited bitmap and collected in per thread buffers. The
+ * deterministic option orders each level exactly as
+ * the top-down bfs would
+ * 
+ * @param Graph (pointer*)
+ * @param TraversalOptions (pointer*)
+ * @param Bitmap (pointer*) => visited, all clear on entry
+ * @param VertexId pointer [array] (traversal path, room for every node)
+ * @param size_t (pointer*) => receives number of edges examined
+ * @return unsigned int (traversal length)
+ * 
+ */
+unsigned int parallelTraversal
+(
+    const Graph *graph,
+    const TraversalOptions *options,
+    Bitmap *visited,
+    VertexId *traversalPath,
+    size_t *edgesExamined
+)
+{
+    *edgesExamined = 0;
+
+    if (graph->noOfNodes == 0)
+    {
+        return 0;
+    }
+
+    ParallelState state;
+    state.graph = graph;
+    state.visited = visited;
+    state.traversalPath = traversalPath;
+    state.discoveryKeys = NULL;
+    state.noOfThreads = resolveThreadCount(options->noOfThreads);
+    state.deterministic = options->deterministic;
+    state.nextChunk = 0;
+    state.finished = false;
+    state.profile = options->profile;
+    state.visitor = options->visitor;
+    state.level = 0;
+
+    state.localFrontiers = (LocalFrontier *)calloc(state.noOfThreads, sizeof(LocalFrontier));
+    pthread_t *threads = (pthread_t *)malloc(state.noOfThreads * sizeof(pthread_t));
+    WorkerArgument *workerArguments = (WorkerArgument *)malloc
+    (
+        state.noOfThreads * sizeof(WorkerArgument)
+    );
+
+    if (state.localFrontiers == NULL || threads == NULL || workerArguments == NULL)
+    {
+        perror("Failed to allocate memory\n");
+        exit(EXIT_FAILURE);
+    }
+
+    if (state.deterministic)
+    {
+        state.discoveryKeys = (uint64_t *)malloc(graph->noOfNodes * sizeof(uint64_t));
+
+        if (state.discoveryKeys == NULL)
+        {
+            perror("Failed to allocate memory\n");
+            exit(EXIT_FAILURE);
+        }
+
+        for (size_t index = 0; index < graph->noOfNodes; index++)
+        {
+            state.discoveryKeys[index] = UNSET_KEY;
+        }
+    }
+
+    // traversal starts from the first node in the node list
+    traversalPath[0] = getListedVertex(graph, 0);
+    setBit(visited, traversalPath[0]);
+    state.levelStart = 0;
+    state.levelEnd = 1;
+
+    pthread_barrier_init(&state.barrier, NULL, state.noOfThreads);
+
+    // the calling thread works as thread 0
+    for (unsigned int thread = 0; thread < state.noOfThreads; thread++)
+    {
+        workerArguments[thread].state = &state;
+        workerArguments[thread].threadIndex = thread;
+    }
+
+    startWorkers(&state.launch, threads, state.noOfThreads, bfsWorker, workerArguments, sizeof(WorkerArgument));
+
+    // written once every thread exists, so a failed launch prints nothing
+    PROFILE_LEVEL(state.profile, 1, 0, 1, false);
+    visitLevel(state.visitor, traversalPath, 0, 1, 0);
+
+    bfsWorker(&workerArguments[0]);
+    joinWorkers(&state.launch, threads, state.noOfThreads);
+
+    pthread_barrier_destroy(&state.barrier);
+
+    for (unsigned int thread = 0; thread < state.noOfThreads; thread++)
+    {
+        *edgesExamined += state.localFrontiers[thread].edgesExamined;
+        free(state.localFrontiers[thread].vertices);
+    }
+
+    PROFILE_FINISH(state.profile, *edgesExamined, state.levelEnd);
+
+    free(state.localFrontiers);
+    free(state.discoveryKeys);
+    free(threads);
+    free(workerArguments);
+
+    return state.levelEnd;
+}
@@ -0,0 +1,979 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <limits.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include "queryServer.h"
+#include "bitmap.h"
+#include "graphUpdates.h"
+#include "reorder.h"
+#include "shortestPath.h"
+#include "simplifyGraph.h"
+#include "vertexDictionary.h"
+#include "types.h"
+
+/*
+ * @brief Query scratch data structure
+ *
+ * QueryScratch struct is allocated once when the
+ * server starts and reused by every request
+ *
+ * @member Bitmap (visited) => clear between requests
+ * @member VertexId pointer [array] (traversal path) => path, doubling as the queue
+ * @member VertexId pointer [array] (unreachable nodes) => nodes the last request missed
+ * @member PathSearch (path search) => scratch of the bidirectional bfs
+ * @member UpdateBatch (pending updates) => edge updates not merged into the graph yet
+ * @member IncrementalBfs (watched) => distances kept up to date across updates
+ * @member bool (watching) => set once watched holds distances
+ *
+ */
+typedef struct QueryScratch {
+    Bitmap visited;
+    VertexId *traversalPath;
+    VertexId *unReachableNodes;
+    PathSearch pathSearch;
+    UpdateBatch pendingUpdates;
+    IncrementalBfs watched;
+    bool watching;
+} QueryScratch;
+
+/*
+ * @brief Request outcome
+ *
+ * Tells the serving loop what to do after a request
+ *
+ * @value KEEP_SERVING => wait for the next request
+ * @value CLOSE_SESSION => stop reading from this client
+ * @value STOP_SERVER => stop reading and stop accepting clients
+ *
+ */
+typedef enum RequestOutcome {
+    KEEP_SERVING,
+    CLOSE_SESSION,
+    STOP_SERVER
+} RequestOutcome;
+
+/*
+ * @brief declarations for internal functions
+ *
+ * List of static functions local to this file
+ * Meant to be used in this file only
+ *
+ * @note all internal functions are static
+ */
+static void initQueryScratch(QueryScratch *scratch, Graph *graph);
+static void freeQueryScratch(QueryScratch *scratch);
+static unsigned int runQuery
+(
+    const Graph *graph,
+    QueryScratch *scratch,
+    VertexId source,
+    unsigned int maxDepth
+);
+static unsigned int collectUnreachable(const Graph *graph, QueryScratch *scratch);
+static void resetVisited(QueryScratch *scratch, unsigned int traversalLength);
+static void writeVertexList
+(
+    FILE *output,
+    const VertexDictionary *dictionary,
+    const char *label,
+    const char *separator,
+    const VertexId *vertices,
+    unsigned int length
+);
+static void answerPathRequest
+(
+    const Graph *graph,
+    QueryScratch *scratch,
+    char **state,
+    FILE *output
+);
+static VertexId readVertex(const Graph *graph, char **state, const char **name);
+static void queueUpdateRequest
+(
+    const Graph *graph,
+    QueryScratch *scratch,
+    bool removal,
+    char **state,
+    FILE *output
+);
+static size_t commitUpdates(Graph *graph, QueryScratch *scratch);
+static void answerCommitRequest(Graph *graph, QueryScratch *scratch, FILE *output);
+static void answerWatchRequest(Graph *graph, QueryScratch *scratch, char **state, FILE *output);
+static void answerLevelRequest(Graph *graph, QueryScratch *scratch, char **state, FILE *output);
+static void answerEdgeRequest(Graph *graph, QueryScratch *scratch, char **state, FILE *output);
+static RequestOutcome handleRequest
+(
+    Graph *graph,
+    QueryScratch *scratch,
+    char *line,
+    FILE *output
+);
+static RequestOutcome serveSession
+(
+    Graph *graph,
+    QueryScratch *scratch,
+    FILE *input,
+    FILE *output
+);
+static void removeStaleSocket(const char *socketPath);
+
+/*
+ * @brief Initialize query scratch
+ *
+ * @param QueryScratch (pointer*)
+ * @param Graph (pointer*)
+ * @return void
+ *
+ */
+static void initQueryScratch(QueryScratch *scratch, Graph *graph)
+{
+    unsigned int noOfNodes = graph->noOfNodes;
+
+    initBitmap(&scratch->visited, noOfNodes);
+    scratch->traversalPath = (VertexId *)malloc((noOfNodes + 1) * sizeof(VertexId));
+    scratch->unReachableNodes = (VertexId *)malloc((noOfNodes + 1) * sizeof(VertexId));
+
+    if (scratch->traversalPath == NULL || scratch->unReachableNodes == NULL)
+    {
+        perror("Failed to allocate memory\n");
+        exit(EXIT_FAILURE);
+    }
+
+    initPathSearch(&scratch->pathSearch, graph);
+    initUpdateBatch(&scratch->pendingUpdates);
+    scratch->watching = false;
+}
+
+/*
+ * @brief Free query scratch
+ *
+ * @param QueryScratch (pointer*)
+ * @return void
+ *
+ */
+static void freeQueryScratch(QueryScratch *scratch)
+{
+    freeBitmap(&scratch->visited);
+    free(scratch->traversalPath);
+    free(scratch->unReachableNodes);
+    freePathSearch(&scratch->pathSearch);
+    freeUpdateBatch(&scratch->pendingUpdates);
+
+    if (scratch->watching)
+    {
+        freeIncrementalBfs(&scratch->watched);
+    }
+}
+
+/*
+ * @brief Depth limited top-down traversal
+ *
+ * Expands the path level by level, so the path
+ * doubles as the queue and the order matches the
+ * classic queue based bfs
+ *
+ * @param Graph (pointer*)
+ * @param QueryScratch (pointer*)
+ * @param VertexId (source)
+ * @param unsigned int (maximum depth, UINT_MAX for none)
+ * @return unsigned int (traversal length)
+ *
+ */
+static unsigned int runQuery
+(
+    const Graph *graph,
+    QueryScratch *scratch,
+    VertexId source,
+    unsigned int maxDepth
+)
+{
+    VertexId *traversalPath = scratch->traversalPath;
+    unsigned int levelStart = 0;
+    unsigned int levelEnd = 1;
+
+    traversalPath[0] = source;
+    setBit(&scratch->visited, source);
+
+    for (unsigned int depth = 0; depth < maxDepth && levelStart < levelEnd; depth++)
+    {
+        unsigned int pathLength = levelEnd;
+
+        for (unsigned int index = levelStart; index < levelEnd; index++)
+        {
+            VertexId vertex = traversalPath[index];
+
+            for (size_t edge = graph->edgeOffsets[vertex]; edge < graph->edgeOffsets[vertex + 1]; edge++)
+            {
+                VertexId adjacentNode = graph->adjacentNodes[edge];
+
+                if (!testBit(&scratch->visited, adjacentNode))
+                {
+                    setBit(&scratch->visited, adjacentNode);
+                    traversalPath[pathLength++] = adjacentNode;
+                }
+            }
+        }
+
+        levelStart = levelEnd;
+        levelEnd = pathLength;
+    }
+
+    return levelEnd;
+}
+
+/*
+ * @brief Collect nodes the last request missed
+ *
+ * A reordered graph is walked in node list order
+ *
+ * @param Graph (pointer*)
+ * @param QueryScratch (pointer*)
+ * @return unsigned int (number of unreachable nodes)
+ *
+ */
+static unsigned int collectUnreachable(const Graph *graph, QueryScratch *scratch)
+{
+    unsigned int unReachableLength = 0;
+
+    if (graph->vertexOrder != NULL)
+    {
+        for (VertexId position = 0; position < graph->noOfNodes; position++)
+        {
+            VertexId vertex = getListedVertex(graph, position);
+
+            if (!testBit(&scratch->visited, vertex))
+            {
+                scratch->unReachableNodes[unReachableLength++] = vertex;
+            }
+        }
+
+        return unReachableLength;
+    }
+
+    return (unsigned int)collectClearBits(&scratch->visited, scratch->unReachableNodes);
+}
+
+/*
+ * @brief Clear visited marks of the last request
+ *
+ * Only the bits of the path are cleared, so the
+ * cost follows the traversal, not the graph size
+ *
+ * @param QueryScratch (pointer*)
+ * @param unsigned int (traversal length)
+ * @return void
+ *
+ */
+static void resetVisited(QueryScratch *scratch, unsigned int traversalLength)
+{
+    for (unsigned int index = 0; index < traversalLength; index++)
+    {
+        clearBit(&scratch->visited, scratch->traversalPath[index]);
+    }
+}
+
+/*
+ * @brief Write a labelled list of node names
+ *
+ * @param FILE (pointer*) => output stream
+ * @param VertexDictionary (pointer*)
+ * @param char pointer [array] (label)
+ * @param char pointer [array] (separator)
+ * @param VertexId pointer [array] (vertices)
+ * @param unsigned int (length)
+ * @return void
+ *
+ */
+static void writeVertexList
+(
+    FILE *output,
+    const VertexDictionary *dictionary,
+    const char *label,
+    const char *separator,
+    const VertexId *vertices,
+    unsigned int length
+)
+{
+    fputs(label, output);
+
+    for (unsigned int index = 0; index < length; index++)
+    {
+        if (index > 0)
+        {
+            fputs(separator, output);
+        }
+
+        fputs(getVertexName(dictionary, vertices[index]), output);
+    }
+
+    if (length == 0)
+    {
+        fputs("None", output);
+    }
+
+    fputc('\n', output);
+}
+
+/*
+ * @brief Answer a shortest path request
+ *
+ * @param Graph (pointer*)
+ * @param QueryScratch (pointer*)
+ * @param char pointer (pointer*) => tokenizer state after the command
+ * @param FILE (pointer*) => output stream
+ * @return void
+ *
+ */
+static void answerPathRequest
+(
+    const Graph *graph,
+    QueryScratch *scratch,
+    char **state,
+    FILE *output
+)
+{
+    char *startName = strtok_r(NULL, " \t\r\n", state);
+    char *goalName = strtok_r(NULL, " \t\r\n", state);
+
+    if (goalName == NULL || strtok_r(NULL, " \t\r\n", state) != NULL)
+    {
+        fprintf(output, "ERROR usage: path START GOAL\n");
+        return;
+    }
+
+    VertexId start = findVertexId(&graph->dictionary, startName, strlen(startName));
+    VertexId goal = findVertexId(&graph->dictionary, goalName, strlen(goalName));
+
+    if (start == INVALID_VERTEX || goal == INVALID_VERTEX)
+    {
+        fprintf(output, "ERROR unknown node %s\n", start == INVALID_VERTEX ? startName : goalName);
+        return;
+    }
+
+    unsigned int pathLength = findShortestPath(&scratch->pathSearch, start, goal, scratch->traversalPath);
+
+    writeVertexList
+    (
+        output, &graph->dictionary, "Shortest Path: ", " -> ", scratch->traversalPath, pathLength
+    );
+}
+
+/*
+ * @brief Read a node name token and look it up
+ *
+ * @param Graph (pointer*)
+ * @param char pointer (pointer*) => tokenizer state
+ * @param char pointer (pointer*) => set to the token, NULL if the line ended
+ * @return VertexId (INVALID_VERTEX if missing or unknown)
+ *
+ */
+static VertexId readVertex(const Graph *graph, char **state, const char **name)
+{
+    char *token = strtok_r(NULL, " \t\r\n", state);
+
+    *name = token;
+
+    if (token == NULL)
+    {
+        return INVALID_VERTEX;
+    }
+
+    return findVertexId(&graph->dictionary, token, strlen(token));
+}
+
+/*
+ * @brief Queue an edge insertion or removal request
+ *
+ * The update waits in the pending batch until a
+ * commit or the next request that reads the graph
+ *
+ * @param Graph (pointer*)
+ * @param QueryScratch (pointer*)
+ * @param bool (removal) => remove FROM TO instead of add FROM TO WEIGHT
+ * @param char pointer (pointer*) => tokenizer state after the command
+ * @param FILE (pointer*) => output stream
+ * @return void
+ *
+ */
+static void queueUpdateRequest
+(
+    const Graph *graph,
+    QueryScratch *scratch,
+    bool removal,
+    char **state,
+    FILE *output
+)
+{
+    const char *fromName, *toName;
+    VertexId from = readVertex(graph, state, &fromName);
+    VertexId to = readVertex(graph, state, &toName);
+    char *weightText = removal ? NULL : strtok_r(NULL, " \t\r\n", state);
+
+    if (toName == NULL || (!removal && weightText == NULL) || strtok_r(NULL, " \t\r\n", state) != NULL)
+    {
+        fprintf(output, removal ? "ERROR usage: remove FROM TO\n" : "ERROR usage: add FROM TO WEIGHT\n");
+        return;
+    }
+
+    if (from == INVALID_VERTEX || to == INVALID_VERTEX)
+    {
+        fprintf(output, "ERROR unknown node %s\n", from == INVALID_VERTEX ? fromName : toName);
+        return;
+    }
+
+    if (removal)
+    {
+        queueEdgeRemoval(&scratch->pendingUpdates, from, to);
+    }
+    else
+    {
+        char *end;
+        unsigned long weight = strtoul(weightText, &end, 10);
+
+        if (*end != '\0' || weightText[0] == '-' || weight > UINT_MAX)
+        {
+            fprintf(output, "ERROR invalid weight %s\n", weightText);
+            return;
+        }
+
+        queueEdgeInsertion(&scratch->pendingUpdates, from, to, (unsigned int)weight);
+    }
+
+    fprintf(output, "Queued: %zu\n", scratch->pendingUpdates.length);
+}
+
+/*
+ * @brief Merge the pending updates into the graph
+ *
+ * Watched distances are repaired along the way.
+ * The path search is set up again because the
+ * arrays it points at were replaced
+ *
+ * @param Graph (pointer*)
+ * @param QueryScratch (pointer*)
+ * @return size_t (number of updates merged)
+ *
+ */
+static size_t commitUpdates(Graph *graph, QueryScratch *scratch)
+{
+    size_t noOfUpdates = scratch->pendingUpdates.length;
+
+    if (noOfUpdates == 0)
+    {
+        return 0;
+    }
+
+    applyUpdateBatch(graph, &scratch->pendingUpdates, scratch->watching ? &scratch->watched : NULL);
+
+    freePathSearch(&scratch->pathSearch);
+    initPathSearch(&scratch->pathSearch, graph);
+
+    return noOfUpdates;
+}
+
+/*
+ * @brief Answer a commit request
+ *
+ * @param Graph (pointer*)
+ * @param QueryScratch (pointer*)
+ * @param FILE (pointer*) => output stream
+ * @return void
+ *
+ */
+static void answerCommitRequest(Graph *graph, QueryScratch *scratch, FILE *output)
+{
+    size_t noOfUpdates = commitUpdates(graph, scratch);
+
+    fprintf(output, "Committed: %zu updates, %zu edges", noOfUpdates, graph->noOfEdges);
+
+    if (scratch->watching)
+    {
+        fprintf(output, ", %zu levels changed", noOfUpdates == 0 ? 0 : scratch->watched.distancesChanged);
+    }
+
+    fputc('\n', output);
+}
+
+/*
+ * @brief Answer a watch request
+ *
+ * Starts keeping the levels from SOURCE up to
+ * date, replacing the source watched before
+ *
+ * @param Graph (pointer*)
+ * @param QueryScratch (pointer*)
+ * @param char pointer (pointer*) => tokenizer state after the command
+ * @param FILE (pointer*) => output stream
+ * @return void
+ *
+ */
+static void answerWatchRequest(Graph *graph, QueryScratch *scratch, char **state, FILE *output)
+{
+    const char *sourceName;
+    VertexId source = readVertex(graph, state, &sourceName);
+
+    if (sourceName == NULL || strtok_r(NULL, " \t\r\n", state) != NULL)
+    {
+        fprintf(output, "ERROR usage: watch SOURCE\n");
+        return;
+    }
+
+    if (source == INVALID_VERTEX)
+    {
+        fprintf(output, "ERROR unknown source %s\n", sourceName);
+        return;
+    }
+
+    commitUpdates(graph, scratch);
+
+    if (scratch->watching)
+    {
+        freeIncrementalBfs(&scratch->watched);
+    }
+
+    initIncrementalBfs(&scratch->watched, graph, source);
+    scratch->watching = true;
+
+    fprintf(output, "Watching: %s, %u reached\n", sourceName, scratch->watched.traversalLength);
+}
+
+/*
+ * @brief Answer a level request
+ *
+ * Levels count hops from the watched source,
+ * the first node of the node list unless a watch
+ * request picked another one
+ *
+ * @param Graph (pointer*)
+ * @param QueryScratch (pointer*)
+ * @param char pointer (pointer*) => tokenizer state after the command
+ * @param FILE (pointer*) => output stream
+ * @return void
+ *
+ */
+static void answerLevelRequest(Graph *graph, QueryScratch *scratch, char **state, FILE *output)
+{
+    const char *nodeName;
+    VertexId node = readVertex(graph, state, &nodeName);
+
+    if (nodeName == NULL || strtok_r(NULL, " \t\r\n", state) != NULL)
+    {
+        fprintf(output, "ERROR usage: level NODE\n");
+        return;
+    }
+
+    if (node == INVALID_VERTEX)
+    {
+        fprintf(output, "ERROR unknown node %s\n", nodeName);
+        return;
+    }
+
+    commitUpdates(graph, scratch);
+
+    if (!scratch->watching)
+    {
+        initIncrementalBfs(&scratch->watched, graph, getListedVertex(graph, 0));
+        scratch->watching = true;
+    }
+
+    if (scratch->watched.distances[node] == UNREACHED_DISTANCE)
+    {
+        fprintf(output, "Level: Unreachable\n");
+        return;
+    }
+
+    fprintf(output, "Level: %u\n", scratch->watched.distances[node]);
+}
+
+/*
+ * @brief Answer an edge request
+ *
+ * Replies with the weight of the edge from FROM
+ * to TO, found with a binary search once the
+ * graph is simplified
+ *
+ * @param Graph (pointer*)
+ * @param QueryScratch (pointer*)
+ * @param char pointer (pointer*) => tokenizer state after the command
+ * @param FILE (pointer*) => output stream
+ * @return void
+ *
+ */
+static void answerEdgeRequest(Graph *graph, QueryScratch *scratch, char **state, FILE *output)
+{
+    const char *fromName, *toName;
+    VertexId from = readVertex(graph, state, &fromName);
+    VertexId to = readVertex(graph, state, &toName);
+
+    if (toName == NULL || strtok_r(NULL, " \t\r\n", state) != NULL)
+    {
+        fprintf(output, "ERROR usage: edge FROM TO\n");
+        return;
+    }
+
+    if (from == INVALID_VERTEX || to == INVALID_VERTEX)
+    {
+        fprintf(output, "ERROR unknown node %s\n", from == INVALID_VERTEX ? fromName : toName);
+        return;
+    }
+
+    commitUpdates(graph, scratch);
+
+    unsigned int weight;
+
+    if (!hasEdge(graph, from, to, &weight))
+    {
+        fprintf(output, "Edge: None\n");
+        return;
+    }
+
+    fprintf(output, "Edge: %u\n", weight);
+}
+
+/*
+ * @brief Answer one request line
+ *
+ * Requests are
+ *   bfs SOURCE [DEPTH] => path and unreachable nodes, two lines
+ *   path START GOAL    => shortest hop path, one line
+ *   add FROM TO WEIGHT => queue an edge insertion, one line
+ *   remove FROM TO     => queue an edge removal, one line
+ *   commit             => merge the queued updates, one line
+ *   watch SOURCE       => keep levels from SOURCE up to date, one line
+ *   level NODE         => hops from the watched source, one line
+ *   edge FROM TO       => weight of the edge, one line
+ *   quit               => end this session
+ *   shutdown           => end this session and stop the server
+ * Anything else gets a single ERROR line. Queued
+ * updates are committed before any request that
+ * reads the graph
+ *
+ * @param Graph (pointer*)
+ * @param QueryScratch (pointer*)
+ * @param char pointer [array] (line, tokenized in place)
+ * @param FILE (pointer*) => output stream
+ * @return RequestOutcome
+ *
+ */
+static RequestOutcome handleRequest
+(
+    Graph *graph,
+    QueryScratch *scratch,
+    char *line,
+    FILE *output
+)
+{
+    char *state;
+    char *command = strtok_r(line, " \t\r\n", &state);
+
+    if (command == NULL)
+    {
+        return KEEP_SERVING; // blank line
+    }
+
+    if (strcmp(command, "quit") == 0)
+    {
+        return CLOSE_SESSION;
+    }
+
+    if (strcmp(command, "shutdown") == 0)
+    {
+        return STOP_SERVER;
+    }
+
+    if (strcmp(command, "add") == 0 || strcmp(command, "remove") == 0)
+    {
+        queueUpdateRequest(graph, scratch, command[0] == 'r', &state, output);
+        return KEEP_SERVING;
+    }
+
+    if (strcmp(command, "commit") == 0)
+    {
+        answerCommitRequest(graph, scratch, output);
+        return KEEP_SERVING;
+    }
+
+    if (strcmp(command, "watch") == 0)
+    {
+        answerWatchRequest(graph, scratch, &state, output);
+        return KEEP_SERVING;
+    }
+
+    if (strcmp(command, "level") == 0)
+    {
+        answerLevelRequest(graph, scratch, &state, output);
+        return KEEP_SERVING;
+    }
+
+    if (strcmp(command, "edge") == 0)
+    {
+        answerEdgeRequest(graph, scratch, &state, output);
+        return KEEP_SERVING;
+    }
+
+    if (strcmp(command, "path") == 0)
+    {
+        commitUpdates(graph, scratch);
+        answerPathRequest(graph, scratch, &state, output);
+        return KEEP_SERVING;
+    }
+
+    if (strcmp(command, "bfs") != 0)
+    {
+        fprintf(output, "ERROR unknown command %s\n", command);
+        return KEEP_SERVING;
+    }
+
+    char *sourceName = strtok_r(NULL, " \t\r\n", &state);
+    char *depthText = strtok_r(NULL, " \t\r\n", &state);
+    unsigned int maxDepth = UINT_MAX;
+
+    if (sourceName == NULL || strtok_r(NULL, " \t\r\n", &state) != NULL)
+    {
+        fprintf(output, "ERROR usage: bfs SOURCE [DEPTH]\n");
+        return KEEP_SERVING;
+    }
+
+    if (depthText != NULL)
+    {
+        char *end;
+        unsigned long depth = strtoul(depthText, &end, 10);
+
+        if (*end != '\0' || depthText[0] == '-' || depth > UINT_MAX)
+        {
+            fprintf(output, "ERROR invalid depth %s\n", depthText);
+            return KEEP_SERVING;
+        }
+
+        maxDepth = (unsigned int)depth;
+    }
+
+    VertexId source = findVertexId(&graph->dictionary, sourceName, strlen(sourceName));
+
+    if (source == INVALID_VERTEX)
+    {
+        fprintf(output, "ERROR unknown source %s\n", sourceName);
+        return KEEP_SERVING;
+    }
+
+    commitUpdates(graph, scratch);
+
+    unsigned int traversalLength = runQuery(graph, scratch, source, maxDepth);
+    unsigned int unReachableLength = collectUnreachable(graph, scratch);
+
+    writeVertexList
+    (
+        output, &graph->dictionary, "BFS Traversal Path: ", " -> ",
+        scratch->traversalPath, traversalLength
+    );
+    writeVertexList
+    (
+        output, &graph->dictionary, "Unreachable Nodes: ", ", ",
+        scratch->unReachableNodes, unReachableLength
+    );
+
+    resetVisited(scratch, traversalLength);
+
+    return KEEP_SERVING;
+}
+
+/*
+ * @brief Serve requests from one stream until it ends
+ *
+ * @param Graph (pointer*)
+ * @param QueryScratch (pointer*)
+ * @param FILE (pointer*) => input stream
+ * @param FILE (pointer*) => output stream
+ * @return RequestOutcome (how the session ended)
+ *
+ */
+static RequestOutcome serveSession
+(
+    Graph *graph,
+    QueryScratch *scratch,
+    FILE *input,
+    FILE *output
+)
+{
+    char *line = NULL;
+    size_t lineCapacity = 0;
+    RequestOutcome outcome = KEEP_SERVING;
+
+    while (outcome == KEEP_SERVING && getline(&line, &lineCapacity, input) != -1)
+    {
+        outcome = handleRequest(graph, scratch, line, output);
+        fflush(output); // the client waits for the whole reply
+    }
+
+    free(line);
+
+    return outcome;
+}
+
+/*
+ * @brief Remove a socket left behind at a path
+ *
+ * Only a socket is removed. Anything else at the
+ * path is left alone and the server does not start
+ *
+ * @param char pointer [array] (socket path)
+ * @return void
+ *
+ * @note Exits if the path is taken by something other than a socket
+ *
+ */
+static void removeStaleSocket(const char *socketPath)
+{
+    struct stat status;
+
+    if (lstat(socketPath, &status) == -1)
+    {
+        if (errno == ENOENT)
+        {
+            return;
+        }
+
+        perror("Failed to inspect socket path\n");
+        exit(EXIT_FAILURE);
+    }
+
+    if (!S_ISSOCK(status.st_mode))
+    {
+        fprintf(stderr, "%s: path is in use and is not a socket\n", socketPath);
+        exit(EXIT_FAILURE);
+    }
+
+    unlink(socketPath);
+}
+
+/*
+ * @brief Serve requests from a stream
+ *
+ * Answers line based requests until the input
+ * ends or a quit request arrives
+ *
+ * @param Graph (pointer*)
+ * @param FILE (pointer*) => input stream
+ * @param FILE (pointer*) => output stream
+ * @return void
+ *
+ */
+void serveQueries(Graph *graph, FILE *input, FILE *output)
+{
+    QueryScratch scratch;
+    initQueryScratch(&scratch, graph);
+
+    serveSession(graph, &scratch, input, output);
+
+    freeQueryScratch(&scratch);
+}
+
+/*
+ * @brief Serve requests on a unix domain socket
+ *
+ * Accepts one client at a time and answers its
+ * line based requests until it disconnects. Runs
+ * until a client sends shutdown
+ *
+ * @param Graph (pointer*)
+ * @param char pointer [array] (socket path, a stale socket there is replaced)
+ * @return void
+ *
+ * @note Exits if the path is taken by something other than a socket
+ *
+ */
+void serveUnixSocket(Graph *graph, const char *socketPath)
+{
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+
+    if (strlen(socketPath) >= sizeof(address.sun_path))
+    {
+        fprintf(stderr, "%s: socket path is too long\n", socketPath);
+        exit(EXIT_FAILURE);
+    }
+
+    strcpy(address.sun_path, socketPath);
+    removeStaleSocket(socketPath);
+
+    int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener == -1)
+    {
+        perror("Failed to create socket\n");
+        exit(EXIT_FAILURE);
+    }
+
+    struct stat bound;
+
+    if
+    (
+        bind(listener, (struct sockaddr *)&address, sizeof(address)) == -1 ||
+        listen(listener, 16) == -1 || lstat(socketPath, &bound) == -1
+    )
+    {
+        perror("Failed to bind socket\n");
+        exit(EXIT_FAILURE);
+    }
+
+    // a client hanging up mid reply must not end the server
+    signal(SIGPIPE, SIG_IGN);
+
+    QueryScratch scratch;
+    initQueryScratch(&scratch, graph);
+
+    RequestOutcome outcome = KEEP_SERVING;
+
+    while (outcome != STOP_SERVER)
+    {
+        int connection = accept(listener, NULL, NULL);
+        if (connection == -1)
+        {
+            if (errno == EINTR || errno == ECONNABORTED)
+            {
+                continue;
+            }
+
+            perror("Failed to accept connection\n");
+            exit(EXIT_FAILURE);
+        }
+
+        FILE *input = fdopen(connection, "r");
+        FILE *output = fdopen(dup(connection), "w");
+
+        if (input == NULL || output == NULL)
+        {
+            perror("Failed to open connection\n");
+            exit(EXIT_FAILURE);
+        }
+
+        outcome = serveSession(graph, &scratch, input, output);
+
+        fclose(input);
+        fclose(output);
+    }
+
+    freeQueryScratch(&scratch);
+
+    close(listener);
+
+    // only remove the socket this server bound, not whatever took its place
+    struct stat status;
+
+    if
+    (
+        lstat(socketPath, &status) == 0 && S_ISSOCK(status.st_mode) &&
+        status.st_dev == bound.st_dev && status.st_ino == bound.st_ino
+    )
+    {
+        unlink(socketPath);
+    }
+}
@@ -0,0 +1,468 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "reorder.h"
+#include "arena.h"
+#include "bitmap.h"
+#include "graphBuilder.h"
+#include "types.h"
+
+/*
+ * @brief declarations for internal functions
+ *
+ * List of static functions local to this file
+ * Meant to be used in this file only
+ *
+ * @note all internal functions are static
+ */
+static size_t getDegree(const Graph *graph, VertexId vertex);
+static void sortByDegree(const Graph *graph, bool descending, VertexId *sorted);
+static unsigned int orderComponent
+(
+    const Graph *graph,
+    VertexId start,
+    Bitmap *visited,
+    VertexId *order,
+    unsigned int orderLength,
+    uint64_t *keys
+);
+static void orderByBfs(const Graph *graph, bool cuthillMcKee, VertexId *order);
+static void permuteDictionary(Graph *graph, Arena *arena, const VertexId *order, const VertexId *newIds);
+
+/*
+ * @brief Get reorder method name
+ *
+ * @param ReorderMethod (method)
+ * @return char pointer [array]
+ *
+ */
+const char *getReorderMethodName(ReorderMethod method)
+{
+    switch (method)
+    {
+        case RCM_REORDER:
+            return "rcm";
+        case DEGREE_REORDER:
+            return "degree";
+        case BFS_REORDER:
+            return "bfs";
+        default:
+            return "none";
+    }
+}
+
+/*
+ * @brief Get the out degree of a vertex
+ *
+ * @param Graph (pointer*)
+ * @param VertexId (vertex)
+ * @return size_t
+ *
+ */
+static size_t getDegree(const Graph *graph, VertexId vertex)
+{
+    return graph->edgeOffsets[vertex + 1] - graph->edgeOffsets[vertex];
+}
+
+/*
+ * @brief Sort vertices by degree
+ *
+ * Counting sort, so ties keep their
+ * identifier order
+ *
+ * @param Graph (pointer*)
+ * @param bool (highest degree first)
+ * @param VertexId pointer [array] (sorted, room for every node)
+ * @return void
+ *
+ */
+static void sortByDegree(const Graph *graph, bool descending, VertexId *sorted)
+{
+    size_t maxDegree = 0;
+
+    for (VertexId vertex = 0; vertex < graph->noOfNodes; vertex++)
+    {
+        if (getDegree(graph, vertex) > maxDegree)
+        {
+            maxDegree = getDegree(graph, vertex);
+        }
+    }
+
+    size_t *starts = (size_t *)calloc(maxDegree + 2, sizeof(size_t));
+
+    if (starts == NULL)
+    {
+        perror("Failed to allocate memory\n");
+        exit(EXIT_FAILURE);
+    }
+
+    for (VertexId vertex = 0; vertex < graph->noOfNodes; vertex++)
+    {
+        size_t degree = getDegree(graph, vertex);
+        starts[(descending ? maxDegree - degree : degree) + 1]++;
+    }
+
+    for (size_t bucket = 1; bucket <= maxDegree + 1; bucket++)
+    {
+        starts[bucket] += starts[bucket - 1];
+    }
+
+    for (VertexId vertex = 0; vertex < graph->noOfNodes; vertex++)
+    {
+        size_t degree = getDegree(graph, vertex);
+        sorted[starts[descending ? maxDegree - degree : degree]++] = vertex;
+    }
+
+    free(starts);
+}
+
+/*
+ * @brief Append the vertices a bfs from one start reaches
+ *
+ * The order array doubles as the queue. In
+ * Cuthill-McKee order (keys given) the children
+ * of each vertex are sorted by ascending degree
+ *
+ * @param Graph (pointer*)
+ * @param VertexId (start, not visited yet)
+ * @param Bitmap (pointer*) => visited
+ * @param VertexId pointer [array] (order)
+ * @param unsigned int (vertices already in the order)
+ * @param uint64_t pointer [array] (sort keys, room for every node, NULL for plain bfs order)
+ * @return unsigned int (vertices in the order after the bfs)
+ *
+ */
+static unsigned int orderComponent
+(
+    const Graph *graph,
+    VertexId start,
+    Bitmap *visited,
+    VertexId *order,
+    unsigned int orderLength,
+    uint64_t *keys
+)
+{
+    unsigned int front = orderLength;
+
+    order[orderLength++] = start;
+    setBit(visited, start);
+
+    while (front < orderLength)
+    {
+        VertexId vertex = order[front++];
+        unsigned int childrenStart = orderLength;
+
+        for (size_t edge = graph->edgeOffsets[vertex]; edge < graph->edgeOffsets[vertex + 1]; edge++)
+        {
+            VertexId adjacentNode = graph->adjacentNodes[edge];
+
+            if (!testBit(visited, adjacentNode))
+            {
+                setBit(visited, adjacentNode);
+                order[orderLength++] = adjacentNode;
+            }
+        }
+
+        if (keys == NULL || orderLength - childrenStart < 2)
+        {
+            continue;
+        }
+
+        // degree in the high half, identifier in the low half breaks ties
+        unsigned int noOfChildren = orderLength - childrenStart;
+
+        for (unsigned int index = 0; index < noOfChildren; index++)
+        {
+            VertexId child = order[childrenStart + index];
+            size_t degree = getDegree(graph, child);
+
+            keys[index] = (degree < UINT32_MAX ? (uint64_t)degree : UINT32_MAX) << 32 | child;
+        }
+
+        qsort(keys, noOfChildren, sizeof(uint64_t), compareSortKeys);
+
+        for (unsigned int index = 0; index < noOfChildren; index++)
+        {
+            order[childrenStart + index] = (VertexId)keys[index];
+        }
+    }
+
+    return orderLength;
+}
+
+/*
+ * @brief Order vertices by bfs
+ *
+ * Plain bfs order starts from the first node and then
+ * from every vertex left, in node list order. Reverse
+ * Cuthill-McKee starts every component from its lowest
+ * degree vertex and reverses the result
+ *
+ * @param Graph (pointer*)
+ * @param bool (reverse Cuthill-McKee)
+ * @param VertexId pointer [array] (order, room for every node)
+ * @return void
+ *
+ */
+static void orderByBfs(const Graph *graph, bool cuthillMcKee, VertexId *order)
+{
+    unsigned int noOfNodes = graph->noOfNodes;
+    VertexId *starts = (VertexId *)malloc(noOfNodes * sizeof(VertexId));
+    uint64_t *keys = NULL;
+
+    if (starts == NULL)
+    {
+        perror("Failed to allocate memory\n");
+        exit(EXIT_FAILURE);
+    }
+
+    if (cuthillMcKee)
+    {
+        keys = (uint64_t *)malloc(noOfNodes * sizeof(uint64_t));
+
+        if (keys == NULL)
+        {
+            perror("Failed to allocate memory\n");
+            exit(EXIT_FAILURE);
+        }
+
+        sortByDegree(graph, false, starts);
+    }
+    else
+    {
+        for (VertexId position = 0; position < noOfNodes; position++)
+        {
+            starts[position] = getListedVertex(graph, position);
+        }
+    }
+
+    Bitmap visited;
+    initBitmap(&visited, noOfNodes);
+
+    unsigned int orderLength = 0;
+
+    for (VertexId index = 0; index < noOfNodes; index++)
+    {
+        if (!testBit(&visited, starts[index]))
+        {
+            orderLength = orderComponent(graph, starts[index], &visited, order, orderLength, keys);
+        }
+    }
+
+    if (cuthillMcKee)
+    {
+        for (VertexId index = 0; index < noOfNodes / 2; index++)
+        {
+            VertexId swap = order[index];
+            order[index] = order[noOfNodes - 1 - index];
+            order[noOfNodes - 1 - index] = swap;
+        }
+    }
+
+    freeBitmap(&visited);
+    free(starts);
+    free(keys);
+}
+
+/*
+ * @brief Compute a vertex order
+ *
+ * @param Graph (pointer*)
+ * @param ReorderMethod (method)
+ * @return VertexId pointer [array] (current identifier of every new identifier, release with free)
+ *
+ */
+VertexId *computeVertexOrder(const Graph *graph, ReorderMethod method)
+{
+    VertexId *order = (VertexId *)malloc((graph->noOfNodes + 1) * sizeof(VertexId));
+
+    if (order == NULL)
+    {
+        perror("Failed to allocate memory\n");
+        exit(EXIT_FAILURE);
+    }
+
+    switch (method)
+    {
+        case RCM_REORDER:
+            orderByBfs(graph, true, order);
+            break;
+        case DEGREE_REORDER:
+            sortByDegree(graph, true, order);
+            break;
+        case BFS_REORDER:
+            orderByBfs(graph, false, order);
+            break;
+        default:
+            for (VertexId vertex = 0; vertex < graph->noOfNodes; vertex++)
+            {
+                order[vertex] = vertex;
+            }
+            break;
+    }
+
+    return order;
+}
+
+/*
+ * @brief Move the dictionary over to the new identifiers
+ *
+ * A heap dictionary is rewritten in place. The arrays
+ * of a snapshot dictionary are read only, so new ones
+ * are taken from the arena. The name pool never moves
+ *
+ * @param Graph (pointer*)
+ * @param Arena (pointer*) => arena of the reordered graph
+ * @param VertexId pointer [array] (old identifier of every new identifier)
+ * @param VertexId pointer [array] (new identifier of every old identifier)
+ * @return void
+ *
+ */
+static void permuteDictionary(Graph *graph, Arena *arena, const VertexId *order, const VertexId *newIds)
+{
+    VertexDictionary *dictionary = &graph->dictionary;
+    size_t *oldOffsets = dictionary->nameOffsets;
+    VertexId *slots = dictionary->slots;
+
+    if (graph->snapshotMapping != NULL)
+    {
+        dictionary->nameOffsets = (size_t *)arenaAllocate(arena, graph->noOfNodes * sizeof(size_t));
+        dictionary->slots = (VertexId *)arenaAllocate(arena, dictionary->slotCount * sizeof(VertexId));
+    }
+    else
+    {
+        oldOffsets = (size_t *)malloc(graph->noOfNodes * sizeof(size_t));
+
+        if (oldOffsets == NULL)
+        {
+            perror("Failed to allocate memory\n");
+            exit(EXIT_FAILURE);
+        }
+
+        for (VertexId vertex = 0; vertex < graph->noOfNodes; vertex++)
+        {
+            oldOffsets[vertex] = dictionary->nameOffsets[vertex];
+        }
+    }
+
+    for (VertexId vertex = 0; vertex < graph->noOfNodes; vertex++)
+    {
+        dictionary->nameOffsets[vertex] = oldOffsets[order[vertex]];
+    }
+
+    for (size_t slot = 0; slot < dictionary->slotCount; slot++)
+    {
+        dictionary->slots[slot] = slots[slot] == INVALID_VERTEX ? INVALID_VERTEX : newIds[slots[slot]];
+    }
+
+    if (graph->snapshotMapping == NULL)
+    {
+        free(oldOffsets);
+    }
+}
+
+/*
+ * @brief Relabel the vertices of a graph
+ *
+ * Rebuilds the adjacency in the new order into a
+ * fresh arena and releases the old one. Rows keep
+ * their edge order, so a top-down bfs prints the
+ * same path as before. The dictionary follows the
+ * new identifiers, and vertexOrder keeps where every
+ * node of the node list went
+ *
+ * @param Graph (pointer*)
+ * @param ReorderMethod (method)
+ * @return void
+ *
+ * @note The incoming arrays are dropped and
+ *       rebuilt on the next traversal that needs them
+ *
+ */
+void reorderGraph(Graph *graph, ReorderMethod method)
+{
+    unsigned int noOfNodes = graph->noOfNodes;
+
+    if (method == NO_REORDER || noOfNodes == 0)
+    {
+        return;
+    }
+
+    VertexId *order = computeVertexOrder(graph, method);
+    VertexId *newIds = (VertexId *)malloc(noOfNodes * sizeof(VertexId));
+
+    if (newIds == NULL)
+    {
+        perror("Failed to allocate memory\n");
+        exit(EXIT_FAILURE);
+    }
+
+    for (VertexId vertex = 0; vertex < noOfNodes; vertex++)
+    {
+        newIds[order[vertex]] = vertex;
+    }
+
+    Arena arena;
+    initArena(&arena);
+
+    size_t *edgeOffsets = (size_t *)arenaAllocate(&arena, (noOfNodes + 1) * sizeof(size_t));
+    VertexId *adjacentNodes = (VertexId *)arenaAllocate(&arena, (graph->noOfEdges + 1) * sizeof(VertexId));
+    unsigned int *edgeWeights = (unsigned int *)arenaAllocate
+    (
+        &arena, (graph->noOfEdges + 1) * sizeof(unsigned int)
+    );
+    VertexId *vertexOrder = (VertexId *)arenaAllocate(&arena, noOfNodes * sizeof(VertexId));
+
+    size_t edge = 0;
+
+    for (VertexId vertex = 0; vertex < noOfNodes; vertex++)
+    {
+        edgeOffsets[vertex] = edge;
+
+        for (size_t oldEdge = graph->edgeOffsets[order[vertex]]; oldEdge < graph->edgeOffsets[order[vertex] + 1]; oldEdge++)
+        {
+            adjacentNodes[edge] = newIds[graph->adjacentNodes[oldEdge]];
+            edgeWeights[edge] = graph->edgeWeights[oldEdge];
+            edge++;
+        }
+    }
+
+    edgeOffsets[noOfNodes] = edge;
+
+    for (VertexId position = 0; position < noOfNodes; position++)
+    {
+        vertexOrder[position] = newIds[getListedVertex(graph, position)];
+    }
+
+    permuteDictionary(graph, &arena, order, newIds);
+
+    freeArena(&graph->arena);
+    graph->arena = arena;
+
+    graph->edgeOffsets = edgeOffsets;
+    graph->adjacentNodes = adjacentNodes;
+    graph->edgeWeights = edgeWeights;
+    graph->incomingOffsets = NULL;
+    graph->incomingNodes = NULL;
+    graph->incomingPositions = NULL;
+    graph->vertexOrder = vertexOrder;
+
+    // relabelled neighbours no longer follow the row order
+    graph->sortedRows = false;
+
+    free(order);
+    free(newIds);
+}
+
+/*
+ * @brief Get the vertex at a position of the node list
+ *
+ * @param Graph (pointer*)
+ * @param VertexId (position in the node list of the input file)
+ * @return VertexId
+ *
+ */
+VertexId getListedVertex(const Graph *graph, VertexId position)
+{
+    return graph->vertexOrder == NULL ? position : graph->vertexOrder[position];
+}
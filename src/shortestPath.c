@@ -0,0 +1,445 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include "shortestPath.h"
+#include "graphBuilder.h"
+#include "types.h"
+
+/*
+ * @brief declarations for internal functions
+ *
+ * List of static functions local to this file
+ * Meant to be used in this file only
+ *
+ * @note all internal functions are static
+ */
+static void reversePath(VertexId *path, unsigned int length);
+static bool expandLevel
+(
+    const size_t *offsets,
+    const VertexId *nodes,
+    VertexId *parents,
+    const VertexId *otherParents,
+    VertexId *queue,
+    unsigned int *queueLength,
+    unsigned int levelStart,
+    unsigned int levelEnd,
+    size_t *edgesExamined,
+    VertexId *meetingParent,
+    VertexId *meetingVertex
+);
+static unsigned int joinPath
+(
+    const PathSearch *search,
+    VertexId forwardVertex,
+    VertexId backwardVertex,
+    VertexId *path
+);
+static void resetPathSearch(PathSearch *search);
+
+/*
+ * @brief Reverse a path in place
+ *
+ * @param VertexId pointer [array] (path)
+ * @param unsigned int (length)
+ * @return void
+ *
+ */
+static void reversePath(VertexId *path, unsigned int length)
+{
+    for (unsigned int low = 0, high = length; low + 1 < high; low++, high--)
+    {
+        VertexId vertex = path[low];
+        path[low] = path[high - 1];
+        path[high - 1] = vertex;
+    }
+}
+
+/*
+ * @brief Bfs that keeps its tree
+ *
+ * Top-down bfs from any source that records the
+ * parent and hop distance of every vertex it reaches.
+ * Parents are the first neighbour to reach a vertex,
+ * the same tree the top-down traversal walks
+ *
+ * @param Graph (pointer*)
+ * @param VertexId (source)
+ * @param BfsTree (pointer*)
+ * @return void
+ *
+ */
+void computeBfsTree(const Graph *graph, VertexId source, BfsTree *tree)
+{
+    unsigned int noOfNodes = graph->noOfNodes;
+
+    tree->source = source;
+    tree->parents = (VertexId *)malloc(((size_t)noOfNodes + 1) * sizeof(VertexId));
+    tree->distances = (unsigned int *)malloc(((size_t)noOfNodes + 1) * sizeof(unsigned int));
+    VertexId *queue = (VertexId *)malloc(((size_t)noOfNodes + 1) * sizeof(VertexId));
+
+    if (tree->parents == NULL || tree->distances == NULL || queue == NULL)
+    {
+        perror("Failed to allocate memory\n");
+        exit(EXIT_FAILURE);
+    }
+
+    for (size_t index = 0; index < noOfNodes; index++)
+    {
+        tree->parents[index] = INVALID_VERTEX;
+        tree->distances[index] = UNREACHED_DISTANCE;
+    }
+
+    unsigned int front = 0, rear = 0;
+
+    queue[rear++] = source;
+    tree->parents[source] = source;
+    tree->distances[source] = 0;
+
+    while (front < rear)
+    {
+        VertexId vertex = queue[front++];
+
+        for (size_t edge = graph->edgeOffsets[vertex]; edge < graph->edgeOffsets[vertex + 1]; edge++)
+        {
+            VertexId adjacentNode = graph->adjacentNodes[edge];
+
+            if (tree->parents[adjacentNode] == INVALID_VERTEX)
+            {
+                tree->parents[adjacentNode] = vertex;
+                tree->distances[adjacentNode] = tree->distances[vertex] + 1;
+                queue[rear++] = adjacentNode;
+            }
+        }
+    }
+
+    tree->traversalLength = rear;
+
+    free(queue);
+}
+
+/*
+ * @brief Read a hop path out of a bfs tree
+ *
+ * @param BfsTree (pointer*)
+ * @param VertexId (target)
+ * @param VertexId pointer [array] (path, room for distance + 1 vertices)
+ * @return unsigned int (vertices on the path, 0 if the target was not reached)
+ *
+ */
+unsigned int getTreePath(const BfsTree *tree, VertexId target, VertexId *path)
+{
+    if (tree->parents[target] == INVALID_VERTEX)
+    {
+        return 0;
+    }
+
+    unsigned int length = 0;
+
+    for (VertexId vertex = target; vertex != tree->source; vertex = tree->parents[vertex])
+    {
+        path[length++] = vertex;
+    }
+
+    path[length++] = tree->source;
+    reversePath(path, length);
+
+    return length;
+}
+
+/*
+ * @brief Free bfs tree
+ *
+ * @param BfsTree (pointer*)
+ * @return void
+ *
+ */
+void freeBfsTree(BfsTree *tree)
+{
+    free(tree->parents);
+    free(tree->distances);
+
+    tree->parents = NULL;
+    tree->distances = NULL;
+}
+
+/*
+ * @brief Initialize path search
+ *
+ * @param PathSearch (pointer*)
+ * @param Graph (pointer*)
+ * @return void
+ *
+ * @note Builds the incoming arrays of a directed graph if missing
+ *
+ */
+void initPathSearch(PathSearch *search, Graph *graph)
+{
+    unsigned int noOfNodes = graph->noOfNodes;
+
+    // undirected edges are stored both ways, so outgoing rows serve both sides
+    if (graph->directed)
+    {
+        buildIncomingArrays(graph);
+        search->backwardOffsets = graph->incomingOffsets;
+        search->backwardNodes = graph->incomingNodes;
+    }
+    else
+    {
+        search->backwardOffsets = graph->edgeOffsets;
+        search->backwardNodes = graph->adjacentNodes;
+    }
+
+    search->graph = graph;
+    search->forwardParents = (VertexId *)calloc((size_t)noOfNodes + 1, sizeof(VertexId));
+    search->backwardParents = (VertexId *)calloc((size_t)noOfNodes + 1, sizeof(VertexId));
+    search->forwardQueue = (VertexId *)malloc(((size_t)noOfNodes + 1) * sizeof(VertexId));
+    search->backwardQueue = (VertexId *)malloc(((size_t)noOfNodes + 1) * sizeof(VertexId));
+    search->forwardLength = 0;
+    search->backwardLength = 0;
+    search->verticesVisited = 0;
+    search->edgesExamined = 0;
+
+    if
+    (
+        search->forwardParents == NULL || search->backwardParents == NULL ||
+        search->forwardQueue == NULL || search->backwardQueue == NULL
+    )
+    {
+        perror("Failed to allocate memory\n");
+        exit(EXIT_FAILURE);
+    }
+}
+
+/*
+ * @brief Expand one level of one side of the search
+ *
+ * Stops at the first edge into a vertex the
+ * other side has already reached
+ *
+ * @param size_t pointer [array] (offsets) => rows followed by this side
+ * @param VertexId pointer [array] (nodes) => edges followed by this side
+ * @param VertexId pointer [array] (parents) => parent + 1 of this side
+ * @param VertexId pointer [array] (other parents) => parent + 1 of the other side
+ * @param VertexId pointer [array] (queue) => vertices this side reached
+ * @param unsigned int (pointer*) => used part of the queue
+ * @param unsigned int (level start) => first queue index of the level
+ * @param unsigned int (level end) => queue index past the level
+ * @param size_t (pointer*) => edges examined, incremented
+ * @param VertexId (pointer*) => receives the vertex on this side of the meeting edge
+ * @param VertexId (pointer*) => receives the vertex on the other side of the meeting edge
+ * @return bool (the sides met)
+ *
+ */
+static bool expandLevel
+(
+    const size_t *offsets,
+    const VertexId *nodes,
+    VertexId *parents,
+    const VertexId *otherParents,
+    VertexId *queue,
+    unsigned int *queueLength,
+    unsigned int levelStart,
+    unsigned int levelEnd,
+    size_t *edgesExamined,
+    VertexId *meetingParent,
+    VertexId *meetingVertex
+)
+{
+    for (unsigned int index = levelStart; index < levelEnd; index++)
+    {
+        VertexId vertex = queue[index];
+
+        for (size_t edge = offsets[vertex]; edge < offsets[vertex + 1]; edge++)
+        {
+            VertexId adjacentNode = nodes[edge];
+
+            (*edgesExamined)++;
+
+            if (otherParents[adjacentNode] != 0)
+            {
+                *meetingParent = vertex;
+                *meetingVertex = adjacentNode;
+                return true;
+            }
+
+            if (parents[adjacentNode] == 0)
+            {
+                parents[adjacentNode] = vertex + 1;
+                queue[(*queueLength)++] = adjacentNode;
+            }
+        }
+    }
+
+    return false;
+}
+
+/*
+ * @brief Join both halves of a path
+ *
+ * @param PathSearch (pointer*)
+ * @param VertexId (forward vertex) => end of the meeting edge reached from the start
+ * @param VertexId (backward vertex) => end of the meeting edge reached from the goal
+ * @param VertexId pointer [array] (path)
+ * @return unsigned int (vertices on the path)
+ *
+ */
+static unsigned int joinPath
+(
+    const PathSearch *search,
+    VertexId forwardVertex,
+    VertexId backwardVertex,
+    VertexId *path
+)
+{
+    unsigned int length = 0;
+
+    // roots are their own parents
+    for (VertexId vertex = forwardVertex; ; vertex = search->forwardParents[vertex] - 1)
+    {
+        path[length++] = vertex;
+
+        if (search->forwardParents[vertex] - 1 == vertex)
+        {
+            break;
+        }
+    }
+
+    reversePath(path, length);
+
+    for (VertexId vertex = backwardVertex; ; vertex = search->backwardParents[vertex] - 1)
+    {
+        path[length++] = vertex;
+
+        if (search->backwardParents[vertex] - 1 == vertex)
+        {
+            break;
+        }
+    }
+
+    return length;
+}
+
+/*
+ * @brief Clear the entries the last query touched
+ *
+ * @param PathSearch (pointer*)
+ * @return void
+ *
+ */
+static void resetPathSearch(PathSearch *search)
+{
+    for (unsigned int index = 0; index < search->forwardLength; index++)
+    {
+        search->forwardParents[search->forwardQueue[index]] = 0;
+    }
+
+    for (unsigned int index = 0; index < search->backwardLength; index++)
+    {
+        search->backwardParents[search->backwardQueue[index]] = 0;
+    }
+
+    search->forwardLength = 0;
+    search->backwardLength = 0;
+}
+
+/*
+ * @brief Shortest hop path between two vertices
+ *
+ * Bidirectional bfs. The side with the smaller
+ * frontier expands one level at a time, forward
+ * along outgoing edges from the start and backward
+ * along incoming edges from the goal, until an edge
+ * joins the two sides
+ *
+ * The first joining edge found is on a shortest
+ * path: any shorter one would have joined the sides
+ * while an earlier level was expanded
+ *
+ * @param PathSearch (pointer*)
+ * @param VertexId (start)
+ * @param VertexId (goal)
+ * @param VertexId pointer [array] (path, room for every node)
+ * @return unsigned int (vertices on the path, 0 if the goal cannot be reached)
+ *
+ * @note verticesVisited and edgesExamined describe the query afterwards
+ *
+ */
+unsigned int findShortestPath(PathSearch *search, VertexId start, VertexId goal, VertexId *path)
+{
+    const Graph *graph = search->graph;
+
+    search->edgesExamined = 0;
+
+    if (start == goal)
+    {
+        path[0] = start;
+        search->verticesVisited = 1;
+        return 1;
+    }
+
+    search->forwardParents[start] = start + 1;
+    search->forwardQueue[search->forwardLength++] = start;
+    search->backwardParents[goal] = goal + 1;
+    search->backwardQueue[search->backwardLength++] = goal;
+
+    unsigned int forwardStart = 0, backwardStart = 0;
+    VertexId meetingParent = INVALID_VERTEX, meetingVertex = INVALID_VERTEX;
+    VertexId forwardVertex = INVALID_VERTEX, backwardVertex = INVALID_VERTEX;
+    bool met = false;
+
+    while (!met && forwardStart < search->forwardLength && backwardStart < search->backwardLength)
+    {
+        unsigned int forwardEnd = search->forwardLength;
+        unsigned int backwardEnd = search->backwardLength;
+
+        if (forwardEnd - forwardStart <= backwardEnd - backwardStart)
+        {
+            met = expandLevel
+            (
+                graph->edgeOffsets, graph->adjacentNodes,
+                search->forwardParents, search->backwardParents,
+                search->forwardQueue, &search->forwardLength,
+                forwardStart, forwardEnd, &search->edgesExamined, &meetingParent, &meetingVertex
+            );
+            forwardVertex = meetingParent;
+            backwardVertex = meetingVertex;
+            forwardStart = forwardEnd;
+        }
+        else
+        {
+            met = expandLevel
+            (
+                search->backwardOffsets, search->backwardNodes,
+                search->backwardParents, search->forwardParents,
+                search->backwardQueue, &search->backwardLength,
+                backwardStart, backwardEnd, &search->edgesExamined, &meetingParent, &meetingVertex
+            );
+            forwardVertex = meetingVertex;
+            backwardVertex = meetingParent;
+            backwardStart = backwardEnd;
+        }
+    }
+
+    unsigned int length = met ? joinPath(search, forwardVertex, backwardVertex, path) : 0;
+
+    search->verticesVisited = (size_t)search->forwardLength + search->backwardLength;
+    resetPathSearch(search);
+
+    return length;
+}
+
+/*
+ * @brief Free path search
+ *
+ * @param PathSearch (pointer*)
+ * @return void
+ *
+ */
+void freePathSearch(PathSearch *search)
+{
+    free(search->forwardParents);
+    free(search->backwardParents);
+    free(search->forwardQueue);
+    free(search->backwardQueue);
+}
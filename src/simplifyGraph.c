@@ -0,0 +1,291 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <limits.h>
+#include "simplifyGraph.h"
+#include "arena.h"
+#include "graphBuilder.h"
+#include "types.h"
+
+/*
+ * @brief declarations for internal functions
+ *
+ * List of static functions local to this file
+ * Meant to be used in this file only
+ *
+ * @note all internal functions are static
+ */
+static uint64_t mergeWeights
+(
+    const unsigned int *weights,
+    const uint64_t *keys,
+    size_t noOfCopies,
+    MultiEdgePolicy policy
+);
+
+/*
+ * @brief Merge the weights of the copies of an edge
+ *
+ * @param unsigned int pointer [array] (weights) => weights of the row
+ * @param uint64_t pointer [array] (keys) => sorted keys of the copies
+ * @param size_t (number of copies)
+ * @param MultiEdgePolicy (policy)
+ * @return uint64_t
+ *
+ */
+static uint64_t mergeWeights
+(
+    const unsigned int *weights,
+    const uint64_t *keys,
+    size_t noOfCopies,
+    MultiEdgePolicy policy
+)
+{
+    uint64_t merged = weights[(uint32_t)keys[0]];
+
+    for (size_t copy = 1; copy < noOfCopies; copy++)
+    {
+        unsigned int weight = weights[(uint32_t)keys[copy]];
+
+        if (policy == SUM_WEIGHTS)
+        {
+            merged += weight;
+        }
+        else if (policy == KEEP_MIN_WEIGHT && weight < merged)
+        {
+            merged = weight;
+        }
+    }
+
+    return merged;
+}
+
+/*
+ * @brief Sort the rows and merge multi-edges
+ *
+ * Rebuilds the adjacency with every row in
+ * ascending neighbour order, merging the copies
+ * of an edge as the policy asks and dropping self
+ * loops if asked to. The total weight is worked
+ * out again from the edges that remain. Afterwards
+ * hasEdge answers with a binary search
+ *
+ * @param Graph (pointer*)
+ * @param MultiEdgePolicy (policy)
+ * @param bool (drop self loops)
+ * @param SimplifyStats (pointer*) => receives the edges removed
+ * @return void
+ *
+ * @note Run it before compressGraph, a compressed graph is left as it is
+ *
+ */
+void simplifyGraph(Graph *graph, MultiEdgePolicy policy, bool dropSelfLoops, SimplifyStats *stats)
+{
+    stats->duplicatesRemoved = 0;
+    stats->selfLoopsRemoved = 0;
+
+    if (graph->compressed != NULL)
+    {
+        return;
+    }
+
+    unsigned int noOfNodes = graph->noOfNodes;
+    size_t maxDegree = 0;
+
+    for (VertexId vertex = 0; vertex < noOfNodes; vertex++)
+    {
+        size_t degree = graph->edgeOffsets[vertex + 1] - graph->edgeOffsets[vertex];
+        maxDegree = degree > maxDegree ? degree : maxDegree;
+    }
+
+    uint64_t *keys = (uint64_t *)malloc((maxDegree + 1) * sizeof(uint64_t));
+
+    if (keys == NULL)
+    {
+        perror("Failed to allocate memory\n");
+        exit(EXIT_FAILURE);
+    }
+
+    // merging can only shrink the adjacency
+    Arena arena;
+    initArena(&arena);
+
+    size_t *edgeOffsets = (size_t *)arenaAllocate(&arena, ((size_t)noOfNodes + 1) * sizeof(size_t));
+    VertexId *adjacentNodes = (VertexId *)arenaAllocate(&arena, (graph->noOfEdges + 1) * sizeof(VertexId));
+    unsigned int *edgeWeights = (unsigned int *)arenaAllocate
+    (
+        &arena, (graph->noOfEdges + 1) * sizeof(unsigned int)
+    );
+
+    // every self loop line of an undirected graph leaves two copies in its row
+    size_t loopCopies = graph->directed ? 1 : 2;
+    uint64_t edgeWeight = 0, loopWeight = 0;
+    size_t edgeDuplicates = 0, loopDuplicates = 0, loopsRemoved = 0;
+    size_t edge = 0;
+
+    for (VertexId vertex = 0; vertex < noOfNodes; vertex++)
+    {
+        const unsigned int *rowWeights = graph->edgeWeights + graph->edgeOffsets[vertex];
+        size_t degree = sortRowKeys(graph, vertex, ROW_KEY_POSITION, keys);
+        size_t index = 0;
+
+        edgeOffsets[vertex] = edge;
+
+        while (index < degree)
+        {
+            VertexId neighbour = (VertexId)(keys[index] >> 32);
+            size_t groupEnd = index + 1;
+
+            while (groupEnd < degree && (VertexId)(keys[groupEnd] >> 32) == neighbour)
+            {
+                groupEnd++;
+            }
+
+            bool selfLoop = neighbour == vertex;
+            size_t copiesPerLine = selfLoop ? loopCopies : 1;
+            size_t noOfLines = (groupEnd - index + copiesPerLine - 1) / copiesPerLine;
+
+            if (selfLoop && dropSelfLoops)
+            {
+                loopsRemoved += noOfLines;
+                index = groupEnd;
+                continue;
+            }
+
+            uint64_t groupWeight = 0;
+
+            if (policy == KEEP_MULTI_EDGES)
+            {
+                for (; index < groupEnd; index++)
+                {
+                    adjacentNodes[edge] = neighbour;
+                    edgeWeights[edge] = rowWeights[(uint32_t)keys[index]];
+                    groupWeight += edgeWeights[edge];
+                    edge++;
+                }
+
+                groupWeight /= copiesPerLine;
+            }
+            else
+            {
+                groupWeight = mergeWeights(rowWeights, keys + index, groupEnd - index, policy);
+
+                // a self loop line was summed once for each of its copies
+                if (policy == SUM_WEIGHTS)
+                {
+                    groupWeight /= copiesPerLine;
+                }
+
+                groupWeight = groupWeight > UINT_MAX ? UINT_MAX : groupWeight;
+
+                adjacentNodes[edge] = neighbour;
+                edgeWeights[edge] = (unsigned int)groupWeight;
+                edge++;
+
+                if (selfLoop)
+                {
+                    loopDuplicates += noOfLines - 1;
+                }
+                else
+                {
+                    edgeDuplicates += noOfLines - 1;
+                }
+
+                index = groupEnd;
+            }
+
+            if (selfLoop)
+            {
+                loopWeight += groupWeight;
+            }
+            else
+            {
+                edgeWeight += groupWeight;
+            }
+        }
+    }
+
+    edgeOffsets[noOfNodes] = edge;
+
+    // both directions of an undirected edge were seen, once in each row
+    if (!graph->directed)
+    {
+        edgeWeight /= 2;
+        edgeDuplicates /= 2;
+    }
+
+    free(keys);
+
+    replaceGraphArena(graph, &arena);
+
+    graph->noOfEdges = edge;
+    graph->totalWeight = (unsigned int)(edgeWeight + loopWeight);
+    graph->edgeOffsets = edgeOffsets;
+    graph->adjacentNodes = adjacentNodes;
+    graph->edgeWeights = edgeWeights;
+    graph->sortedRows = true;
+
+    stats->duplicatesRemoved = edgeDuplicates + loopDuplicates;
+    stats->selfLoopsRemoved = loopsRemoved;
+}
+
+/*
+ * @brief Look up an edge
+ *
+ * Binary searches the row once the graph is
+ * simplified and scans it otherwise. With copies
+ * of the edge the first one listed is found
+ *
+ * @param Graph (pointer*)
+ * @param VertexId (from)
+ * @param VertexId (to)
+ * @param unsigned int (pointer*) => receives the weight, may be NULL
+ * @return bool (whether the edge exists)
+ *
+ * @note Needs the plain edge arrays
+ *
+ */
+bool hasEdge(const Graph *graph, VertexId from, VertexId to, unsigned int *weight)
+{
+    size_t edge = graph->edgeOffsets[from];
+    size_t rowEnd = graph->edgeOffsets[from + 1];
+
+    if (graph->sortedRows)
+    {
+        size_t high = rowEnd;
+
+        while (edge < high)
+        {
+            size_t middle = edge + (high - edge) / 2;
+
+            if (graph->adjacentNodes[middle] < to)
+            {
+                edge = middle + 1;
+            }
+            else
+            {
+                high = middle;
+            }
+        }
+    }
+    else
+    {
+        while (edge < rowEnd && graph->adjacentNodes[edge] != to)
+        {
+            edge++;
+        }
+    }
+
+    if (edge == rowEnd || graph->adjacentNodes[edge] != to)
+    {
+        return false;
+    }
+
+    if (weight != NULL)
+    {
+        *weight = graph->edgeWeights[edge];
+    }
+
+    return true;
+}
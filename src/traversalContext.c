@@ -0,0 +1,85 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "traversalContext.h"
+#include "bitmap.h"
+#include "types.h"
+
+/*
+ * @brief Initialize a traversal context
+ *
+ * Every array is sized for all vertices up front,
+ * so traversals on the context never allocate
+ *
+ * @param TraversalContext (pointer*)
+ * @param unsigned int (number of nodes)
+ * @return void
+ *
+ */
+void initTraversalContext(TraversalContext *context, unsigned int noOfNodes)
+{
+    context->noOfNodes = noOfNodes;
+    context->visitMarks = (unsigned char *)calloc((size_t)noOfNodes + 1, sizeof(unsigned char));
+    context->epoch = 1;
+    context->bitmapInUse = false;
+    context->traversalPath = (VertexId *)malloc(((size_t)noOfNodes + 1) * sizeof(VertexId));
+    context->traversalLength = 0;
+    context->unReachableNodes = (VertexId *)malloc(((size_t)noOfNodes + 1) * sizeof(VertexId));
+
+    if (context->visitMarks == NULL || context->traversalPath == NULL || context->unReachableNodes == NULL)
+    {
+        perror("Failed to allocate memory\n");
+        exit(EXIT_FAILURE);
+    }
+
+    initBitmap(&context->visited, noOfNodes);
+}
+
+/*
+ * @brief Forget the last traversal of a context
+ *
+ * Moves to the next epoch, which unmarks every
+ * vertex at once, and clears the bits the last
+ * traversal set along its path. The marks are only
+ * wiped when the epoch wraps around
+ *
+ * @param TraversalContext (pointer*)
+ * @return void
+ *
+ */
+void resetTraversalContext(TraversalContext *context)
+{
+    if (context->bitmapInUse)
+    {
+        for (unsigned int index = 0; index < context->traversalLength; index++)
+        {
+            clearBit(&context->visited, context->traversalPath[index]);
+        }
+
+        context->bitmapInUse = false;
+    }
+
+    context->traversalLength = 0;
+    context->epoch++;
+
+    if (context->epoch == 0)
+    {
+        memset(context->visitMarks, 0, (size_t)context->noOfNodes * sizeof(unsigned char));
+        context->epoch = 1;
+    }
+}
+
+/*
+ * @brief Free a traversal context
+ *
+ * @param TraversalContext (pointer*)
+ * @return void
+ *
+ */
+void freeTraversalContext(TraversalContext *context)
+{
+    free(context->visitMarks);
+    free(context->traversalPath);
+    free(context->unReachableNodes);
+    freeBitmap(&context->visited);
+}
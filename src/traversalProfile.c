@@ -0,0 +1,338 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#include "traversalProfile.h"
+
+/*
+ * @brief declarations for internal functions
+ *
+ * List of static functions local to this file
+ * Meant to be used in this file only
+ *
+ * @note all internal functions are static
+ */
+static int openCounter(uint64_t config);
+static uint64_t readCounter(int counterFd);
+static void closeLevel(TraversalProfile *profile, size_t edgesExamined, size_t visitedCount);
+static void writeCounter(FILE *output, bool enabled, uint64_t value);
+
+/*
+ * @brief Read the monotonic clock
+ *
+ * @return double (seconds)
+ *
+ */
+double readClock(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (double)now.tv_sec + (double)now.tv_nsec / 1e9;
+}
+
+/*
+ * @brief Open a hardware counter
+ *
+ * Counts for the calling thread on any cpu,
+ * user space only so it works without privileges
+ *
+ * @param uint64_t (PERF_COUNT_HW_ event)
+ * @return int (file descriptor, -1 if unavailable)
+ *
+ */
+static int openCounter(uint64_t config)
+{
+    struct perf_event_attr attributes;
+    memset(&attributes, 0, sizeof(attributes));
+
+    attributes.type = PERF_TYPE_HARDWARE;
+    attributes.size = sizeof(attributes);
+    attributes.config = config;
+    attributes.exclude_kernel = 1;
+    attributes.exclude_hv = 1;
+
+    return (int)syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0);
+}
+
+/*
+ * @brief Read a hardware counter
+ *
+ * @param int (file descriptor)
+ * @return uint64_t (count, 0 if the read fails)
+ *
+ */
+static uint64_t readCounter(int counterFd)
+{
+    uint64_t value = 0;
+
+    if (read(counterFd, &value, sizeof(value)) != (ssize_t)sizeof(value))
+    {
+        return 0;
+    }
+
+    return value;
+}
+
+/*
+ * @brief Initialize a traversal profile
+ *
+ * @param TraversalProfile (pointer*)
+ * @param bool (open hardware counters)
+ * @return void
+ *
+ * @note Warns and carries on without counters if
+ *       perf_event_open is not permitted
+ *
+ */
+void startProfile(TraversalProfile *profile, bool useCounters)
+{
+    profile->levels = NULL;
+    profile->noOfLevels = 0;
+    profile->capacity = 0;
+    profile->countersEnabled = false;
+    profile->cacheMissesFd = -1;
+    profile->branchMissesFd = -1;
+    profile->levelStart = 0;
+    profile->levelEdges = 0;
+    profile->levelVisited = 0;
+    profile->levelCacheMisses = 0;
+    profile->levelBranchMisses = 0;
+    profile->nextQueueLevel = 0;
+
+    if (!useCounters)
+    {
+        return;
+    }
+
+    profile->cacheMissesFd = openCounter(PERF_COUNT_HW_CACHE_MISSES);
+    profile->branchMissesFd = openCounter(PERF_COUNT_HW_BRANCH_MISSES);
+
+    if (profile->cacheMissesFd == -1 || profile->branchMissesFd == -1)
+    {
+        perror("Hardware counters unavailable");
+        freeProfile(profile);
+        return;
+    }
+
+    profile->countersEnabled = true;
+}
+
+/*
+ * @brief Close the current level
+ *
+ * @param TraversalProfile (pointer*)
+ * @param size_t (edges examined so far)
+ * @param size_t (vertices visited so far)
+ * @return void
+ *
+ */
+static void closeLevel(TraversalProfile *profile, size_t edgesExamined, size_t visitedCount)
+{
+    if (profile->noOfLevels == 0)
+    {
+        return;
+    }
+
+    LevelProfile *level = &profile->levels[profile->noOfLevels - 1];
+
+    level->seconds = readClock() - profile->levelStart;
+    level->edgesExamined = edgesExamined - profile->levelEdges;
+    level->newlyVisited = visitedCount - profile->levelVisited;
+
+    if (profile->countersEnabled)
+    {
+        level->cacheMisses = readCounter(profile->cacheMissesFd) - profile->levelCacheMisses;
+        level->branchMisses = readCounter(profile->branchMissesFd) - profile->levelBranchMisses;
+    }
+}
+
+/*
+ * @brief Start a new level
+ *
+ * Closes the previous level with the running
+ * totals and opens the next one
+ *
+ * @param TraversalProfile (pointer*)
+ * @param size_t (frontier size)
+ * @param size_t (edges examined so far)
+ * @param size_t (vertices visited so far)
+ * @param bool (bottom up step)
+ * @return void
+ *
+ */
+void markProfileLevel
+(
+    TraversalProfile *profile,
+    size_t frontierSize,
+    size_t edgesExamined,
+    size_t visitedCount,
+    bool bottomUp
+)
+{
+    closeLevel(profile, edgesExamined, visitedCount);
+
+    if (profile->noOfLevels == profile->capacity)
+    {
+        unsigned int newCapacity = profile->capacity == 0 ? 32 : profile->capacity * 2;
+        LevelProfile *newLevels = (LevelProfile *)realloc
+        (
+            profile->levels, newCapacity * sizeof(LevelProfile)
+        );
+
+        if (newLevels == NULL)
+        {
+            perror("Failed to allocate memory\n");
+            exit(EXIT_FAILURE);
+        }
+
+        profile->levels = newLevels;
+        profile->capacity = newCapacity;
+    }
+
+    LevelProfile *level = &profile->levels[profile->noOfLevels++];
+    memset(level, 0, sizeof(LevelProfile));
+    level->frontierSize = frontierSize;
+    level->bottomUp = bottomUp;
+
+    profile->levelEdges = edgesExamined;
+    profile->levelVisited = visitedCount;
+
+    if (profile->countersEnabled)
+    {
+        profile->levelCacheMisses = readCounter(profile->cacheMissesFd);
+        profile->levelBranchMisses = readCounter(profile->branchMissesFd);
+    }
+
+    profile->levelStart = readClock(); // read last so bookkeeping is not timed
+}
+
+/*
+ * @brief Close the last level of a traversal
+ *
+ * @param TraversalProfile (pointer*)
+ * @param size_t (edges examined in total)
+ * @param size_t (vertices visited in total)
+ * @return void
+ *
+ */
+void finishProfile(TraversalProfile *profile, size_t edgesExamined, size_t visitedCount)
+{
+    closeLevel(profile, edgesExamined, visitedCount);
+}
+
+/*
+ * @brief Write a counter value or null
+ *
+ * @param FILE (pointer*) => output stream
+ * @param bool (counters enabled)
+ * @param uint64_t (value)
+ * @return void
+ *
+ */
+static void writeCounter(FILE *output, bool enabled, uint64_t value)
+{
+    if (enabled)
+    {
+        fprintf(output, "%llu", (unsigned long long)value);
+    }
+    else
+    {
+        fputs("null", output);
+    }
+}
+
+/*
+ * @brief Write a profile as JSON
+ *
+ * @param TraversalProfile (pointer*)
+ * @param FILE (pointer*) => output stream
+ * @param char pointer [array] (traversal mode name)
+ * @param unsigned int (number of nodes)
+ * @param size_t (number of edges)
+ * @return void
+ *
+ * @note Counters are null when they could not be opened
+ *
+ */
+void writeProfileJson
+(
+    const TraversalProfile *profile,
+    FILE *output,
+    const char *modeName,
+    unsigned int noOfNodes,
+    size_t noOfEdges
+)
+{
+    size_t totalEdges = 0, totalVisited = 0;
+    double totalSeconds = 0;
+
+    fprintf
+    (
+        output, "{\"mode\":\"%s\",\"vertices\":%u,\"edges\":%zu,\"hardwareCounters\":%s,\"levels\":[",
+        modeName, noOfNodes, noOfEdges, profile->countersEnabled ? "true" : "false"
+    );
+
+    for (unsigned int index = 0; index < profile->noOfLevels; index++)
+    {
+        const LevelProfile *level = &profile->levels[index];
+
+        fprintf
+        (
+            output,
+            "%s{\"level\":%u,\"direction\":\"%s\",\"frontierSize\":%zu,\"edgesExamined\":%zu,"
+            "\"newlyVisited\":%zu,\"seconds\":%.9g,\"cacheMisses\":",
+            index == 0 ? "" : ",", index, level->bottomUp ? "bottom-up" : "top-down",
+            level->frontierSize, level->edgesExamined, level->newlyVisited, level->seconds
+        );
+        writeCounter(output, profile->countersEnabled, level->cacheMisses);
+        fputs(",\"branchMisses\":", output);
+        writeCounter(output, profile->countersEnabled, level->branchMisses);
+        fputc('}', output);
+
+        totalEdges += level->edgesExamined;
+        totalVisited += level->newlyVisited;
+        totalSeconds += level->seconds;
+    }
+
+    fprintf
+    (
+        output, "],\"total\":{\"edgesExamined\":%zu,\"newlyVisited\":%zu,\"seconds\":%.9g}}\n",
+        totalEdges, totalVisited, totalSeconds
+    );
+}
+
+/*
+ * @brief Free a traversal profile
+ *
+ * @param TraversalProfile (pointer*)
+ * @return void
+ *
+ */
+void freeProfile(TraversalProfile *profile)
+{
+    if (profile->cacheMissesFd != -1)
+    {
+        close(profile->cacheMissesFd);
+    }
+
+    if (profile->branchMissesFd != -1)
+    {
+        close(profile->branchMissesFd);
+    }
+
+    free(profile->levels);
+
+    profile->levels = NULL;
+    profile->noOfLevels = 0;
+    profile->capacity = 0;
+    profile->countersEnabled = false;
+    profile->cacheMissesFd = -1;
+    profile->branchMissesFd = -1;
+}
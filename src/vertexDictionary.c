@@ -0,0 +1,312 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "vertexDictionary.h"
+#include "types.h"
+
+/*
+ * @brief declarations for internal functions
+ *
+ * List of static functions local to this file
+ * Meant to be used in this file only
+ * 
+ * @note all internal functions are static
+ */
+static uint64_t hashName(const char *name, size_t length);
+static bool isSameName
+(
+    const VertexDictionary *dictionary,
+    VertexId vertex,
+    const char *name,
+    size_t length
+);
+static size_t findSlot(const VertexDictionary *dictionary, const char *name, size_t length);
+static void resizeSlots(VertexDictionary *dictionary, size_t newSlotCount);
+static void appendName(VertexDictionary *dictionary, const char *name, size_t length);
+
+/*
+ * @brief Initialize vertex dictionary struct
+ * 
+ * Sizes the hash table so the expected number
+ * of names fits without rehashing
+ * 
+ * @param VertexDictionary (pointer*)
+ * @param VertexId (expected number of names)
+ * @return void
+ * 
+ */
+void initVertexDictionary(VertexDictionary *dictionary, VertexId expectedNames)
+{
+    dictionary->noOfNames = 0;
+    dictionary->nameCapacity = 0;
+    dictionary->nameOffsets = NULL;
+    dictionary->namePool = NULL;
+    dictionary->namePoolLength = 0;
+    dictionary->namePoolCapacity = 0;
+    dictionary->slots = NULL;
+    dictionary->slotCount = 0;
+
+    // keep the load factor at or below one half
+    size_t slotCount = 16;
+    while (slotCount < (size_t)expectedNames * 2)
+    {
+        slotCount *= 2;
+    }
+
+    resizeSlots(dictionary, slotCount);
+}
+
+/*
+ * @brief Hash a vertex name
+ * 
+ * 64 bit FNV-1a hash of the name bytes
+ * 
+ * @param char pointer [array] (name)
+ * @param size_t (length of name)
+ * @return uint64_t (hash)
+ * 
+ */
+static uint64_t hashName(const char *name, size_t length)
+{
+    uint64_t hash = 14695981039346656037ULL;
+
+    for (size_t index = 0; index < length; index++)
+    {
+        hash ^= (unsigned char)name[index];
+        hash *= 1099511628211ULL;
+    }
+
+    return hash;
+}
+
+/*
+ * @brief Compare a stored name with a given name
+ * 
+ * @param VertexDictionary (pointer*)
+ * @param VertexId (stored vertex)
+ * @param char pointer [array] (name)
+ * @param size_t (length of name)
+ * @return bool
+ * 
+ */
+static bool isSameName
+(
+    const VertexDictionary *dictionary,
+    VertexId vertex,
+    const char *name,
+    size_t length
+)
+{
+    const char *storedName = dictionary->namePool + dictionary->nameOffsets[vertex];
+
+    // strnlen stops at the stored terminator, so a shorter name is never read past
+    return strnlen(storedName, length + 1) == length && memcmp(storedName, name, length) == 0;
+}
+
+/*
+ * @brief Find the hash slot of a name
+ * 
+ * Linear probing from the hashed slot until either
+ * the name or an empty slot is found
+ * 
+ * @param VertexDictionary (pointer*)
+ * @param char pointer [array] (name)
+ * @param size_t (length of name)
+ * @return size_t (slot index)
+ * 
+ */
+static size_t findSlot(const VertexDictionary *dictionary, const char *name, size_t length)
+{
+    size_t mask = dictionary->slotCount - 1;
+    size_t slot = (size_t)hashName(name, length) & mask;
+
+    while (dictionary->slots[slot] != INVALID_VERTEX)
+    {
+        if (isSameName(dictionary, dictionary->slots[slot], name, length))
+        {
+            break;
+        }
+        slot = (slot + 1) & mask;
+    }
+
+    return slot;
+}
+
+/*
+ * @brief Resize hash table
+ * 
+ * Allocates a new hash table and reinserts
+ * every interned name
+ * 
+ * @param VertexDictionary (pointer*)
+ * @param size_t (new slot count, power of two)
+ * @return void
+ * 
+ */
+static void resizeSlots(VertexDictionary *dictionary, size_t newSlotCount)
+{
+    VertexId *newSlots = (VertexId *)malloc(newSlotCount * sizeof(VertexId));
+
+    if (newSlots == NULL)
+    {
+        perror("Failed to allocate memory\n");
+        exit(EXIT_FAILURE);
+    }
+
+    for (size_t index = 0; index < newSlotCount; index++)
+    {
+        newSlots[index] = INVALID_VERTEX;
+    }
+
+    free(dictionary->slots);
+    dictionary->slots = newSlots;
+    dictionary->slotCount = newSlotCount;
+
+    for (VertexId vertex = 0; vertex < dictionary->noOfNames; vertex++)
+    {
+        const char *storedName = dictionary->namePool + dictionary->nameOffsets[vertex];
+        size_t slot = findSlot(dictionary, storedName, strlen(storedName));
+        dictionary->slots[slot] = vertex;
+    }
+}
+
+/*
+ * @brief Append a name to the name pool
+ * 
+ * Copies the name into the pool and records
+ * its offset under the next vertex identifier
+ * 
+ * @param VertexDictionary (pointer*)
+ * @param char pointer [array] (name)
+ * @param size_t (length of name)
+ * @return void
+ * 
+ */
+static void appendName(VertexDictionary *dictionary, const char *name, size_t length)
+{
+    if (dictionary->noOfNames == dictionary->nameCapacity)
+    {
+        VertexId newCapacity = dictionary->nameCapacity == 0 ? 16 : dictionary->nameCapacity * 2;
+
+        size_t *newOffsets = (size_t *)realloc
+        (
+            dictionary->nameOffsets, newCapacity * sizeof(size_t)
+        );
+
+        if (newOffsets == NULL)
+        {
+            perror("Failed to allocate memory\n");
+            exit(EXIT_FAILURE);
+        }
+
+        dictionary->nameOffsets = newOffsets;
+        dictionary->nameCapacity = newCapacity;
+    }
+
+    if (dictionary->namePoolLength + length + 1 > dictionary->namePoolCapacity)
+    {
+        size_t newCapacity = dictionary->namePoolCapacity == 0 ? 256 : dictionary->namePoolCapacity;
+        while (newCapacity < dictionary->namePoolLength + length + 1)
+        {
+            newCapacity *= 2;
+        }
+
+        char *newPool = (char *)realloc(dictionary->namePool, newCapacity * sizeof(char));
+
+        if (newPool == NULL)
+        {
+            perror("Failed to allocate memory\n");
+            exit(EXIT_FAILURE);
+        }
+
+        dictionary->namePool = newPool;
+        dictionary->namePoolCapacity = newCapacity;
+    }
+
+    dictionary->nameOffsets[dictionary->noOfNames] = dictionary->namePoolLength;
+    memcpy(dictionary->namePool + dictionary->namePoolLength, name, length);
+    dictionary->namePool[dictionary->namePoolLength + length] = '\0';
+    dictionary->namePoolLength += length + 1;
+}
+
+/*
+ * @brief Intern a vertex name
+ * 
+ * Returns the identifier of the name, assigning
+ * the next dense identifier if it is new
+ * 
+ * @param VertexDictionary (pointer*)
+ * @param char pointer [array] (name, need not be null terminated)
+ * @param size_t (length of name)
+ * @return VertexId
+ * 
+ */
+VertexId internVertexName(VertexDictionary *dictionary, const char *name, size_t length)
+{
+    size_t slot = findSlot(dictionary, name, length);
+
+    if (dictionary->slots[slot] != INVALID_VERTEX)
+    {
+        return dictionary->slots[slot];
+    }
+
+    if (dictionary->noOfNames == INVALID_VERTEX - 1)
+    {
+        perror("Too many vertices\n");
+        exit(EXIT_FAILURE);
+    }
+
+    VertexId vertex = dictionary->noOfNames;
+    appendName(dictionary, name, length);
+    dictionary->slots[slot] = vertex;
+    dictionary->noOfNames++;
+
+    // grow before the load factor passes one half
+    if ((size_t)dictionary->noOfNames * 2 > dictionary->slotCount)
+    {
+        resizeSlots(dictionary, dictionary->slotCount * 2);
+    }
+
+    return vertex;
+}
+
+/*
+ * @brief Find the identifier of a vertex name
+ * 
+ * @param VertexDictionary (pointer*)
+ * @param char pointer [array] (name, need not be null terminated)
+ * @param size_t (length of name)
+ * @return VertexId (INVALID_VERTEX if not interned)
+ * 
+ */
+VertexId findVertexId(const VertexDictionary *dictionary, const char *name, size_t length)
+{
+    return dictionary->slots[findSlot(dictionary, name, length)];
+}
+
+/*
+ * @brief Get the external name of a vertex
+ * 
+ * @param VertexDictionary (pointer*)
+ * @param VertexId (vertex)
+ * @return char pointer [array] (null terminated name)
+ * 
+ */
+const char *getVertexName(const VertexDictionary *dictionary, VertexId vertex)
+{
+    return dictionary->namePool + dictionary->nameOffsets[vertex];
+}
+
+/*
+ * @brief Free vertex dictionary
+ * 
+ * @param VertexDictionary (pointer*)
+ * @return void
+ * 
+ */
+void freeVertexDictionary(VertexDictionary *dictionary)
+{
+    free(dictionary->nameOffsets);
+    free(dictionary->namePool);
+    free(dictionary->slots);
+}
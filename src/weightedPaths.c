@@ -0,0 +1,1030 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <pthread.h>
+#include "weightedPaths.h"
+#include "parallelBfs.h"
+#include "workerThreads.h"
+#include "types.h"
+
+/*
+ * @brief Buckets of the radix heap
+ *
+ * One for keys equal to the last popped key and
+ * one per bit position a key can differ from it in
+ *
+ */
+#define RADIX_BUCKETS 65
+
+/*
+ * @brief Delta buckets a thread keeps bins for
+ *
+ * Vertices further ahead than the window wait in
+ * an overflow bin until the window drains
+ *
+ */
+#define BUCKET_WINDOW 256
+
+/*
+ * @brief Bucket entries handed to a thread at a time
+ */
+#define RELAX_CHUNK 64
+
+/*
+ * @brief Spinlocks guarding the distance updates
+ *
+ * Vertices share a lock by their low bits, so
+ * this must be a power of two
+ *
+ */
+#define LOCK_STRIPES 1024
+
+/*
+ * @brief Heap entry data structure
+ *
+ * @member uint64_t (key) => tentative distance of the vertex when pushed
+ * @member VertexId (vertex)
+ *
+ */
+typedef struct HeapEntry {
+    uint64_t key;
+    VertexId vertex;
+} HeapEntry;
+
+/*
+ * @brief Heap bucket data structure
+ *
+ * @member HeapEntry pointer [array] (entries)
+ * @member size_t (length) => entries in the bucket
+ * @member size_t (capacity) => entries that fit before growing
+ *
+ */
+typedef struct HeapBucket {
+    HeapEntry *entries;
+    size_t length;
+    size_t capacity;
+} HeapBucket;
+
+/*
+ * @brief Radix heap data structure
+ *
+ * RadixHeap struct is a monotone priority queue.
+ * An entry sits in the bucket of the highest bit its
+ * key differs from the last popped key in, so each
+ * entry moves down at most 64 times over its life
+ *
+ * @member HeapBucket [array] (buckets)
+ * @member uint64_t (last) => key popped last, no smaller key may be pushed
+ * @member size_t (size) => entries in every bucket
+ *
+ */
+typedef struct RadixHeap {
+    HeapBucket buckets[RADIX_BUCKETS];
+    uint64_t last;
+    size_t size;
+} RadixHeap;
+
+/*
+ * @brief Vertex bin data structure
+ *
+ * @member VertexId pointer [array] (vertices)
+ * @member size_t (length) => vertices in the bin
+ * @member size_t (capacity) => vertices that fit before growing
+ *
+ */
+typedef struct VertexBin {
+    VertexId *vertices;
+    size_t length;
+    size_t capacity;
+} VertexBin;
+
+/*
+ * @brief Local bins data structure
+ *
+ * LocalBins struct holds the vertices a single
+ * thread improved, binned by delta bucket
+ *
+ * @member VertexBin [array] (window) => bucket b lives in slot b % BUCKET_WINDOW
+ * @member VertexBin (overflow) => vertices past the window
+ * @member uint64_t (overflow bucket) => smallest live bucket in the overflow bin
+ * @member size_t (edges examined) => edges relaxed by the thread
+ *
+ */
+typedef struct LocalBins {
+    VertexBin window[BUCKET_WINDOW];
+    VertexBin overflow;
+    uint64_t overflowBucket;
+    size_t edgesExamined;
+} LocalBins;
+
+/*
+ * @brief Delta stepping state data structure
+ *
+ * DeltaState struct is shared by every thread of a
+ * delta stepping search. Each round settles one bucket
+ * and threads meet at a barrier between phases
+ *
+ * @member Graph (pointer*) => graph being searched
+ * @member uint64_t pointer [array] (distances) => tentative distances, read atomically
+ * @member pthread_spinlock_t pointer [array] (locks) => LOCK_STRIPES locks
+ * @member LocalBins pointer [array] (local bins) => one per thread
+ * @member unsigned int (number of threads) => threads taking part
+ * @member uint64_t (delta) => width of a bucket
+ * @member uint64_t (bucket) => bucket being settled
+ * @member VertexId pointer [array] (frontier) => vertices of the bucket this round
+ * @member size_t (frontier length) => used part of the frontier
+ * @member size_t (frontier capacity) => vertices that fit before growing
+ * @member size_t (next chunk) => next frontier offset to hand out
+ * @member bool (refill) => the window moves to the smallest overflow bucket
+ * @member bool (finished) => set once every bin is empty
+ * @member pthread_barrier_t (barrier) => separates the phases of a round
+ * @member WorkerLaunch (launch) => holds the workers until all are created
+ *
+ */
+typedef struct DeltaState {
+    const Graph *graph;
+    uint64_t *distances;
+    pthread_spinlock_t *locks;
+    LocalBins *localBins;
+    unsigned int noOfThreads;
+    uint64_t delta;
+    uint64_t bucket;
+    VertexId *frontier;
+    size_t frontierLength;
+    size_t frontierCapacity;
+    size_t nextChunk;
+    bool refill;
+    bool finished;
+    pthread_barrier_t barrier;
+    WorkerLaunch launch;
+} DeltaState;
+
+/*
+ * @brief Worker argument data structure
+ *
+ * @member DeltaState (pointer*) => shared state
+ * @member unsigned int (thread index) => index of this thread's bins
+ *
+ */
+typedef struct DeltaWorkerArgument {
+    DeltaState *state;
+    unsigned int threadIndex;
+} DeltaWorkerArgument;
+
+/*
+ * @brief declarations for internal functions
+ *
+ * List of static functions local to this file
+ * Meant to be used in this file only
+ *
+ * @note all internal functions are static
+ */
+static void initWeightedPaths(const Graph *graph, VertexId source, WeightedPaths *paths);
+static void choosePredecessors(const Graph *graph, WeightedPaths *paths);
+static unsigned int getRadixBucket(uint64_t key, uint64_t last);
+static void pushRadixHeap(RadixHeap *heap, uint64_t key, VertexId vertex);
+static bool popRadixHeap(RadixHeap *heap, HeapEntry *entry);
+static void pushVertexBin(VertexBin *bin, VertexId vertex);
+static void binVertex(const DeltaState *state, LocalBins *localBins, VertexId vertex, uint64_t distance);
+static bool relaxEdge(DeltaState *state, VertexId to, uint64_t newDistance);
+static void chooseBucket(DeltaState *state);
+static void refillWindow(DeltaState *state, LocalBins *localBins);
+static void gatherBucket(DeltaState *state);
+static void copyBucket(DeltaState *state, unsigned int threadIndex);
+static void relaxBucket(DeltaState *state, LocalBins *localBins);
+static void *deltaWorker(void *argument);
+
+/*
+ * @brief Allocate distances and predecessors with only the source reached
+ *
+ * @param Graph (pointer*)
+ * @param VertexId (source)
+ * @param WeightedPaths (pointer*)
+ * @return void
+ *
+ */
+static void initWeightedPaths(const Graph *graph, VertexId source, WeightedPaths *paths)
+{
+    paths->source = source;
+    paths->distances = (uint64_t *)malloc(graph->noOfNodes * sizeof(uint64_t));
+    paths->predecessors = (VertexId *)malloc(graph->noOfNodes * sizeof(VertexId));
+    paths->edgesExamined = 0;
+
+    if (paths->distances == NULL || paths->predecessors == NULL)
+    {
+        perror("Failed to allocate memory\n");
+        exit(EXIT_FAILURE);
+    }
+
+    for (size_t index = 0; index < graph->noOfNodes; index++)
+    {
+        paths->distances[index] = INFINITE_DISTANCE;
+        paths->predecessors[index] = INVALID_VERTEX;
+    }
+
+    paths->distances[source] = 0;
+    paths->predecessors[source] = source;
+}
+
+/*
+ * @brief Choose the predecessor of every reached vertex
+ *
+ * Runs once the distances are final, so every
+ * engine picks the same tree. A vertex takes the
+ * smallest vertex reaching it over a positive
+ * weight edge on a shortest path. A vertex only
+ * reached over zero weight edges at its distance
+ * takes the smallest of the vertices fewest zero
+ * weight edges away from such a vertex, which
+ * keeps the predecessors free of cycles
+ *
+ * @param Graph (pointer*)
+ * @param WeightedPaths (pointer*) => final distances, predecessors are written
+ * @return void
+ *
+ */
+static void choosePredecessors(const Graph *graph, WeightedPaths *paths)
+{
+    unsigned int noOfNodes = graph->noOfNodes;
+    uint64_t *distances = paths->distances;
+    VertexId *predecessors = paths->predecessors;
+    unsigned int *zeroHops = (unsigned int *)malloc(noOfNodes * sizeof(unsigned int));
+    VertexId *queue = (VertexId *)malloc(noOfNodes * sizeof(VertexId));
+
+    if (zeroHops == NULL || queue == NULL)
+    {
+        perror("Failed to allocate memory\n");
+        exit(EXIT_FAILURE);
+    }
+
+    for (VertexId vertex = 0; vertex < noOfNodes; vertex++)
+    {
+        predecessors[vertex] = INVALID_VERTEX;
+    }
+
+    predecessors[paths->source] = paths->source;
+
+    for (VertexId vertex = 0; vertex < noOfNodes; vertex++)
+    {
+        if (distances[vertex] == INFINITE_DISTANCE)
+        {
+            continue;
+        }
+
+        for (size_t edge = graph->edgeOffsets[vertex]; edge < graph->edgeOffsets[vertex + 1]; edge++)
+        {
+            VertexId adjacentNode = graph->adjacentNodes[edge];
+            unsigned int weight = graph->edgeWeights[edge];
+
+            if
+            (
+                weight > 0 && distances[vertex] + weight == distances[adjacentNode] &&
+                vertex < predecessors[adjacentNode]
+            )
+            {
+                predecessors[adjacentNode] = vertex;
+            }
+        }
+    }
+
+    size_t queueStart = 0, queueEnd = 0;
+
+    // every vertex with a predecessor so far starts the bfs over zero weight edges
+    for (VertexId vertex = 0; vertex < noOfNodes; vertex++)
+    {
+        if (predecessors[vertex] != INVALID_VERTEX)
+        {
+            zeroHops[vertex] = 0;
+            queue[queueEnd++] = vertex;
+        }
+    }
+
+    while (queueStart < queueEnd)
+    {
+        VertexId vertex = queue[queueStart++];
+
+        for (size_t edge = graph->edgeOffsets[vertex]; edge < graph->edgeOffsets[vertex + 1]; edge++)
+        {
+            VertexId adjacentNode = graph->adjacentNodes[edge];
+
+            if (graph->edgeWeights[edge] > 0 || distances[adjacentNode] != distances[vertex])
+            {
+                continue;
+            }
+
+            if (predecessors[adjacentNode] == INVALID_VERTEX)
+            {
+                predecessors[adjacentNode] = vertex;
+                zeroHops[adjacentNode] = zeroHops[vertex] + 1;
+                queue[queueEnd++] = adjacentNode;
+            }
+            else if (zeroHops[adjacentNode] == zeroHops[vertex] + 1 && vertex < predecessors[adjacentNode])
+            {
+                predecessors[adjacentNode] = vertex;
+            }
+        }
+    }
+
+    free(zeroHops);
+    free(queue);
+}
+
+/*
+ * @brief Get the radix heap bucket of a key
+ *
+ * @param uint64_t (key)
+ * @param uint64_t (last popped key)
+ * @return unsigned int
+ *
+ */
+static unsigned int getRadixBucket(uint64_t key, uint64_t last)
+{
+    return key == last ? 0 : 64 - (unsigned int)__builtin_clzll(key ^ last);
+}
+
+/*
+ * @brief Push an entry to the radix heap
+ *
+ * @param RadixHeap (pointer*)
+ * @param uint64_t (key, not below the last popped key)
+ * @param VertexId (vertex)
+ * @return void
+ *
+ */
+static void pushRadixHeap(RadixHeap *heap, uint64_t key, VertexId vertex)
+{
+    HeapBucket *bucket = &heap->buckets[getRadixBucket(key, heap->last)];
+
+    if (bucket->length == bucket->capacity)
+    {
+        size_t newCapacity = bucket->capacity == 0 ? 64 : bucket->capacity * 2;
+
+        HeapEntry *newEntries = (HeapEntry *)realloc(bucket->entries, newCapacity * sizeof(HeapEntry));
+
+        if (newEntries == NULL)
+        {
+            perror("Failed to allocate memory\n");
+            exit(EXIT_FAILURE);
+        }
+
+        bucket->entries = newEntries;
+        bucket->capacity = newCapacity;
+    }
+
+    bucket->entries[bucket->length].key = key;
+    bucket->entries[bucket->length].vertex = vertex;
+    bucket->length++;
+    heap->size++;
+}
+
+/*
+ * @brief Pop an entry with the smallest key
+ *
+ * When bucket 0 is empty the first non empty bucket
+ * is spread again around its smallest key, which
+ * then lands in bucket 0
+ *
+ * @param RadixHeap (pointer*)
+ * @param HeapEntry (pointer*) => receives the entry
+ * @return bool (false if the heap is empty)
+ *
+ */
+static bool popRadixHeap(RadixHeap *heap, HeapEntry *entry)
+{
+    if (heap->size == 0)
+    {
+        return false;
+    }
+
+    if (heap->buckets[0].length == 0)
+    {
+        unsigned int index = 1;
+        while (heap->buckets[index].length == 0)
+        {
+            index++;
+        }
+
+        HeapBucket *bucket = &heap->buckets[index];
+        uint64_t smallestKey = bucket->entries[0].key;
+
+        for (size_t entryIndex = 1; entryIndex < bucket->length; entryIndex++)
+        {
+            if (bucket->entries[entryIndex].key < smallestKey)
+            {
+                smallestKey = bucket->entries[entryIndex].key;
+            }
+        }
+
+        heap->last = smallestKey;
+
+        // entries only move to lower buckets, so the bucket is not refilled while spreading it
+        size_t length = bucket->length;
+        bucket->length = 0;
+        heap->size -= length;
+
+        for (size_t entryIndex = 0; entryIndex < length; entryIndex++)
+        {
+            pushRadixHeap(heap, bucket->entries[entryIndex].key, bucket->entries[entryIndex].vertex);
+        }
+    }
+
+    *entry = heap->buckets[0].entries[--heap->buckets[0].length];
+    heap->size--;
+
+    return true;
+}
+
+/*
+ * @brief Single source shortest paths with Dijkstra
+ *
+ * Uses a radix heap and skips entries whose vertex
+ * got a shorter distance after they were pushed
+ *
+ * @param Graph (pointer*)
+ * @param VertexId (source)
+ * @param WeightedPaths (pointer*) => filled in, release with freeWeightedPaths
+ * @return void
+ *
+ */
+void dijkstraShortestPaths(const Graph *graph, VertexId source, WeightedPaths *paths)
+{
+    initWeightedPaths(graph, source, paths);
+
+    uint64_t *distances = paths->distances;
+
+    RadixHeap heap = { 0 };
+    HeapEntry entry;
+
+    pushRadixHeap(&heap, 0, source);
+
+    while (popRadixHeap(&heap, &entry))
+    {
+        VertexId vertex = entry.vertex;
+
+        if (entry.key != distances[vertex])
+        {
+            continue;
+        }
+
+        size_t rowStart = graph->edgeOffsets[vertex];
+        size_t rowEnd = graph->edgeOffsets[vertex + 1];
+
+        paths->edgesExamined += rowEnd - rowStart;
+
+        for (size_t edge = rowStart; edge < rowEnd; edge++)
+        {
+            VertexId adjacentNode = graph->adjacentNodes[edge];
+            uint64_t newDistance = entry.key + graph->edgeWeights[edge];
+
+            if (newDistance < distances[adjacentNode])
+            {
+                distances[adjacentNode] = newDistance;
+                pushRadixHeap(&heap, newDistance, adjacentNode);
+            }
+        }
+    }
+
+    for (unsigned int index = 0; index < RADIX_BUCKETS; index++)
+    {
+        free(heap.buckets[index].entries);
+    }
+
+    choosePredecessors(graph, paths);
+}
+
+/*
+ * @brief Get the default bucket width for delta stepping
+ *
+ * The average edge weight, so a bucket holds
+ * about one hop worth of distance
+ *
+ * @param Graph (pointer*)
+ * @return uint64_t (at least 1)
+ *
+ */
+uint64_t getDefaultDelta(const Graph *graph)
+{
+    uint64_t weightSum = 0;
+    size_t noOfStoredEdges = graph->edgeOffsets[graph->noOfNodes];
+
+    for (size_t edge = 0; edge < noOfStoredEdges; edge++)
+    {
+        weightSum += graph->edgeWeights[edge];
+    }
+
+    if (noOfStoredEdges == 0 || weightSum < noOfStoredEdges)
+    {
+        return 1;
+    }
+
+    return weightSum / noOfStoredEdges;
+}
+
+/*
+ * @brief Push a vertex to a bin
+ *
+ * @param VertexBin (pointer*)
+ * @param VertexId (vertex)
+ * @return void
+ *
+ */
+static void pushVertexBin(VertexBin *bin, VertexId vertex)
+{
+    if (bin->length == bin->capacity)
+    {
+        size_t newCapacity = bin->capacity == 0 ? 64 : bin->capacity * 2;
+
+        VertexId *newVertices = (VertexId *)realloc(bin->vertices, newCapacity * sizeof(VertexId));
+
+        if (newVertices == NULL)
+        {
+            perror("Failed to allocate memory\n");
+            exit(EXIT_FAILURE);
+        }
+
+        bin->vertices = newVertices;
+        bin->capacity = newCapacity;
+    }
+
+    bin->vertices[bin->length++] = vertex;
+}
+
+/*
+ * @brief Bin a vertex by the bucket of its distance
+ *
+ * @param DeltaState (pointer*)
+ * @param LocalBins (pointer*)
+ * @param VertexId (vertex)
+ * @param uint64_t (distance of the vertex)
+ * @return void
+ *
+ */
+static void binVertex(const DeltaState *state, LocalBins *localBins, VertexId vertex, uint64_t distance)
+{
+    uint64_t bucket = distance / state->delta;
+
+    if (bucket - state->bucket < BUCKET_WINDOW)
+    {
+        pushVertexBin(&localBins->window[bucket % BUCKET_WINDOW], vertex);
+    }
+    else
+    {
+        pushVertexBin(&localBins->overflow, vertex);
+
+        if (bucket < localBins->overflowBucket)
+        {
+            localBins->overflowBucket = bucket;
+        }
+    }
+}
+
+/*
+ * @brief Relax an edge under the lock of its target
+ *
+ * @param DeltaState (pointer*)
+ * @param VertexId (target of the edge)
+ * @param uint64_t (distance through the edge)
+ * @return bool (true if the distance of the target went down)
+ *
+ */
+static bool relaxEdge(DeltaState *state, VertexId to, uint64_t newDistance)
+{
+    // cheap check first, distances only go down
+    if (newDistance >= __atomic_load_n(&state->distances[to], __ATOMIC_RELAXED))
+    {
+        return false;
+    }
+
+    pthread_spinlock_t *lock = &state->locks[to & (LOCK_STRIPES - 1)];
+    bool improved = false;
+
+    pthread_spin_lock(lock);
+
+    if (newDistance < state->distances[to])
+    {
+        __atomic_store_n(&state->distances[to], newDistance, __ATOMIC_RELAXED);
+        improved = true;
+    }
+
+    pthread_spin_unlock(lock);
+
+    return improved;
+}
+
+/*
+ * @brief Choose the bucket to settle next
+ *
+ * Run by a single thread between barriers. Takes
+ * the first bucket of the window any thread holds
+ * vertices for, unless an overflow bin may hold a
+ * vertex at or below it. Then the window is moved to
+ * the smallest overflow bucket and the bins are spread
+ *
+ * @param DeltaState (pointer*)
+ * @return void
+ *
+ */
+static void chooseBucket(DeltaState *state)
+{
+    uint64_t windowBucket = UINT64_MAX;
+    uint64_t overflowBucket = UINT64_MAX;
+
+    for (uint64_t bucket = state->bucket; bucket < state->bucket + BUCKET_WINDOW; bucket++)
+    {
+        for (unsigned int thread = 0; thread < state->noOfThreads && windowBucket == UINT64_MAX; thread++)
+        {
+            if (state->localBins[thread].window[bucket % BUCKET_WINDOW].length > 0)
+            {
+                windowBucket = bucket;
+            }
+        }
+
+        if (windowBucket != UINT64_MAX)
+        {
+            break;
+        }
+    }
+
+    for (unsigned int thread = 0; thread < state->noOfThreads; thread++)
+    {
+        LocalBins *localBins = &state->localBins[thread];
+
+        if (localBins->overflow.length > 0 && localBins->overflowBucket < overflowBucket)
+        {
+            overflowBucket = localBins->overflowBucket;
+        }
+    }
+
+    // overflow vertices must be binned before the window moves past their bucket
+    state->refill = overflowBucket <= windowBucket && overflowBucket != UINT64_MAX;
+    state->bucket = state->refill ? overflowBucket : windowBucket;
+    state->finished = state->bucket == UINT64_MAX;
+}
+
+/*
+ * @brief Spread a thread's overflow bin into its window
+ *
+ * Vertices are binned by their current distance,
+ * so stale entries go to where the vertex is now or
+ * are dropped if it was settled at a lower bucket
+ *
+ * @param DeltaState (pointer*)
+ * @param LocalBins (pointer*)
+ * @return void
+ *
+ */
+static void refillWindow(DeltaState *state, LocalBins *localBins)
+{
+    VertexBin *overflow = &localBins->overflow;
+    size_t kept = 0;
+
+    localBins->overflowBucket = UINT64_MAX;
+
+    for (size_t index = 0; index < overflow->length; index++)
+    {
+        VertexId vertex = overflow->vertices[index];
+        uint64_t bucket = state->distances[vertex] / state->delta;
+
+        if (bucket < state->bucket)
+        {
+            continue;
+        }
+
+        if (bucket - state->bucket < BUCKET_WINDOW)
+        {
+            pushVertexBin(&localBins->window[bucket % BUCKET_WINDOW], vertex);
+        }
+        else
+        {
+            overflow->vertices[kept++] = vertex;
+
+            if (bucket < localBins->overflowBucket)
+            {
+                localBins->overflowBucket = bucket;
+            }
+        }
+    }
+
+    overflow->length = kept;
+}
+
+/*
+ * @brief Size the frontier for the current bucket
+ *
+ * Run by a single thread between barriers
+ *
+ * @param DeltaState (pointer*)
+ * @return void
+ *
+ */
+static void gatherBucket(DeltaState *state)
+{
+    size_t slot = state->bucket % BUCKET_WINDOW;
+    size_t length = 0;
+
+    for (unsigned int thread = 0; thread < state->noOfThreads; thread++)
+    {
+        length += state->localBins[thread].window[slot].length;
+    }
+
+    if (length > state->frontierCapacity)
+    {
+        free(state->frontier);
+        state->frontier = (VertexId *)malloc(length * sizeof(VertexId));
+
+        if (state->frontier == NULL)
+        {
+            perror("Failed to allocate memory\n");
+            exit(EXIT_FAILURE);
+        }
+
+        state->frontierCapacity = length;
+    }
+
+    state->frontierLength = length;
+    state->nextChunk = 0;
+}
+
+/*
+ * @brief Move a thread's bin of the current bucket into the frontier
+ *
+ * Each thread writes its own bin after the
+ * bins of the threads before it
+ *
+ * @param DeltaState (pointer*)
+ * @param unsigned int (thread index)
+ * @return void
+ *
+ */
+static void copyBucket(DeltaState *state, unsigned int threadIndex)
+{
+    size_t slot = state->bucket % BUCKET_WINDOW;
+    size_t offset = 0;
+
+    for (unsigned int thread = 0; thread < threadIndex; thread++)
+    {
+        offset += state->localBins[thread].window[slot].length;
+    }
+
+    VertexBin *bin = &state->localBins[threadIndex].window[slot];
+
+    for (size_t index = 0; index < bin->length; index++)
+    {
+        state->frontier[offset + index] = bin->vertices[index];
+    }
+}
+
+/*
+ * @brief Relax the edges of the current bucket
+ *
+ * Takes chunks of the frontier until none are left.
+ * Vertices that moved to a lower bucket since they
+ * were binned are skipped, and improved targets
+ * go to the thread's own bins
+ *
+ * @param DeltaState (pointer*)
+ * @param LocalBins (pointer*)
+ * @return void
+ *
+ */
+static void relaxBucket(DeltaState *state, LocalBins *localBins)
+{
+    const Graph *graph = state->graph;
+    size_t chunkStart;
+
+    while
+    (
+        (chunkStart = __atomic_fetch_add(&state->nextChunk, RELAX_CHUNK, __ATOMIC_RELAXED))
+        < state->frontierLength
+    )
+    {
+        size_t chunkEnd = chunkStart + RELAX_CHUNK;
+        if (chunkEnd > state->frontierLength)
+        {
+            chunkEnd = state->frontierLength;
+        }
+
+        for (size_t index = chunkStart; index < chunkEnd; index++)
+        {
+            VertexId vertex = state->frontier[index];
+            uint64_t distance = __atomic_load_n(&state->distances[vertex], __ATOMIC_RELAXED);
+
+            if (distance / state->delta != state->bucket)
+            {
+                continue;
+            }
+
+            size_t rowStart = graph->edgeOffsets[vertex];
+            size_t rowEnd = graph->edgeOffsets[vertex + 1];
+
+            localBins->edgesExamined += rowEnd - rowStart;
+
+            for (size_t edge = rowStart; edge < rowEnd; edge++)
+            {
+                VertexId adjacentNode = graph->adjacentNodes[edge];
+                uint64_t newDistance = distance + graph->edgeWeights[edge];
+
+                if (relaxEdge(state, adjacentNode, newDistance))
+                {
+                    binVertex(state, localBins, adjacentNode, newDistance);
+                }
+            }
+        }
+    }
+}
+
+/*
+ * @brief Worker thread body
+ *
+ * Settles buckets together with the other workers.
+ * A bucket is taken again while relaxing its light
+ * edges puts vertices back into it
+ *
+ * @param void pointer (DeltaWorkerArgument)
+ * @return void pointer (NULL)
+ *
+ */
+static void *deltaWorker(void *argument)
+{
+    DeltaWorkerArgument *workerArgument = (DeltaWorkerArgument *)argument;
+    DeltaState *state = workerArgument->state;
+    unsigned int threadIndex = workerArgument->threadIndex;
+    LocalBins *localBins = &state->localBins[threadIndex];
+
+    if (!enterWorker(&state->launch))
+    {
+        return NULL;
+    }
+
+    for (;;)
+    {
+        if (threadIndex == 0)
+        {
+            chooseBucket(state);
+        }
+
+        pthread_barrier_wait(&state->barrier);
+
+        if (state->finished)
+        {
+            break;
+        }
+
+        // the bucket is chosen again once the overflow is spread
+        if (state->refill)
+        {
+            refillWindow(state, localBins);
+
+            pthread_barrier_wait(&state->barrier);
+            continue;
+        }
+
+        if (threadIndex == 0)
+        {
+            gatherBucket(state);
+        }
+
+        pthread_barrier_wait(&state->barrier);
+
+        copyBucket(state, threadIndex);
+
+        pthread_barrier_wait(&state->barrier);
+
+        localBins->window[state->bucket % BUCKET_WINDOW].length = 0;
+
+        relaxBucket(state, localBins);
+
+        pthread_barrier_wait(&state->barrier);
+    }
+
+    return NULL;
+}
+
+/*
+ * @brief Multithreaded single source shortest paths with delta stepping
+ *
+ * Vertices are binned by distance / delta and the
+ * lowest non empty bucket is relaxed by all threads
+ * at once until it stays empty. Gives the same
+ * distances and predecessors as dijkstraShortestPaths
+ *
+ * @param Graph (pointer*)
+ * @param VertexId (source)
+ * @param unsigned int (threads, 0 for every online core)
+ * @param uint64_t (bucket width, 0 for getDefaultDelta)
+ * @param WeightedPaths (pointer*) => filled in, release with freeWeightedPaths
+ * @return void
+ *
+ */
+void deltaSteppingShortestPaths
+(
+    const Graph *graph,
+    VertexId source,
+    unsigned int noOfThreads,
+    uint64_t delta,
+    WeightedPaths *paths
+)
+{
+    initWeightedPaths(graph, source, paths);
+
+    DeltaState state;
+    state.graph = graph;
+    state.distances = paths->distances;
+    state.noOfThreads = resolveThreadCount(noOfThreads);
+    state.delta = delta > 0 ? delta : getDefaultDelta(graph);
+    state.bucket = 0;
+    state.frontier = NULL;
+    state.frontierLength = 0;
+    state.frontierCapacity = 0;
+    state.nextChunk = 0;
+    state.refill = false;
+    state.finished = false;
+
+    state.locks = (pthread_spinlock_t *)malloc(LOCK_STRIPES * sizeof(pthread_spinlock_t));
+    state.localBins = (LocalBins *)calloc(state.noOfThreads, sizeof(LocalBins));
+    pthread_t *threads = (pthread_t *)malloc(state.noOfThreads * sizeof(pthread_t));
+    DeltaWorkerArgument *workerArguments = (DeltaWorkerArgument *)malloc
+    (
+        state.noOfThreads * sizeof(DeltaWorkerArgument)
+    );
+
+    if (state.locks == NULL || state.localBins == NULL || threads == NULL || workerArguments == NULL)
+    {
+        perror("Failed to allocate memory\n");
+        exit(EXIT_FAILURE);
+    }
+
+    for (unsigned int thread = 0; thread < state.noOfThreads; thread++)
+    {
+        state.localBins[thread].overflowBucket = UINT64_MAX;
+    }
+
+    for (unsigned int index = 0; index < LOCK_STRIPES; index++)
+    {
+        pthread_spin_init(&state.locks[index], PTHREAD_PROCESS_PRIVATE);
+    }
+
+    pushVertexBin(&state.localBins[0].window[0], source);
+
+    pthread_barrier_init(&state.barrier, NULL, state.noOfThreads);
+
+    // the calling thread works as thread 0
+    for (unsigned int thread = 0; thread < state.noOfThreads; thread++)
+    {
+        workerArguments[thread].state = &state;
+        workerArguments[thread].threadIndex = thread;
+    }
+
+    startWorkers
+    (
+        &state.launch, threads, state.noOfThreads, deltaWorker,
+        workerArguments, sizeof(DeltaWorkerArgument)
+    );
+    deltaWorker(&workerArguments[0]);
+    joinWorkers(&state.launch, threads, state.noOfThreads);
+
+    pthread_barrier_destroy(&state.barrier);
+
+    for (unsigned int thread = 0; thread < state.noOfThreads; thread++)
+    {
+        LocalBins *localBins = &state.localBins[thread];
+
+        paths->edgesExamined += localBins->edgesExamined;
+
+        for (unsigned int slot = 0; slot < BUCKET_WINDOW; slot++)
+        {
+            free(localBins->window[slot].vertices);
+        }
+
+        free(localBins->overflow.vertices);
+    }
+
+    for (unsigned int index = 0; index < LOCK_STRIPES; index++)
+    {
+        pthread_spin_destroy(&state.locks[index]);
+    }
+
+    free((void *)state.locks);
+    free(state.localBins);
+    free(state.frontier);
+    free(threads);
+    free(workerArguments);
+
+    choosePredecessors(graph, paths);
+}
+
+/*
+ * @brief Free weighted paths
+ *
+ * @param WeightedPaths (pointer*)
+ * @return void
+ *
+ */
+void freeWeightedPaths(WeightedPaths *paths)
+{
+    free(paths->distances);
+    free(paths->predecessors);
+    paths->distances = NULL;
+    paths->predecessors = NULL;
+}
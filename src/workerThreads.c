@@ -0,0 +1,133 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "workerThreads.h"
+
+/*
+ * @brief Get the largest usable number of threads
+ *
+ * @return unsigned int (online cores times THREADS_PER_CORE)
+ *
+ */
+unsigned int getMaxThreadCount(void)
+{
+    long onlineCores = sysconf(_SC_NPROCESSORS_ONLN);
+
+    return (onlineCores > 0 ? (unsigned int)onlineCores : 1) * THREADS_PER_CORE;
+}
+
+/*
+ * @brief Resolve number of threads
+ *
+ * @param unsigned int (requested threads, 0 for every online core)
+ * @return unsigned int
+ *
+ * @note Requests above getMaxThreadCount are cut down to it
+ *
+ */
+unsigned int resolveThreadCount(unsigned int requestedThreads)
+{
+    unsigned int maxThreads = getMaxThreadCount();
+
+    if (requestedThreads > 0)
+    {
+        return requestedThreads < maxThreads ? requestedThreads : maxThreads;
+    }
+
+    return maxThreads / THREADS_PER_CORE;
+}
+
+/*
+ * @brief Create workers 1 to noOfWorkers - 1
+ *
+ * Worker 0 is left to the calling thread. If a
+ * worker cannot be created the launch is aborted,
+ * the workers already created are joined and the
+ * program exits
+ *
+ * @param WorkerLaunch (pointer*)
+ * @param pthread_t pointer [array] (threads) => receives the created threads
+ * @param unsigned int (number of workers)
+ * @param function pointer (worker)
+ * @param void pointer [array] (arguments) => one argument per worker
+ * @param size_t (size of one argument)
+ * @return void
+ *
+ */
+void startWorkers
+(
+    WorkerLaunch *launch,
+    pthread_t *threads,
+    unsigned int noOfWorkers,
+    void *(*worker)(void *),
+    void *arguments,
+    size_t argumentSize
+)
+{
+    pthread_mutex_init(&launch->lock, NULL);
+    launch->aborted = false;
+
+    pthread_mutex_lock(&launch->lock);
+
+    for (unsigned int index = 1; index < noOfWorkers; index++)
+    {
+        void *argument = (char *)arguments + index * argumentSize;
+
+        int error = pthread_create(&threads[index], NULL, worker, argument);
+
+        if (error != 0)
+        {
+            launch->aborted = true;
+            pthread_mutex_unlock(&launch->lock);
+
+            joinWorkers(launch, threads, index);
+
+            errno = error;
+            perror("Failed to create thread\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    pthread_mutex_unlock(&launch->lock);
+}
+
+/*
+ * @brief Wait until every worker was created
+ *
+ * Workers that synchronize with each other call
+ * it first and return straight away on false
+ *
+ * @param WorkerLaunch (pointer*)
+ * @return bool (false if the launch was aborted)
+ *
+ */
+bool enterWorker(WorkerLaunch *launch)
+{
+    pthread_mutex_lock(&launch->lock);
+    bool aborted = launch->aborted;
+    pthread_mutex_unlock(&launch->lock);
+
+    return !aborted;
+}
+
+/*
+ * @brief Join workers 1 to noOfWorkers - 1
+ *
+ * @param WorkerLaunch (pointer*)
+ * @param pthread_t pointer [array] (threads)
+ * @param unsigned int (number of workers)
+ * @return void
+ *
+ */
+void joinWorkers(WorkerLaunch *launch, pthread_t *threads, unsigned int noOfWorkers)
+{
+    for (unsigned int index = 1; index < noOfWorkers; index++)
+    {
+        pthread_join(threads[index], NULL);
+    }
+
+    pthread_mutex_destroy(&launch->lock);
+}